@@ -0,0 +1,19 @@
+dnl @synopsis MYSQL_NONBLOCKING
+dnl
+dnl This macro determines whether the C API library has MariaDB's
+dnl non-blocking interface, mysql_real_query_start() and friends, and
+dnl whether the system has epoll to drive it.  EventLoop needs both
+dnl to run queries concurrently.
+dnl
+dnl @version $Id$, $Date$
+AC_DEFUN([MYSQL_NONBLOCKING],
+[
+    #
+    # Check for mysql_real_query_start() in libmysqlclient(_r)
+    #
+    AC_CHECK_LIB($MYSQL_C_LIB_NAME, mysql_real_query_start, [
+	AC_DEFINE(HAVE_MYSQL_NONBLOCKING,, Define if your MySQL library has the non-blocking API)
+    ]) dnl AC_CHECK_LIB(mysqlclient, mysql_real_query_start)
+
+    AC_CHECK_HEADERS(sys/epoll.h)
+]) dnl  MYSQL_NONBLOCKING
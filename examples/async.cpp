@@ -0,0 +1,143 @@
+/***********************************************************************
+ async.cpp - Example showing how to run queries on several connections
+	at once from a single thread, with EventLoop.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "cmdline.h"
+
+#include <mysql++.h>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+// Collects the item names a "use" query hands over one row at a time
+class ItemCollector : public mysqlpp::AsyncHandler
+{
+public:
+	void row(mysqlpp::Connection&, const mysqlpp::Row& r)
+	{
+		items.push_back(string(r[0].data(), r[0].length()));
+	}
+
+	vector<string> items;
+};
+
+
+// Starts another query on the same connection once the first one is
+// done, showing that a handler can keep a connection busy
+class Chain : public mysqlpp::AsyncHandler
+{
+public:
+	Chain(mysqlpp::EventLoop& loop, mysqlpp::AsyncResult& next) :
+	loop_(loop),
+	next_(next)
+	{
+	}
+
+	void executed(mysqlpp::Connection& conn, const mysqlpp::SimpleResult&)
+	{
+		loop_.store(conn, "select * from no_such_table", next_);
+	}
+
+private:
+	mysqlpp::EventLoop& loop_;
+	mysqlpp::AsyncResult& next_;
+};
+
+
+int
+main(int argc, char *argv[])
+{
+	// Get database access parameters from command line
+	mysqlpp::examples::CommandLine cmdline(argc, argv);
+	if (!cmdline) {
+		return 1;
+	}
+
+	try {
+		// Each query in flight needs a connection of its own
+		mysqlpp::Connection conns[3];
+		for (size_t i = 0; i < sizeof(conns) / sizeof(conns[0]); ++i) {
+			conns[i].connect(mysqlpp::examples::db_name,
+					cmdline.server(), cmdline.user(), cmdline.pass());
+		}
+
+		// Start a query on each.  None of them runs to completion
+		// here; the server works on all three at once while this
+		// thread waits in run() for their answers.
+		mysqlpp::EventLoop loop;
+		mysqlpp::AsyncResult by_num, missing;
+		ItemCollector light;
+		Chain chain(loop, missing);
+		loop.store(conns[0], "select item, num from stock "
+				"order by num desc", by_num);
+		loop.use(conns[1], "select item from stock where weight < 1.2 "
+				"order by item", light);
+		loop.execute(conns[2], "do 1", chain);
+		loop.run();
+
+		// Show the results.  They could have arrived in any order, but
+		// each handler kept its own.
+		cout.setf(ios::left);
+		cout << "Items by quantity:" << endl;
+		const mysqlpp::StoreQueryResult& res = by_num.rows();
+		for (size_t i = 0; i < res.num_rows(); ++i) {
+			cout << '\t' << setw(30) << res[i][0] << res[i][1] << endl;
+		}
+
+		cout << "Items weighing less than 1.2:" << endl;
+		for (size_t i = 0; i < light.items.size(); ++i) {
+			cout << '\t' << light.items[i] << endl;
+		}
+
+		// Errors come back to the handler, not as exceptions, since
+		// they happen inside run() on behalf of whoever started the
+		// query.
+		if (missing.ready() && !missing.succeeded()) {
+			cout << "Query on a missing table failed, as it should: " <<
+					missing.error() << endl;
+		}
+		else {
+			cerr << "Query on a missing table didn't fail!" << endl;
+			return 1;
+		}
+	}
+	catch (const mysqlpp::BadQuery& er) {
+		// Handle any query errors
+		cerr << "Query error: " << er.what() << endl;
+		return -1;
+	}
+	catch (const mysqlpp::Exception& er) {
+		// Catch-all for any other MySQL++ exceptions
+		cerr << "Error: " << er.what() << endl;
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/***********************************************************************
+ prepared.cpp - Example showing how to prepare a statement once on the
+	server and run it several times with different parameters, reading
+	the results both column by column and into SSQLS objects.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "cmdline.h"
+#include "printdata.h"
+#include "stock.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+
+int
+main(int argc, char *argv[])
+{
+	// Get database access parameters from command line
+	mysqlpp::examples::CommandLine cmdline(argc, argv);
+	if (!cmdline) {
+		return 1;
+	}
+
+	try {
+		// Establish the connection to the database server.
+		mysqlpp::Connection con(mysqlpp::examples::db_name,
+				cmdline.server(), cmdline.user(), cmdline.pass());
+
+		// The server parses this once.  Each execute() below sends
+		// just the parameter value, and gets the columns back in
+		// binary form.
+		mysqlpp::PreparedQuery pq = con.prepare(
+				"select item, num, weight from stock where num >= ? "
+				"order by num");
+		cout.setf(ios::left);
+		const int limits[] = { 70, 90, 100 };
+		for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); ++i) {
+			pq.bind(0, limits[i]).execute();
+			cout << "Items with at least " << limits[i] << " in stock:" <<
+					endl;
+			while (pq.fetch()) {
+				cout << '\t' << setw(30) << pq.get<string>(0) <<
+						setw(10) << pq.get<mysqlpp::sql_bigint>(1) <<
+						pq.get<double>(2) << endl;
+			}
+		}
+
+		// Prepared statements can fill SSQLS objects, too.
+		mysqlpp::PreparedQuery all = con.prepare(
+				"select * from stock where weight < ? order by item");
+		vector<stock> res;
+		all.bind(0, 1.2).storein(res);
+		cout << endl << "Items weighing less than 1.2:" << endl;
+		for (vector<stock>::iterator it = res.begin(); it != res.end(); ++it) {
+			cout << '\t' << it->item << " (" << it->sDate << ')' << endl;
+		}
+	}
+	catch (const mysqlpp::BadQuery& er) {
+		// Handle any query errors
+		cerr << "Query error: " << er.what() << endl;
+		return -1;
+	}
+	catch (const mysqlpp::BadConversion& er) {
+		// Handle bad conversions; e.g. type mismatch populating 'stock'
+		cerr << "Conversion error: " << er.what() << endl <<
+				"\tretrieved data size: " << er.retrieved <<
+				", actual size: " << er.actual_size << endl;
+		return -1;
+	}
+	catch (const mysqlpp::Exception& er) {
+		// Catch-all for any other MySQL++ exceptions
+		cerr << "Error: " << er.what() << endl;
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,174 @@
+/***********************************************************************
+ bulk_insert.cpp - Implements the BulkInsert class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#define MYSQLPP_NOT_HEADER
+#include "common.h"
+
+#include "bulk_insert.h"
+
+#include "connection.h"
+#include "exceptions.h"
+
+#include <sstream>
+
+#if !defined(MYSQLPP_PLATFORM_WINDOWS)
+#	include <sys/time.h>
+#endif
+
+using namespace std;
+
+namespace mysqlpp {
+
+// What we assume max_allowed_packet is if the server won't say.  This
+// is the smallest default any MySQL version has used.
+static const size_t fallback_max_packet = 1024 * 1024;
+
+
+double
+internal::stats_clock()
+{
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return double(count.QuadPart) / double(freq.QuadPart);
+#else
+	timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+#endif
+}
+
+
+BulkInsert::BulkInsert(Connection& conn, size_t max_packet) :
+OptionalExceptions(conn.throw_exceptions()),
+query_(conn.query()),
+row_(&conn),
+max_packet_(max_packet),
+pending_(0),
+sort_batches_(false),
+start_(0)
+{
+	// Same precision Query::insert() uses for floating-point columns
+	row_.precision(16);
+}
+
+
+bool
+BulkInsert::append_row()
+{
+	const size_t limit = max_packet();
+	const size_t length = row_.writer().length();
+
+	// The packet also holds a 1-byte command code ahead of the SQL, and
+	// each row after the first needs a comma before it.
+	if (pending_ && statement_.length() + 1 + length + 1 > limit &&
+			!flush()) {
+		return false;
+	}
+
+	if (!pending_) {
+		if (header_.length() + length + 1 > limit) {
+			if (throw_exceptions()) {
+				ostringstream outs;
+				outs << "Row of " << length << " bytes won't fit in a " <<
+						limit << " byte INSERT statement";
+				throw BadInsertPolicy(outs.str());
+			}
+			return false;
+		}
+		statement_.append(header_);
+	}
+	else {
+		statement_.append(',');
+	}
+
+	statement_.append(row_.writer().data(), length);
+	++pending_;
+	return true;
+}
+
+
+bool
+BulkInsert::flush()
+{
+	if (!pending_) {
+		return true;
+	}
+
+	// Either way, the rows are no longer ours to send.  The Query
+	// reports any error, by exception or by our return value.
+	bool ok = query_.execute(statement_.data(), statement_.length());
+	if (ok) {
+		stats_.rows += pending_;
+		stats_.bytes += statement_.length();
+		++stats_.statements;
+	}
+	stats_.seconds = internal::stats_clock() - start_;
+
+	statement_.clear();
+	pending_ = 0;
+	return ok;
+}
+
+
+size_t
+BulkInsert::max_packet()
+{
+	if (max_packet_ == 0) {
+		StoreQueryResult res =
+				query_.store("SELECT @@max_allowed_packet", 27);
+		if (res && res.num_rows() == 1) {
+			max_packet_ = static_cast<size_t>(res[0][0].conv(0UL));
+		}
+		if (max_packet_ == 0) {
+			max_packet_ = fallback_max_packet;
+		}
+	}
+
+	return max_packet_;
+}
+
+
+bool
+BulkInsert::start_row(const char* table)
+{
+	if (start_ == 0) {
+		start_ = internal::stats_clock();
+	}
+
+	row_.writer().clear();
+	if (table_ != table) {
+		if (!flush()) {
+			return false;
+		}
+		table_ = table;
+		header_.clear();
+	}
+
+	return true;
+}
+
+} // end namespace mysqlpp
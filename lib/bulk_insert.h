@@ -0,0 +1,242 @@
+/// \file bulk_insert.h
+/// \brief Declares the BulkInsert class, which loads large numbers of
+/// SSQLS objects into a table with multi-row INSERT statements.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_BULK_INSERT_H)
+#define MYSQLPP_BULK_INSERT_H
+
+#include "common.h"
+
+#include "noexceptions.h"
+#include "query.h"
+#include "sql_writer.h"
+#include "sqlstream.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Make Doxygen ignore this
+class MYSQLPP_EXPORT Connection;
+#endif
+
+/// \brief Running totals kept by BulkInsert
+
+struct MYSQLPP_EXPORT BulkInsertStats
+{
+	ulonglong rows;			///< rows the server has accepted
+	ulonglong bytes;		///< bytes of SQL sent to the server
+	ulonglong statements;	///< INSERT statements executed
+	double seconds;			///< time from the first row to the last flush
+
+	/// \brief Create an object with all totals zeroed
+	BulkInsertStats() :
+	rows(0),
+	bytes(0),
+	statements(0),
+	seconds(0)
+	{
+	}
+
+	/// \brief Rows loaded per second, or 0 if no time has passed
+	double rows_per_second() const
+			{ return seconds > 0 ? rows / seconds : 0; }
+
+	/// \brief Bytes sent per second, or 0 if no time has passed
+	double bytes_per_second() const
+			{ return seconds > 0 ? bytes / seconds : 0; }
+};
+
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+namespace internal {
+	// Returns a wall-clock time in seconds, for BulkInsertStats
+	MYSQLPP_EXPORT double stats_clock();
+} // end namespace mysqlpp::internal
+#endif // !defined(DOXYGEN_IGNORE)
+
+
+/// \brief Loads SSQLS objects into a table with as few INSERT
+/// statements as the server allows
+///
+/// Each object is turned into SQL once, and goes straight into the
+/// statement being built up.  When the next row wouldn't fit in the
+/// server's \c max_allowed_packet, the statement is executed and a new
+/// one started, so each statement is as large as it can be.  The
+/// packet limit is asked of the server the first time it's needed,
+/// unless you give it to the constructor.
+///
+/// \code
+/// mysqlpp::BulkInsert loader(conn);
+/// loader.sort_batches(true);
+/// loader.insert(stock_vector.begin(), stock_vector.end());
+/// loader.flush();
+/// std::cout << loader.stats().rows_per_second() << " rows/s" << std::endl;
+/// \endcode
+///
+/// Rows are only sent when a statement fills up, or when you call
+/// flush(), so always call flush() when you're done.  The destructor
+/// doesn't, since it has no way to report an error.
+///
+/// This class does no transaction management.  Wrap the calls in a
+/// Transaction if the load should succeed or fail as a whole.
+///
+/// Compared to Query::insertfrom() with MaxPacketInsertPolicy, which
+/// builds each row's VALUES list once to measure it and then again to
+/// add it to the query, this does half the work per row and fills
+/// each packet exactly.
+
+class MYSQLPP_EXPORT BulkInsert : public OptionalExceptions
+{
+public:
+	/// \brief Create an object to load rows through the given
+	/// connection
+	///
+	/// \param conn connection to insert rows through; it also decides
+	/// how text is escaped
+	/// \param max_packet largest INSERT statement to send, in bytes;
+	/// if 0, we ask the server for its \c max_allowed_packet setting
+	explicit BulkInsert(Connection& conn, size_t max_packet = 0);
+
+	/// \brief Add one row to the statement being built
+	///
+	/// This may execute the statement built so far, if the row won't
+	/// fit in it.  A row bound for a different table than the one
+	/// before it also starts a new statement.
+	///
+	/// \retval false if an INSERT failed, or the row wouldn't fit in a
+	/// statement on its own and exceptions are disabled
+	template <class RowT>
+	bool add(const RowT& row)
+	{
+		if (!start_row(row.table())) {
+			return false;
+		}
+		else if (header_.empty()) {
+			row_ << "INSERT INTO `" << row.table() << "` (" <<
+					row.field_list() << ") VALUES ";
+			header_ = row_.str();
+			row_.writer().clear();
+		}
+
+		row_ << '(' << row.value_list() << ')';
+		return append_row();
+	}
+
+	/// \brief Add a range of rows
+	///
+	/// If sort_batches() is on, the rows are copied and sorted before
+	/// being added.  An SSQLS type's operator< compares its key
+	/// fields, so this puts each batch in primary key order, letting
+	/// InnoDB append to its index pages instead of splitting them.
+	///
+	/// \retval false if an INSERT failed, or a row wouldn't fit in a
+	/// statement on its own and exceptions are disabled
+	template <class Iter>
+	bool insert(Iter first, Iter last)
+	{
+		if (sort_batches_) {
+			std::vector<typename std::iterator_traits<Iter>::value_type>
+					batch(first, last);
+			std::sort(batch.begin(), batch.end());
+			return add_range(batch.begin(), batch.end());
+		}
+		else {
+			return add_range(first, last);
+		}
+	}
+
+	/// \brief Execute the statement built up so far, if any
+	///
+	/// \retval false if the INSERT failed and exceptions are disabled
+	bool flush();
+
+	/// \brief Get the largest INSERT statement we'll send, in bytes
+	///
+	/// If this wasn't given to the constructor or set with
+	/// max_packet(size_t), asks the server for its
+	/// \c max_allowed_packet setting.
+	size_t max_packet();
+
+	/// \brief Set the largest INSERT statement we'll send, in bytes
+	///
+	/// Takes effect with the next row added.
+	void max_packet(size_t bytes) { max_packet_ = bytes; }
+
+	/// \brief Returns the number of rows added but not yet sent
+	size_t pending() const { return pending_; }
+
+	/// \brief Returns true if insert() sorts each range of rows
+	bool sort_batches() const { return sort_batches_; }
+
+	/// \brief Set whether insert() sorts each range of rows before
+	/// adding them
+	void sort_batches(bool sort) { sort_batches_ = sort; }
+
+	/// \brief Get running totals for this object's work so far
+	const BulkInsertStats& stats() const { return stats_; }
+
+private:
+	/// \brief Call add() for each row in the range
+	template <class Iter>
+	bool add_range(Iter first, Iter last)
+	{
+		for (Iter it = first; it != last; ++it) {
+			if (!add(*it)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// \brief Move the row built in row_ into the statement, executing
+	/// the statement first if the row won't fit
+	bool append_row();
+
+	/// \brief Get ready to build a row bound for the given table,
+	/// executing the statement built so far if it's for another table
+	bool start_row(const char* table);
+
+	Query query_;				///< executes the statements we build
+	SQLStream row_;				///< the row being built
+	SQLWriter statement_;		///< the INSERT statement being built
+	std::string table_;			///< table the statement inserts into
+	std::string header_;		///< "INSERT INTO ... VALUES " for table_
+	size_t max_packet_;			///< largest statement to send; 0 = ask
+	size_t pending_;			///< rows in statement_
+	bool sort_batches_;			///< sort rows given to insert()?
+	double start_;				///< time the stats started counting
+	BulkInsertStats stats_;		///< running totals
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_BULK_INSERT_H)
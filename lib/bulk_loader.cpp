@@ -0,0 +1,218 @@
+/***********************************************************************
+ bulk_loader.cpp - Implements the BulkLoader class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#define MYSQLPP_NOT_HEADER
+#include "common.h"
+
+#include "bulk_loader.h"
+
+#include "connection.h"
+#include "dbdriver.h"
+#include "exceptions.h"
+#include "sql_escape.h"
+
+#include <string.h>
+
+using namespace std;
+
+namespace mysqlpp {
+
+// The file name we give in LOAD DATA LOCAL INFILE.  The server sends it
+// back to the C API, which passes it to our init callback, where we
+// ignore it: the data comes from us, not a file.
+static const char infile_name[] = "mysqlpp";
+
+
+BulkLoader::BulkLoader(Connection& conn, const std::string& table) :
+OptionalExceptions(conn.throw_exceptions()),
+conn_(conn),
+query_(conn.query()),
+text_(&conn),
+table_(table),
+columns_set_(false),
+chunk_size_(16 * 1024 * 1024),
+pending_(0),
+offset_(0),
+source_(0),
+start_(0)
+{
+	// Same precision Query::insert() uses for floating-point columns
+	text_.precision(16);
+
+	// We report errors ourselves, as this object's setting calls for
+	query_.disable_exceptions();
+}
+
+
+int
+BulkLoader::infile_init(void** ptr, const char*, void* userdata)
+{
+	*ptr = userdata;
+	return 0;
+}
+
+
+int
+BulkLoader::infile_read(void* ptr, char* buf, unsigned int buf_len)
+{
+	return static_cast<BulkLoader*>(ptr)->read(buf, buf_len);
+}
+
+
+void
+BulkLoader::infile_end(void*)
+{
+}
+
+
+int
+BulkLoader::infile_error(void* ptr, char* msg, unsigned int msg_len)
+{
+	const BulkLoader* self = static_cast<BulkLoader*>(ptr);
+	const char* error = self->read_error_.empty() ?
+			"Error generating LOAD DATA input" :
+			self->read_error_.c_str();
+	if (msg_len) {
+		strncpy(msg, error, msg_len - 1);
+		msg[msg_len - 1] = '\0';
+	}
+	return 1;
+}
+
+
+bool
+BulkLoader::load(internal::TSVSource* source)
+{
+	if (!pending_ && !source) {
+		return true;
+	}
+
+	// LOAD DATA reads the text in the connection's character set, and
+	// tsv escapes it byte by byte, same as our SQL escaping engine.
+	DBDriver* driver = conn_.driver();
+	const char* charset = driver->character_set_name();
+	if (conn_.connected() && !internal::escape_sql_safe(charset)) {
+		text_.writer().clear();
+		pending_ = 0;
+		if (throw_exceptions()) {
+			throw BadQuery(string("BulkLoader can't escape text in the ") +
+					charset + " character set");
+		}
+		return false;
+	}
+
+	SQLWriter statement;
+	statement.append("LOAD DATA LOCAL INFILE '", 24).
+			append(infile_name, sizeof(infile_name) - 1).
+			append("' INTO TABLE `", 14).append(table_).
+			append("` CHARACTER SET ", 16).append(charset ? charset : "utf8");
+	if (!columns_.empty()) {
+		statement.append(" (", 2).append(columns_).append(')');
+	}
+
+	source_ = source;
+	offset_ = 0;
+	read_error_.clear();
+
+	driver->set_local_infile_handler(infile_init, infile_read,
+			infile_end, infile_error, this);
+	SimpleResult res = query_.execute(statement.data(), statement.length());
+	driver->set_local_infile_default();
+
+	bool ok = res;
+	if (ok) {
+		stats_.rows += static_cast<size_t>(res.rows());
+		++stats_.statements;
+	}
+	stats_.seconds = internal::stats_clock() - start_;
+
+	// Either way, the rows are no longer ours to send
+	text_.writer().clear();
+	pending_ = 0;
+	source_ = 0;
+
+	if (!ok && throw_exceptions()) {
+		throw BadQuery(query_.error(), query_.errnum());
+	}
+	return ok;
+}
+
+
+int
+BulkLoader::read(char* buf, unsigned int buf_len)
+{
+	try {
+		SQLWriter& w = text_.writer();
+
+		// Once the rows already in the buffer are all sent, refill it
+		// from the source, a buffer's worth at a time
+		if (offset_ == w.length() && source_) {
+			w.clear();
+			offset_ = 0;
+			while (w.length() < buf_len) {
+				if (!source_->next(text_)) {
+					source_ = 0;
+					break;
+				}
+			}
+		}
+
+		size_t n = w.length() - offset_;
+		if (n > buf_len) {
+			n = buf_len;
+		}
+		memcpy(buf, w.data() + offset_, n);
+		offset_ += n;
+		stats_.bytes += n;
+		return static_cast<int>(n);
+	}
+	catch (const std::exception& e) {
+		read_error_ = e.what();
+		return -1;
+	}
+}
+
+
+void
+tsv_columns(std::ostream& os, const Row& row)
+{
+	if (row.size()) {
+		os << '`' << row.field_list("`,`") << '`';
+	}
+}
+
+
+void
+tsv_row(std::ostream& os, const Row& row)
+{
+	for (size_t i = 0; i < row.size(); ++i) {
+		if (i) {
+			os << '\t';
+		}
+		os << tsv << row[i];
+	}
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,336 @@
+/// \file bulk_loader.h
+/// \brief Declares the BulkLoader class, which streams rows to the
+/// server with LOAD DATA LOCAL INFILE.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_BULK_LOADER_H)
+#define MYSQLPP_BULK_LOADER_H
+
+#include "common.h"
+
+#include "bulk_insert.h"
+#include "manip.h"
+#include "noexceptions.h"
+#include "query.h"
+#include "row.h"
+#include "sqlstream.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Make Doxygen ignore this
+class MYSQLPP_EXPORT Connection;
+#endif
+
+/// \brief Write an SSQLS object's values as a line of LOAD DATA input,
+/// minus the line ending
+///
+/// BulkLoader calls tsv_row() and tsv_columns() for each type of row
+/// you give it.  There are versions for SSQLS objects, Row, and
+/// \c std::vector of anything SQLTypeAdapter can hold.  For other
+/// types, write your own in the same namespace as the type, so the
+/// compiler finds them there:
+///
+/// \code
+/// void tsv_row(std::ostream& os, const MyRecord& r)
+/// {
+///     os << mysqlpp::tsv << r.id << '\t' << mysqlpp::tsv << r.name;
+/// }
+///
+/// void tsv_columns(std::ostream& os, const MyRecord&)
+/// {
+///     os << "`id`,`name`";
+/// }
+/// \endcode
+template <class T>
+void tsv_row(std::ostream& os, const T& ssqls)
+{
+	os << ssqls.value_list("\t", tsv);
+}
+
+/// \brief Write a Row's values as a line of LOAD DATA input
+MYSQLPP_EXPORT void tsv_row(std::ostream& os, const Row& row);
+
+/// \brief Write a vector's elements as a line of LOAD DATA input
+template <class T>
+void tsv_row(std::ostream& os, const std::vector<T>& values)
+{
+	for (size_t i = 0; i < values.size(); ++i) {
+		if (i) {
+			os << '\t';
+		}
+		os << tsv << values[i];
+	}
+}
+
+
+/// \brief Write the list of columns an SSQLS object's values go into
+///
+/// This is the part of the LOAD DATA statement in parentheses after
+/// the table name.  Write nothing to load every column, in table
+/// order.
+template <class T>
+void tsv_columns(std::ostream& os, const T& ssqls)
+{
+	os << ssqls.field_list();
+}
+
+/// \brief Write the list of columns a Row's values go into
+MYSQLPP_EXPORT void tsv_columns(std::ostream& os, const Row& row);
+
+/// \brief Write the list of columns a vector's elements go into,
+/// which is none: they go into every column, in table order
+template <class T>
+void tsv_columns(std::ostream&, const std::vector<T>&)
+{
+}
+
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+namespace internal {
+	// A source of rows for BulkLoader to pull from while the server
+	// is reading the data, so a whole range of rows never has to be
+	// held in memory as text
+	class MYSQLPP_EXPORT TSVSource
+	{
+	public:
+		virtual ~TSVSource() { }
+
+		// Write the next row plus its line ending, returning false
+		// if there are none left
+		virtual bool next(std::ostream& os) = 0;
+	};
+
+	template <class Iter>
+	class TSVRange : public TSVSource
+	{
+	public:
+		TSVRange(Iter first, Iter last) :
+		it_(first),
+		last_(last)
+		{
+		}
+
+		bool next(std::ostream& os)
+		{
+			if (it_ == last_) {
+				return false;
+			}
+			tsv_row(os, *it_++);
+			os << '\n';
+			return true;
+		}
+
+	private:
+		Iter it_;
+		Iter last_;
+	};
+} // end namespace mysqlpp::internal
+#endif // !defined(DOXYGEN_IGNORE)
+
+
+/// \brief Loads rows into a table with LOAD DATA LOCAL INFILE
+///
+/// This is the fastest way to get a lot of data into MySQL.  Rows are
+/// turned into the tab-separated text LOAD DATA reads and handed to
+/// the C API as it asks for more, through the callbacks set by
+/// DBDriver::set_local_infile_handler().  No temporary file is
+/// written, and no SQL is built beyond the LOAD DATA statement
+/// itself.
+///
+/// It has the same interface as BulkInsert, so one can stand in for
+/// the other.  insert() streams a range of rows to the server while
+/// the iterators are walked, holding only a buffer's worth at a time.
+/// add() collects rows one at a time, sending them when they reach
+/// chunk_size() bytes or when you call flush(), so call flush() when
+/// you're done adding rows.
+///
+/// \code
+/// mysqlpp::Connection conn;
+/// conn.set_option(new mysqlpp::LocalInfileOption(1));
+/// conn.connect(db, server, user, pass);
+///
+/// mysqlpp::BulkLoader loader(conn, "stock");
+/// loader.insert(stock_vector.begin(), stock_vector.end());
+/// std::cout << loader.stats().rows_per_second() << " rows/s" << std::endl;
+/// \endcode
+///
+/// The connection must have LocalInfileOption set before it connects,
+/// and the server's \c local_infile variable must be on.  Rows the
+/// server rejects, such as duplicate keys, are skipped with a warning
+/// rather than failing the load; that's how LOAD DATA LOCAL works.
+///
+/// Text is escaped byte by byte, so this only works with character
+/// sets where that's safe, the same ones DBDriver escapes itself.
+/// Loads through a connection using any other character set fail.
+///
+/// The rows can be SSQLS objects, Row objects, or vectors of values;
+/// see tsv_row() to add other types.
+
+class MYSQLPP_EXPORT BulkLoader : public OptionalExceptions
+{
+public:
+	/// \brief Create an object to load rows into a table
+	///
+	/// \param conn connection to load rows through
+	/// \param table name of the table to load
+	BulkLoader(Connection& conn, const std::string& table);
+
+	/// \brief Add one row to those waiting to be sent
+	///
+	/// If this brings the waiting rows to chunk_size() bytes, they're
+	/// sent.
+	///
+	/// \retval false if sending the rows failed and exceptions are
+	/// disabled
+	template <class RowT>
+	bool add(const RowT& row)
+	{
+		start_row(row);
+		tsv_row(text_, row);
+		text_ << '\n';
+		++pending_;
+		return text_.writer().length() < chunk_size_ || flush();
+	}
+
+	/// \brief Send the rows waiting to be sent, if any, and then the
+	/// given range of rows, in a single LOAD DATA statement
+	///
+	/// The rows in the range are turned into text only as the C API
+	/// asks for more, so the range can be arbitrarily large.
+	///
+	/// \retval false if the load failed and exceptions are disabled
+	template <class Iter>
+	bool insert(Iter first, Iter last)
+	{
+		if (first == last) {
+			return true;
+		}
+
+		start_row(*first);
+		internal::TSVRange<Iter> source(first, last);
+		return load(&source);
+	}
+
+	/// \brief Send the rows waiting to be sent, if any
+	///
+	/// \retval false if the load failed and exceptions are disabled
+	bool flush() { return load(0); }
+
+	/// \brief Get the number of bytes of rows add() collects before
+	/// sending them
+	size_t chunk_size() const { return chunk_size_; }
+
+	/// \brief Set the number of bytes of rows add() collects before
+	/// sending them
+	///
+	/// The default is 16 MB.
+	void chunk_size(size_t bytes) { chunk_size_ = bytes; }
+
+	/// \brief Get the column list for the LOAD DATA statement
+	const std::string& columns() const { return columns_; }
+
+	/// \brief Set the column list for the LOAD DATA statement
+	///
+	/// Normally this comes from the first row, through tsv_columns().
+	/// Use this to override that, giving a comma-separated list of
+	/// column names.  An empty list loads every column, in table
+	/// order.
+	void columns(const std::string& list)
+	{
+		columns_ = list;
+		columns_set_ = true;
+	}
+
+	/// \brief Returns the number of rows added but not yet sent
+	size_t pending() const { return pending_; }
+
+	/// \brief Get running totals for this object's work so far
+	///
+	/// The row count is the number the server reports loading, which
+	/// leaves out any it skipped.
+	const BulkInsertStats& stats() const { return stats_; }
+
+	/// \brief Get the name of the table rows are loaded into
+	const std::string& table() const { return table_; }
+
+private:
+	/// \brief Callbacks the C API calls while the server reads data
+	static int infile_init(void** ptr, const char* filename,
+			void* userdata);
+	static int infile_read(void* ptr, char* buf, unsigned int buf_len);
+	static void infile_end(void* ptr);
+	static int infile_error(void* ptr, char* msg, unsigned int msg_len);
+
+	/// \brief Fill the C API's buffer with as much data as will fit,
+	/// returning the number of bytes placed in it, or -1 on error
+	int read(char* buf, unsigned int buf_len);
+
+	/// \brief Send the waiting rows, followed by any from the source,
+	/// in one LOAD DATA statement
+	bool load(internal::TSVSource* source);
+
+	/// \brief Start the clock and note the column list, if this is
+	/// the first row
+	template <class RowT>
+	void start_row(const RowT& row)
+	{
+		if (start_ == 0) {
+			start_ = internal::stats_clock();
+		}
+
+		if (!columns_set_) {
+			const size_t mark = text_.writer().length();
+			tsv_columns(text_, row);
+			columns_.assign(text_.writer().data() + mark,
+					text_.writer().length() - mark);
+			text_.seekp(mark);
+			columns_set_ = true;
+		}
+	}
+
+	Connection& conn_;			///< connection to load rows through
+	Query query_;				///< executes the LOAD DATA statements
+	SQLStream text_;			///< rows waiting to be sent
+	std::string table_;			///< table to load rows into
+	std::string columns_;		///< column list for LOAD DATA
+	bool columns_set_;			///< is columns_ filled in?
+	size_t chunk_size_;			///< bytes of rows add() holds back
+	size_t pending_;			///< rows in text_
+	size_t offset_;				///< bytes of text_ sent so far
+	internal::TSVSource* source_;	///< rows to send after text_'s
+	std::string read_error_;	///< exception a callback caught
+	double start_;				///< time the stats started counting
+	BulkInsertStats stats_;		///< running totals
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_BULK_LOADER_H)
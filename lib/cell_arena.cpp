@@ -0,0 +1,115 @@
+/***********************************************************************
+ cell_arena.cpp - Implements the CellArena class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "cell_arena.h"
+
+#include <string.h>
+
+namespace mysqlpp {
+
+// Size of slabs we allocate when the caller didn't tell us how much
+// space it needs, or underestimated.
+static const CellArena::size_type default_slab_size = 64 * 1024;
+
+
+CellArena::CellArena(size_type first_slab) :
+next_(0),
+left_(0),
+used_(0),
+reserved_(0)
+{
+	if (first_slab) {
+		// Allocate the whole thing now, so the common case of a
+		// correctly-sized arena never needs a second slab.
+		next_ = new char[first_slab];
+		slabs_.push_back(next_);
+		left_ = reserved_ = first_slab;
+	}
+}
+
+
+CellArena::~CellArena()
+{
+	for (std::vector<char*>::iterator it = slabs_.begin();
+			it != slabs_.end(); ++it) {
+		delete[] *it;
+	}
+
+	for (std::vector<adopted_block>::iterator it = adopted_.begin();
+			it != adopted_.end(); ++it) {
+		it->release(it->block, it->length);
+	}
+}
+
+
+void
+CellArena::adopt(char* block, size_type length, release_function release)
+{
+	adopted_block ab = { block, length, release };
+	try {
+		adopted_.push_back(ab);
+	}
+	catch (...) {
+		// We promised to release the block, so keep that promise
+		release(block, length);
+		throw;
+	}
+}
+
+
+char*
+CellArena::allocate(size_type bytes)
+{
+	if (bytes > left_) {
+		// Doesn't fit in the current slab, so start a new one.  Any
+		// space left in the old one is wasted, but it's better than
+		// searching the old slabs for space on every allocation.
+		size_type size = bytes > default_slab_size ?
+				bytes : default_slab_size;
+		slabs_.reserve(slabs_.size() + 1);	// so push_back can't throw
+		next_ = new char[size];
+		slabs_.push_back(next_);
+		left_ = size;
+		reserved_ += size;
+	}
+
+	char* p = next_;
+	next_ += bytes;
+	left_ -= bytes;
+	used_ += bytes;
+	return p;
+}
+
+
+const char*
+CellArena::copy(const char* data, size_type length)
+{
+	char* p = allocate(length + 1);
+	memcpy(p, data, length);
+	p[length] = '\0';
+	return p;
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,140 @@
+/// \file cell_arena.h
+/// \brief Declares the CellArena class
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_CELL_ARENA_H)
+#define MYSQLPP_CELL_ARENA_H
+
+#include "common.h"
+
+#include "refcounted.h"
+
+#include <vector>
+
+namespace mysqlpp {
+
+/// \brief Holds the raw bytes of many result set cells in a few large
+/// blocks of memory.
+///
+/// StoreQueryResult uses this when asked to store its data in arena
+/// mode: instead of giving each cell its own heap-allocated copy, it
+/// copies every cell into one of these, and the String objects in the
+/// result's rows just point into it.  All of the memory is freed in one
+/// shot when the last String referring to the arena goes away.
+///
+/// Memory is handed out in "slabs."  If you know up front how many
+/// bytes you will need -- StoreQueryResult does, because the C API
+/// tells it the length of every cell before it copies anything -- pass
+/// that to the ctor, and the whole result set ends up in a single
+/// contiguous block.  Otherwise, the arena grows a slab at a time.
+///
+/// Memory given out by an arena is never moved or individually freed,
+/// so pointers returned by copy() stay valid for the arena's lifetime.
+
+class MYSQLPP_EXPORT CellArena : public RefCounted
+{
+public:
+	/// \brief Type of length values
+	typedef size_t size_type;
+
+	/// \brief Create an arena
+	///
+	/// \param first_slab size of the first block of memory to
+	/// allocate; if 0, we use a default size
+	explicit CellArena(size_type first_slab = 0);
+
+	/// \brief Destroy the arena, freeing all the memory it handed out
+	/// and releasing any adopted blocks
+	~CellArena();
+
+	/// \brief Type of function that releases an adopted block
+	typedef void (*release_function)(char* block, size_type length);
+
+	/// \brief Take charge of a block of memory that came from
+	/// somewhere other than this arena
+	///
+	/// The arena calls \c release on the block when it's destroyed.
+	/// This lets String views point into memory the arena didn't
+	/// allocate, such as a memory-mapped file, while still keeping it
+	/// alive as long as any of them need it.  Adopted blocks don't
+	/// count toward bytes_used() or bytes_reserved().
+	void adopt(char* block, size_type length, release_function release);
+
+	/// \brief Return the number of bytes handed out so far, including
+	/// the null terminators copy() adds
+	size_type bytes_used() const { return used_; }
+
+	/// \brief Return the total size of all slabs allocated so far
+	size_type bytes_reserved() const { return reserved_; }
+
+	/// \brief Copy a block of data into the arena
+	///
+	/// Like SQLBuffer, we tack a null terminator onto the end of the
+	/// copy, not counted in the length, so the result can be used in
+	/// C string contexts.
+	///
+	/// \param data the data to copy; may contain null characters
+	/// \param length number of bytes to copy from \c data
+	///
+	/// \return pointer to the copy within the arena
+	const char* copy(const char* data, size_type length);
+
+	/// \brief Return the number of slabs allocated so far
+	size_type slabs() const { return slabs_.size(); }
+
+private:
+	// Arenas are shared through RefCountedArena, never copied
+	CellArena(const CellArena&);
+	CellArena& operator=(const CellArena&);
+
+	/// \brief Return a pointer to \c bytes of free space in the arena,
+	/// allocating a new slab if needed
+	char* allocate(size_type bytes);
+
+	/// \brief Record of a block passed to adopt()
+	struct adopted_block {
+		char* block;
+		size_type length;
+		release_function release;
+	};
+
+	std::vector<char*> slabs_;	///< all blocks allocated so far
+	std::vector<adopted_block> adopted_;	///< blocks passed to adopt()
+	char* next_;				///< first free byte in current slab
+	size_type left_;			///< free bytes remaining at next_
+	size_type used_;			///< bytes handed out by allocate()
+	size_type reserved_;		///< total size of all slabs
+};
+
+
+/// \brief Reference-counted version of CellArena.
+///
+/// Every String pointing into an arena holds one of these, which is
+/// how the arena knows when it can be freed.
+typedef RefCountedPointer<CellArena> RefCountedArena;
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_CELL_ARENA_H)
@@ -0,0 +1,243 @@
+/***********************************************************************
+ columnar.cpp - Implements the ColumnarResult class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#define MYSQLPP_NOT_HEADER
+#include "common.h"
+
+#include "columnar.h"
+
+#include "dbdriver.h"
+#include "null.h"
+#include "numparse.h"
+#include "sql_types.h"
+
+#include <sstream>
+
+using namespace std;
+
+namespace mysqlpp {
+
+using internal::parse_number;
+using internal::pr_empty;
+
+
+void
+ColumnarResult::Column::init(const mysql_type_info& type,
+		size_type rows, size_type string_bytes)
+{
+	type_ = type;
+	size_ = 0;
+	null_count_ = 0;
+	nulls_.assign((rows + 7) / 8, 0);
+
+	const std::type_info& ti = type.base_type().c_type();
+	if (type == typeid(sql_bigint_unsigned) ||
+			type == typeid(Null<sql_bigint_unsigned>)) {
+		kind_ = ck_uint;
+		uints_.reserve(rows);
+	}
+	else if (ti == typeid(sql_tinyint) || ti == typeid(sql_smallint) ||
+			ti == typeid(sql_int) || ti == typeid(sql_bigint)) {
+		kind_ = ck_int;
+		ints_.reserve(rows);
+	}
+	else if (ti == typeid(sql_float) || ti == typeid(sql_double) ||
+			ti == typeid(sql_decimal)) {
+		kind_ = ck_double;
+		doubles_.reserve(rows);
+	}
+	else if (ti == typeid(sql_date)) {
+		kind_ = ck_date;
+		dates_.reserve(rows);
+	}
+	else if (ti == typeid(sql_datetime)) {
+		kind_ = ck_datetime;
+		datetimes_.reserve(rows);
+	}
+	else if (ti == typeid(sql_time)) {
+		kind_ = ck_time;
+		times_.reserve(rows);
+	}
+	else {
+		kind_ = ck_string;
+		chars_.reserve(string_bytes);
+		offsets_.reserve(rows + 1);
+		offsets_.push_back(0);
+	}
+}
+
+
+void
+ColumnarResult::Column::push_back(const char* data,
+		unsigned long length, bool throw_excptns)
+{
+	if (!data) {
+		nulls_[size_ / 8] |= 1 << (size_ % 8);
+		++null_count_;
+	}
+	bool ok = true;
+
+	switch (kind_) {
+		case ck_int: {
+			longlong v = 0;
+			ok = !data || parse_number(data, length, v) <= pr_empty;
+			ints_.push_back(ok ? v : 0);
+			break;
+		}
+
+		case ck_uint: {
+			ulonglong v = 0;
+			ok = !data || (*data != '-' &&
+					parse_number(data, length, v) <= pr_empty);
+			uints_.push_back(ok ? v : 0);
+			break;
+		}
+
+		case ck_double: {
+			double v = 0;
+			ok = !data || parse_number(data, length, v) <= pr_empty;
+			doubles_.push_back(ok ? v : 0);
+			break;
+		}
+
+		case ck_date:
+			dates_.push_back(data ? Date(data) : Date());
+			break;
+
+		case ck_datetime:
+			datetimes_.push_back(data ? DateTime(data) : DateTime());
+			break;
+
+		case ck_time:
+			times_.push_back(data ? Time(data) : Time());
+			break;
+
+		case ck_string:
+			if (data) {
+				chars_.insert(chars_.end(), data, data + length);
+			}
+			chars_.push_back('\0');
+			offsets_.push_back(chars_.size());
+			break;
+	}
+
+	++size_;
+
+	if (!ok && throw_excptns) {
+		throw BadConversion(type_.name(), string(data, length).c_str(),
+				0, length);
+	}
+}
+
+
+String
+ColumnarResult::Column::value(size_type row) const
+{
+	if (is_null(row)) {
+		return String("NULL", 4, type_, true);
+	}
+
+	ostringstream outs;
+	switch (kind_) {
+		case ck_int:		outs << ints_[row]; break;
+		case ck_uint:		outs << uints_[row]; break;
+		case ck_date:		outs << dates_[row]; break;
+		case ck_datetime:	outs << datetimes_[row]; break;
+		case ck_time:		outs << times_[row]; break;
+
+		case ck_double:
+			outs.precision(17);	// see SQLTypeAdapter(double)
+			outs << doubles_[row];
+			break;
+
+		case ck_string:
+			return String(c_str(row), length(row), type_, false);
+	}
+
+	return String(outs.str(), type_, false);
+}
+
+
+ColumnarResult::ColumnarResult(MYSQL_RES* res, DBDriver* dbd, bool te) :
+ResultBase(res, dbd, te),
+rows_(res && dbd ? size_type(dbd->num_rows(res)) : 0),
+copacetic_(res && dbd)
+{
+	if (copacetic_) {
+		// Find out how much text each string column holds, so we can
+		// allocate all of its buffer at once.  The C API already knows
+		// every field's length, so this pass is cheap.
+		const size_t nf = num_fields();
+		std::vector<size_type> string_bytes(nf, 0);
+		while (MYSQL_ROW row = dbd->fetch_row(res)) {
+			if (const unsigned long* lengths = dbd->fetch_lengths(res)) {
+				for (size_t i = 0; i < nf; ++i) {
+					string_bytes[i] += (row[i] ? lengths[i] : 0) + 1;
+				}
+			}
+		}
+		dbd->data_seek(res, 0);
+
+		columns_.resize(nf);
+		for (size_t i = 0; i < nf; ++i) {
+			columns_[i].init(field_type(int(i)), rows_, string_bytes[i]);
+		}
+
+		try {
+			while (MYSQL_ROW row = dbd->fetch_row(res)) {
+				if (const unsigned long* lengths =
+						dbd->fetch_lengths(res)) {
+					for (size_t i = 0; i < nf; ++i) {
+						columns_[i].push_back(row[i], lengths[i],
+								throw_exceptions());
+					}
+				}
+			}
+		}
+		catch (...) {
+			dbd->free_result(res);	// BadConversion; don't leak
+			throw;
+		}
+		if (nf > 0) {
+			rows_ = columns_[0].size();	// in case the C API let us down
+		}
+
+		dbd->free_result(res);
+	}
+}
+
+
+const ColumnarResult::Column&
+ColumnarResult::column(size_type i) const
+{
+	if (i < columns_.size()) {
+		return columns_[i];
+	}
+	else {
+		throw BadIndex("ColumnarResult", int(i), int(columns_.size()));
+	}
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,347 @@
+/// \file columnar.h
+/// \brief Declares the ColumnarResult class, which holds a result set
+/// column by column in typed arrays.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_COLUMNAR_H)
+#define MYSQLPP_COLUMNAR_H
+
+#include "common.h"
+
+#include "datetime.h"
+#include "result.h"
+
+#include <vector>
+
+namespace mysqlpp {
+
+/// \brief Result set type holding each column in a contiguous,
+/// typed array
+///
+/// StoreQueryResult is row-major: each row is a list of String
+/// objects, and converting one to a number means parsing it.  Code
+/// that scans a column or two of a big result set -- summing, finding
+/// a maximum, filtering -- spends most of its time chasing pointers
+/// and re-parsing the same text.  This class instead parses every
+/// field exactly once, when the result set is stored, putting each
+/// column into an array of the closest native C++ type:
+///
+/// - integer columns become arrays of \c longlong, or \c ulonglong
+///   for <tt>BIGINT UNSIGNED</tt>
+/// - \c FLOAT, \c DOUBLE and \c DECIMAL columns become arrays of
+///   \c double
+/// - \c DATE, \c DATETIME, \c TIMESTAMP and \c TIME columns become
+///   arrays of Date, DateTime or Time
+/// - everything else is kept as text, all in one buffer, with a table
+///   of offsets into it
+///
+/// The column's kind is chosen from the field's SQL type, as reported
+/// in field_types().  Each column also has a packed bitmap recording
+/// which rows are SQL null; the typed array holds a zero or default
+/// value in those positions.
+///
+/// You get one of these from Query::store_columnar():
+///
+/// \code
+///   mysqlpp::ColumnarResult res = query.store_columnar();
+///   const mysqlpp::ColumnarResult::Column& qty = res["quantity"];
+///   const mysqlpp::longlong* p = qty.ints();
+///   mysqlpp::longlong total = 0;
+///   for (size_t i = 0; i < res.num_rows(); ++i) {
+///       total += p[i];      // nulls were stored as 0
+///   }
+/// \endcode
+
+class MYSQLPP_EXPORT ColumnarResult : public ResultBase
+{
+private:
+	/// \brief Pointer to bool data member, for use by safe bool
+	/// conversion operator.
+	///
+	/// \see http://www.artima.com/cppsource/safebool.html
+	typedef bool ColumnarResult::*private_bool_type;
+
+public:
+	/// \brief Type of row counts and indices
+	typedef size_t size_type;
+
+	/// \brief The ways a column's data can be stored
+	enum column_kind {
+		ck_int,			///< signed integers, in ints()
+		ck_uint,		///< BIGINT UNSIGNED, in uints()
+		ck_double,		///< floating-point and decimal, in doubles()
+		ck_date,		///< DATE, in dates()
+		ck_datetime,	///< DATETIME and TIMESTAMP, in datetimes()
+		ck_time,		///< TIME, in times()
+		ck_string		///< anything else, in string_data()
+	};
+
+	/// \brief One column of a ColumnarResult
+	///
+	/// Only one of the typed array accessors returns non-null data for
+	/// any given column, depending on kind().  The arrays each have
+	/// one element per row of the result set.
+	class MYSQLPP_EXPORT Column
+	{
+	public:
+		/// \brief Create an empty column
+		Column() :
+		kind_(ck_string),
+		size_(0),
+		null_count_(0)
+		{
+		}
+
+		/// \brief Return the way this column's data is stored
+		column_kind kind() const { return kind_; }
+
+		/// \brief Return the SQL type of the column
+		const mysql_type_info& type() const { return type_; }
+
+		/// \brief Return the number of rows in the column
+		size_type size() const { return size_; }
+
+		/// \brief Returns true if the given row is SQL null
+		bool is_null(size_type row) const
+		{
+			return null_count_ &&
+					(nulls_[row / 8] & (1 << (row % 8))) != 0;
+		}
+
+		/// \brief Return the number of null rows in the column
+		///
+		/// If this is 0, you can skip checking is_null() entirely.
+		size_type null_count() const { return null_count_; }
+
+		/// \brief Return the column's null bitmap
+		///
+		/// Row \c i is null if bit <tt>i % 8</tt> of byte \c i / 8 is
+		/// set.  Returns 0 if no row in the column is null.
+		const unsigned char* null_bitmap() const
+				{ return null_count_ ? &nulls_[0] : 0; }
+
+		/// \brief Return the column's data as signed integers, or 0
+		/// if kind() isn't ck_int
+		const longlong* ints() const { return data(ints_); }
+
+		/// \brief Return the column's data as unsigned integers, or 0
+		/// if kind() isn't ck_uint
+		const ulonglong* uints() const { return data(uints_); }
+
+		/// \brief Return the column's data as floating-point values,
+		/// or 0 if kind() isn't ck_double
+		const double* doubles() const { return data(doubles_); }
+
+		/// \brief Return the column's data as dates, or 0 if kind()
+		/// isn't ck_date
+		const Date* dates() const { return data(dates_); }
+
+		/// \brief Return the column's data as date/times, or 0 if
+		/// kind() isn't ck_datetime
+		const DateTime* datetimes() const { return data(datetimes_); }
+
+		/// \brief Return the column's data as times, or 0 if kind()
+		/// isn't ck_time
+		const Time* times() const { return data(times_); }
+
+		/// \brief Return the buffer holding a ck_string column's text,
+		/// or 0 for other column kinds
+		///
+		/// Each row's text starts at the offset given by
+		/// string_offsets(), and is null-terminated.
+		const char* string_data() const { return data(chars_); }
+
+		/// \brief Return the table of offsets into string_data()
+		///
+		/// This has size() + 1 entries, so the length of row \c i is
+		/// always <tt>offsets[i + 1] - offsets[i] - 1</tt>, allowing
+		/// for the null terminator.  Returns 0 if kind() isn't
+		/// ck_string.
+		const size_type* string_offsets() const
+				{ return data(offsets_); }
+
+		/// \brief Return a ck_string column's text for the given row
+		const char* c_str(size_type row) const
+				{ return &chars_[offsets_[row]]; }
+
+		/// \brief Return the length of a ck_string column's text for
+		/// the given row
+		size_type length(size_type row) const
+				{ return offsets_[row + 1] - offsets_[row] - 1; }
+
+		/// \brief Return the given row's value as a String
+		///
+		/// This works for all column kinds, but it's slow, since it
+		/// has to turn typed values back into text.  It's meant for
+		/// generic code, like a program that prints out any result set
+		/// it's given.
+		String value(size_type row) const;
+
+	private:
+		friend class ColumnarResult;
+
+		/// \brief Return a pointer to a vector's data, or 0 if empty
+		template <class T>
+		static const T* data(const std::vector<T>& v)
+				{ return v.empty() ? 0 : &v[0]; }
+
+		/// \brief Set up the column to receive \c rows values of the
+		/// given SQL type
+		void init(const mysql_type_info& type, size_type rows,
+				size_type string_bytes);
+
+		/// \brief Parse and append one field's value
+		void push_back(const char* data, unsigned long length,
+				bool throw_excptns);
+
+		column_kind kind_;
+		mysql_type_info type_;
+		size_type size_;
+		size_type null_count_;
+		std::vector<unsigned char> nulls_;
+		std::vector<longlong> ints_;
+		std::vector<ulonglong> uints_;
+		std::vector<double> doubles_;
+		std::vector<Date> dates_;
+		std::vector<DateTime> datetimes_;
+		std::vector<Time> times_;
+		std::vector<char> chars_;
+		std::vector<size_type> offsets_;
+	};
+
+	/// \brief Default constructor
+	ColumnarResult() :
+	ResultBase(),
+	rows_(0),
+	copacetic_(false)
+	{
+	}
+
+	/// \brief Fully initialize object
+	///
+	/// \param result C API result set to read the data from; we free
+	/// it when we're done with it
+	/// \param dbd database driver the result set came from
+	/// \param te if true, throw exceptions on errors
+	ColumnarResult(MYSQL_RES* result, DBDriver* dbd, bool te = true);
+
+	/// \brief Initialize object as a copy of another ColumnarResult
+	ColumnarResult(const ColumnarResult& other) :
+	ResultBase(other),
+	columns_(other.columns_),
+	rows_(other.rows_),
+	copacetic_(other.copacetic_)
+	{
+	}
+
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move constructor; leaves \c other empty
+	ColumnarResult(ColumnarResult&& other) :
+	ResultBase(),
+	rows_(0),
+	copacetic_(false)
+	{
+		swap(other);
+	}
+#endif
+
+	/// \brief Copy another ColumnarResult object's data into this one
+	ColumnarResult& operator =(const ColumnarResult& rhs)
+	{
+		if (this != &rhs) {
+			ResultBase::copy(rhs);
+			columns_ = rhs.columns_;
+			rows_ = rhs.rows_;
+			copacetic_ = rhs.copacetic_;
+		}
+		return *this;
+	}
+
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move another ColumnarResult object's data into this one
+	ColumnarResult& operator =(ColumnarResult&& rhs)
+	{
+		swap(rhs);
+		return *this;
+	}
+#endif
+
+	/// \brief Exchange contents with another ColumnarResult
+	///
+	/// Only the column vectors' buffers change hands, so this takes
+	/// constant time.
+	void swap(ColumnarResult& other)
+	{
+		ResultBase::swap(other);
+		columns_.swap(other.columns_);
+		std::swap(rows_, other.rows_);
+		std::swap(copacetic_, other.copacetic_);
+	}
+
+	/// \brief Get a column given its index
+	///
+	/// \throw mysqlpp::BadIndex if there are less than \c i columns
+	const Column& column(size_type i) const;
+
+	/// \brief Get a column given its name
+	///
+	/// \throw mysqlpp::BadFieldName if there is no such column
+	const Column& column(const char* name) const
+			{ return column(size_type(field_num(name))); }
+
+	/// \brief Returns the number of columns in this result set
+	size_type num_columns() const { return columns_.size(); }
+
+	/// \brief Returns the number of rows in this result set
+	size_type num_rows() const { return rows_; }
+
+	/// \brief Get a column given its name
+	const Column& operator [](const char* name) const
+			{ return column(name); }
+
+	/// \brief Get a column given its index
+	///
+	/// As with Row::operator[](int), the parameter must be \c int to
+	/// avoid ambiguity with the \c const \c char* overload.
+	const Column& operator [](int i) const
+			{ return column(size_type(i)); }
+
+	/// \brief Test whether the query that created this result succeeded
+	///
+	/// \sa StoreQueryResult::operator private_bool_type()
+	operator private_bool_type() const
+	{
+		return copacetic_ ? &ColumnarResult::copacetic_ : 0;
+	}
+
+private:
+	std::vector<Column> columns_;	///< the result set's data
+	size_type rows_;				///< number of rows in each column
+	bool copacetic_;	///< true if initialized from a good result set
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_COLUMNAR_H)
@@ -130,6 +130,13 @@
 	#define MYSQLPP_PATH_SEPARATOR '/'
 #endif
 
+// Give our heavyweight classes move operations if the compiler
+// supports C++11 rvalue references.  The library itself is still
+// C++98, so everything must also work without them.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#	define MYSQLPP_HAVE_RVALUE_REFS
+#endif
+
 #if defined(MYSQLPP_MYSQL_HEADERS_BURIED)
 #	include <mysql/mysql_version.h>
 #else
@@ -28,6 +28,7 @@
 #include "connection.h"
 
 #include "dbdriver.h"
+#include "prepared_query.h"
 #include "query.h"
 #include "result.h"
 
@@ -38,7 +39,8 @@ namespace mysqlpp {
 Connection::Connection(bool te) :
 OptionalExceptions(te),
 driver_(new DBDriver()),
-copacetic_(true)
+copacetic_(true),
+store_budget_(0)
 {
 }
 
@@ -47,7 +49,8 @@ Connection::Connection(const char* db, const char* server,
 		const char* user, const char* password, unsigned int port) :
 OptionalExceptions(),
 driver_(new DBDriver()),
-copacetic_(true)
+copacetic_(true),
+store_budget_(0)
 {
 	try {
 		connect(db, server, user, password, port);
@@ -63,7 +66,8 @@ copacetic_(true)
 
 Connection::Connection(const Connection& other) :
 OptionalExceptions(other.throw_exceptions()),
-driver_(new DBDriver(*other.driver_))
+driver_(new DBDriver(*other.driver_)),
+store_budget_(0)
 {
 	copy(other);
 }
@@ -127,6 +131,7 @@ Connection::copy(const Connection& other)
 {
 	error_message_.clear();
 	set_exceptions(other.throw_exceptions());
+	store_budget_ = other.store_budget_;
 	driver_->copy(*other.driver_);
 }
 
@@ -259,6 +264,13 @@ Connection::ping()
 }
 
 
+PreparedQuery
+Connection::prepare(const std::string& sql)
+{
+	return PreparedQuery(this, sql, throw_exceptions());
+}
+
+
 int
 Connection::protocol_version() const
 {
@@ -280,6 +292,15 @@ Connection::query(const std::string& qstr)
 }
 
 
+Query
+Connection::query(const QueryTemplate& tmpl)
+{
+	Query q(this, throw_exceptions());
+	q.query_template(tmpl);
+	return q;
+}
+
+
 bool
 Connection::select_db(const std::string& db)
 {
@@ -46,7 +46,9 @@ namespace mysqlpp {
 
 #if !defined(DOXYGEN_IGNORE)
 // Make Doxygen ignore this
+class MYSQLPP_EXPORT PreparedQuery;
 class MYSQLPP_EXPORT Query;
+class MYSQLPP_EXPORT QueryTemplate;
 class DBDriver;
 #endif
 
@@ -234,6 +236,18 @@ public:
 	/// the ping and we could not re-establish the connection.
 	bool ping();
 
+	/// \brief Prepare a statement on the server, returning an object
+	/// you can execute it through many times
+	///
+	/// If this connection's StatementCache already has the statement,
+	/// and no other PreparedQuery is using it, the returned object
+	/// takes it over rather than having the server prepare it again.
+	///
+	/// \param sql SQL statement, with \c ? in place of each parameter
+	///
+	/// \sa PreparedQuery, StatementCache
+	PreparedQuery prepare(const std::string& sql);
+
 	/// \brief Returns version number of the protocol the database
 	/// driver uses to communicate with the server.
 	int protocol_version() const;
@@ -255,6 +269,12 @@ public:
 	/// \param qstr initial query string
 	Query query(const std::string& qstr);
 
+	/// \brief Return a new query object set up to fill in an
+	/// already-parsed template query
+	///
+	/// \param tmpl template query to use; see QueryTemplate
+	Query query(const QueryTemplate& tmpl);
+
 	/// \brief Change to a different database managed by the
 	/// database server we are connected to.
 	///
@@ -297,6 +317,16 @@ public:
 	/// \brief Returns information about database server's status
 	std::string server_status() const;
 
+	/// \brief Get the default memory budget for stored result sets
+	size_t store_budget() const { return store_budget_; }
+
+	/// \brief Set the default memory budget for stored result sets
+	///
+	/// Queries made through this connection that don't have a budget
+	/// of their own use this one.  See Query::store_budget(size_t).
+	/// The default, 0, means no limit.
+	void store_budget(size_t bytes) { store_budget_ = bytes; }
+
 	/// \brief Returns true if both MySQL++ and database driver we're
 	/// using were compiled with thread awareness.
 	static bool thread_aware();
@@ -354,6 +384,7 @@ protected:
 private:
 	DBDriver* driver_;
 	bool copacetic_;
+	size_t store_budget_;	///< default Query::store_budget(); 0 = none
 };
 
 
@@ -27,6 +27,7 @@
 #include "cpool.h"
 
 #include "connection.h"
+#include "prepared_query.h"
 
 #include <algorithm>
 #include <functional>
@@ -132,7 +133,9 @@ ConnectionPool::grab()
 	}
 	else {
 		// No free connections, so create and return a new one.
-		pool_.push_back(ConnectionInfo(create()));
+		Connection* pc = create();
+		warm_up(pc);
+		pool_.push_back(ConnectionInfo(pc));
 		return pool_.back().conn;
 	}
 }
@@ -218,5 +221,34 @@ ConnectionPool::safe_grab()
 }
 
 
-} // end namespace mysqlpp
+//// warm_statements ///////////////////////////////////////////////////
+
+void
+ConnectionPool::warm_statements(const std::vector<std::string>& sql)
+{
+	ScopedLock lock(mutex_);	// ensure we're not interfered with
+	warm_statements_ = sql;
+}
+
+
+//// warm_up ///////////////////////////////////////////////////////////
+// Prepare the warm_statements() list on a new connection, putting them
+// in its StatementCache.  Errors are left for the caller to find when
+// it prepares the statement itself, so we don't throw out of grab()
+// with a connection the caller never got.
 
+void
+ConnectionPool::warm_up(Connection* pc)
+{
+	// Don't grab the mutex.  Only called from grab(), which does.
+	if (!pc) {
+		return;
+	}
+
+	std::vector<std::string>::const_iterator it;
+	for (it = warm_statements_.begin(); it != warm_statements_.end(); ++it) {
+		PreparedQuery warm(pc, *it, false);
+	}
+}
+
+} // end namespace mysqlpp
@@ -31,6 +31,8 @@
 #include "beemutex.h"
 
 #include <list>
+#include <string>
+#include <vector>
 
 #include <assert.h>
 #include <time.h>
@@ -164,6 +166,21 @@ public:
 	/// \brief Remove all unused connections from the pool
 	void shrink() { clear(false); }
 
+	/// \brief Set the statements to prepare on each new connection
+	///
+	/// When grab() has to create() a connection, it first prepares
+	/// each of these on it, so they're already in the connection's
+	/// StatementCache when the caller goes to prepare them.  This
+	/// keeps the first request on a fresh connection from being slower
+	/// than the rest.  A statement that fails to prepare is skipped;
+	/// you'll get the error when you prepare it yourself.
+	///
+	/// Listing more statements than the StatementCache holds is
+	/// pointless, since the later ones push out the earlier ones.
+	///
+	/// \param sql the statements, with \c ? for each parameter
+	void warm_statements(const std::vector<std::string>& sql);
+
 protected:
 	/// \brief Drains the pool, freeing all allocated memory.
 	///
@@ -243,9 +260,11 @@ private:
 	Connection* find_mru();
 	void remove(const PoolIt& it);
 	void remove_old_connections();
+	void warm_up(Connection* pc);
 
 	//// Internal data
 	PoolT pool_;
+	std::vector<std::string> warm_statements_;
 	BeecryptMutex mutex_;
 };
 
@@ -3,7 +3,7 @@
 	various date and time column types.
 
  Copyright (c) 1998 by Kevin Atkinson, (c) 1999-2001 by MySQL AB, and
- (c) 2004-2008 by Educational Technology Resources, Inc.  Others may
+ (c) 2004-2008, 2026 by Educational Technology Resources, Inc.  Others may
  also hold copyrights on code in this file.  See the CREDITS.txt file
  in the top directory of the distribution for details.
 
@@ -29,11 +29,9 @@
 #include "common.h"
 
 #include "datetime.h"
-#include "stream2string.h"
+#include "beemutex.h"
 
-#include <iomanip>
-
-#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 using namespace std;
@@ -58,67 +56,357 @@ safe_localtime(struct tm* ptm, const time_t t)
 }
 
 
-std::ostream& operator <<(std::ostream& os, const Date& d)
+//// Calendar arithmetic ///////////////////////////////////////////////
+// These convert between proleptic Gregorian dates and a count of days
+// since 1970-01-01, without going through the C library.  The method
+// is Howard Hinnant's: shift the year to start in March, so the leap
+// day falls at the end, then work in 400-year eras.
+
+static const long seconds_per_day = 86400;
+
+// Floor division, for the negative values before 1970
+static inline long
+floor_div(time_t a, long b)
 {
-	char fill = os.fill('0');
-	ios::fmtflags flags = os.setf(ios::right);
-	os		<< setw(4) << d.year() << '-'
-			<< setw(2) << static_cast<int>(d.month()) << '-'
-			<< setw(2) << static_cast<int>(d.day());
-	os.flags(flags);
-	os.fill(fill);
-	return os;
+	return long(a >= 0 ? a / b : -((-a - 1) / b) - 1);
 }
 
 
-std::ostream& operator <<(std::ostream& os, const Time& t)
+static long
+days_from_civil(long y, unsigned m, unsigned d)
 {
-	char fill = os.fill('0');
-	ios::fmtflags flags = os.setf(ios::right);
-	os		<< setw(2) << static_cast<int>(t.hour()) << ':'
-			<< setw(2) << static_cast<int>(t.minute()) << ':'
-			<< setw(2) << static_cast<int>(t.second());
-	os.flags(flags);
-	os.fill(fill);
-	return os;
+	y -= m <= 2;
+	const long era = (y >= 0 ? y : y - 399) / 400;
+	const unsigned yoe = unsigned(y - era * 400);
+	const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+	const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + long(doe) - 719468;
 }
 
 
-std::ostream& operator <<(std::ostream& os, const DateTime& dt)
+static void
+civil_from_days(long z, long& y, unsigned& m, unsigned& d)
+{
+	z += 719468;
+	const long era = (z >= 0 ? z : z - 146096) / 146097;
+	const unsigned doe = unsigned(z - era * 146097);
+	const unsigned yoe = (doe - doe / 1460 + doe / 36524 -
+			doe / 146096) / 365;
+	const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	const unsigned mp = (5 * doy + 2) / 153;
+	d = doy - (153 * mp + 2) / 5 + 1;
+	m = mp < 10 ? mp + 3 : mp - 9;
+	y = long(yoe) + era * 400 + (m <= 2);
+}
+
+
+//// UTC offset cache //////////////////////////////////////////////////
+// Calling localtime() for every time_t we convert is slow, and most
+// programs convert many values from a few days.  So, we remember the
+// local zone's offset from UTC for the last few UTC days we've seen,
+// as long as it's the same all day long.  Days with a daylight saving
+// time change aren't cached; they always go through the C library.
+
+static const int offset_cache_size = 16;	// must be a power of 2
+
+static struct {
+	long day;		// UTC day number, or 0 if slot unused
+	long offset;	// seconds to add to UTC to get local time
+} offset_cache[offset_cache_size];
+
+static BeecryptMutex offset_cache_mutex;
+
+
+// Returns the local zone's offset from UTC at time t, the slow way
+static long
+local_offset(time_t t)
 {
-	if (dt.is_now()) {
-		return os << "NOW()";
+	struct tm tm;
+	safe_localtime(&tm, t);
+	const time_t local = time_t(days_from_civil(tm.tm_year + 1900,
+			tm.tm_mon + 1, tm.tm_mday)) * seconds_per_day +
+			time_t(tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec);
+	return long(local - t);
+}
+
+
+// Finds the local zone's offset from UTC at time t, if it's the same
+// for all of t's UTC day.  Returns false if it isn't.
+static bool
+cached_offset(time_t t, long& offset)
+{
+	const long day = floor_div(t, seconds_per_day);
+	const int slot = int(day & (offset_cache_size - 1));
+	{
+		ScopedLock lock(offset_cache_mutex);
+		if (offset_cache[slot].day == day && day != 0) {
+			offset = offset_cache[slot].offset;
+			return true;
+		}
+	}
+
+	const time_t start = time_t(day) * seconds_per_day;
+	offset = local_offset(start);
+	if (local_offset(start + seconds_per_day - 1) != offset) {
+		return false;
+	}
+
+	ScopedLock lock(offset_cache_mutex);
+	offset_cache[slot].day = day;
+	offset_cache[slot].offset = offset;
+	return true;
+}
+
+
+// Breaks a time_t down into local date and time values
+static void
+split_time(time_t t, long& year, unsigned& month, unsigned& day,
+		unsigned& hour, unsigned& minute, unsigned& second)
+{
+	long offset;
+	if (cached_offset(t, offset)) {
+		const time_t local = t + offset;
+		const long days = floor_div(local, seconds_per_day);
+		long secs = long(local - time_t(days) * seconds_per_day);
+		civil_from_days(days, year, month, day);
+		hour = unsigned(secs / 3600);
+		secs %= 3600;
+		minute = unsigned(secs / 60);
+		second = unsigned(secs % 60);
 	}
 	else {
-		operator <<(os, Date(dt));
-		os << ' ';
-		return operator <<(os, Time(dt));
+		struct tm tm;
+		safe_localtime(&tm, t);
+		year = tm.tm_year + 1900;
+		month = tm.tm_mon + 1;
+		day = tm.tm_mday;
+		hour = tm.tm_hour;
+		minute = tm.tm_min;
+		second = tm.tm_sec;
 	}
 }
 
 
-Date::Date(time_t t)
+// Converts local date and time values to a time_t.  Out-of-range
+// values are normalized, as mktime() does.
+static time_t
+join_time(long year, unsigned month, unsigned day, unsigned hour,
+		unsigned minute, unsigned second)
 {
+	if (month >= 1 && month <= 12 && day >= 1 && day <= 31 &&
+			hour < 24 && minute < 60 && second < 60) {
+		// Treat the local time as UTC to find a day to look up the
+		// offset for, then check that the offset we get is also the
+		// one in effect at the resulting time.  If either lookup falls
+		// on a DST change day, we let mktime() sort it out.
+		const time_t local = time_t(days_from_civil(year, month, day)) *
+				seconds_per_day + time_t(hour * 3600 + minute * 60 + second);
+		long offset, check;
+		if (cached_offset(local, offset) &&
+				cached_offset(local - offset, check) &&
+				offset == check) {
+			return local - offset;
+		}
+	}
+
 	struct tm tm;
-	safe_localtime(&tm, t);
+	tm.tm_sec = second;
+	tm.tm_min = minute;
+	tm.tm_hour = hour;
+	tm.tm_mday = day;
+	tm.tm_mon = month - 1;
+	tm.tm_year = year - 1900;
+	tm.tm_isdst = -1;
+	return mktime(&tm);
+}
+
 
-	year_ = tm.tm_year + 1900;
-	month_ = tm.tm_mon + 1;
-	day_ = tm.tm_mday;
+//// Parsing and formatting ////////////////////////////////////////////
+
+static inline bool
+is_digit(char c)
+{
+	return c >= '0' && c <= '9';
 }
 
 
-DateTime::DateTime(time_t t)
+// Parse up to max_digits digits at str.  Fields in SQL date and time
+// strings are fixed width, but we also accept shorter ones, so that
+// "2008-1-5" works.
+static inline unsigned
+parse_field(const char*& str, int max_digits)
 {
-	struct tm tm;
-	safe_localtime(&tm, t);
+	unsigned value = 0;
+	for (int i = 0; i < max_digits && is_digit(*str); ++i) {
+		value = value * 10 + (*str++ - '0');
+	}
+	return value;
+}
+
+
+static const char*
+parse_date(const char* str, unsigned& year, unsigned& month,
+		unsigned& day)
+{
+	year = parse_field(str, 4);
+	if (*str == '-') ++str;
+	month = parse_field(str, 2);
+	if (*str == '-') ++str;
+	day = parse_field(str, 2);
+	return str;
+}
+
+
+static const char*
+parse_time(const char* str, unsigned& hour, unsigned& minute,
+		unsigned& second, unsigned long& microsecond)
+{
+	// TIME values can run past 99 hours.  Only take a third hour digit
+	// if a colon follows, so the compact HHMMSS form still works.
+	hour = parse_field(str, is_digit(str[0]) && is_digit(str[1]) &&
+			is_digit(str[2]) && str[3] == ':' ? 3 : 2);
+	if (*str == ':') ++str;
+	minute = parse_field(str, 2);
+	if (*str == ':') ++str;
+	second = parse_field(str, 2);
+
+	// Fractional second, as sent for DATETIME(N) and TIME(N) columns.
+	// We keep microseconds, the most MySQL supports.
+	microsecond = 0;
+	if (*str == '.' && is_digit(str[1])) {
+		++str;
+		int digits = 0;
+		for (; digits < 6 && is_digit(*str); ++digits) {
+			microsecond = microsecond * 10 + (*str++ - '0');
+		}
+		for (; digits < 6; ++digits) {
+			microsecond *= 10;
+		}
+		while (is_digit(*str)) {
+			++str;			// more precision than we can hold
+		}
+	}
+
+	return str;
+}
+
+
+// "00" through "99", for two-digit fields
+static const char digit_pairs[] =
+		"00010203040506070809101112131415161718192021222324"
+		"25262728293031323334353637383940414243444546474849"
+		"50515253545556575859606162636465666768697071727374"
+		"75767778798081828384858687888990919293949596979899";
+
+
+// Write v as a decimal number at least width digits wide, zero padded.
+// Returns a pointer just past the last digit.
+static inline char*
+format_field(char* p, unsigned long v, int width)
+{
+	if (v < 100 && width == 2) {
+		memcpy(p, digit_pairs + v * 2, 2);
+		return p + 2;
+	}
+
+	char digits[12];
+	int n = 0;
+	do {
+		digits[n++] = char('0' + v % 10);
+		v /= 10;
+	}
+	while (v);
+	while (n < width) {
+		*p++ = '0';
+		--width;
+	}
+	while (n) {
+		*p++ = digits[--n];
+	}
+	return p;
+}
+
+
+static char*
+format_date(char* p, unsigned year, unsigned month, unsigned day)
+{
+	if (year >= 1000 && year <= 9999) {
+		p = format_field(p, year / 100, 2);
+		p = format_field(p, year % 100, 2);
+	}
+	else {
+		p = format_field(p, year, 4);
+	}
+	*p++ = '-';
+	p = format_field(p, month, 2);
+	*p++ = '-';
+	return format_field(p, day, 2);
+}
+
+
+static char*
+format_time(char* p, unsigned hour, unsigned minute, unsigned second,
+		unsigned long microsecond)
+{
+	p = format_field(p, hour, 2);
+	*p++ = ':';
+	p = format_field(p, minute, 2);
+	*p++ = ':';
+	p = format_field(p, second, 2);
+	if (microsecond) {
+		*p++ = '.';
+		p = format_field(p, microsecond % 1000000, 6);
+	}
+	return p;
+}
+
 
-	year_ = tm.tm_year + 1900;
-	month_ = tm.tm_mon + 1;
-	day_ = tm.tm_mday;
-	hour_ = tm.tm_hour;
-	minute_ = tm.tm_min;
-	second_ = tm.tm_sec;
+std::ostream& operator <<(std::ostream& os, const Date& d)
+{
+	char buf[Date::max_length];
+	return os.write(buf, d.format(buf));
+}
+
+
+std::ostream& operator <<(std::ostream& os, const Time& t)
+{
+	char buf[Time::max_length];
+	return os.write(buf, t.format(buf));
+}
+
+
+std::ostream& operator <<(std::ostream& os, const DateTime& dt)
+{
+	char buf[DateTime::max_length];
+	return os.write(buf, dt.format(buf));
+}
+
+
+Date::Date(time_t t)
+{
+	long y;
+	unsigned mon, d, h, min, s;
+	split_time(t, y, mon, d, h, min, s);
+
+	year_ = static_cast<unsigned short>(y);
+	month_ = static_cast<unsigned char>(mon);
+	day_ = static_cast<unsigned char>(d);
+}
+
+
+DateTime::DateTime(time_t t)
+{
+	long y;
+	unsigned mon, d, h, min, s;
+	split_time(t, y, mon, d, h, min, s);
+
+	year_ = static_cast<unsigned short>(y);
+	month_ = static_cast<unsigned char>(mon);
+	day_ = static_cast<unsigned char>(d);
+	hour_ = static_cast<unsigned char>(h);
+	minute_ = static_cast<unsigned char>(min);
+	second_ = static_cast<unsigned char>(s);
+	microsecond_ = 0;
 
 	now_ = false;
 }
@@ -126,38 +414,26 @@ DateTime::DateTime(time_t t)
 
 Time::Time(time_t t)
 {
-	struct tm tm;
-	safe_localtime(&tm, t);
-
-	hour_ = tm.tm_hour;
-	minute_ = tm.tm_min;
-	second_ = tm.tm_sec;
+	long y;
+	unsigned mon, d, h, min, s;
+	split_time(t, y, mon, d, h, min, s);
+
+	hour_ = static_cast<unsigned char>(h);
+	minute_ = static_cast<unsigned char>(min);
+	second_ = static_cast<unsigned char>(s);
+	microsecond_ = 0;
 }
 
 
 const char*
 Date::convert(const char* str)
 {
-	char num[5];
-
-	num[0] = *str++;
-	num[1] = *str++;
-	num[2] = *str++;
-	num[3] = *str++;
-	num[4] = 0;
-	year_ = static_cast<unsigned short>(strtol(num, 0, 10));
-	if (*str == '-') str++;
+	unsigned y, m, d;
+	str = parse_date(str, y, m, d);
 
-	num[0] = *str++;
-	num[1] = *str++;
-	num[2] = 0;
-	month_ = static_cast<unsigned char>(strtol(num, 0, 10));
-	if (*str == '-') str++;
-
-	num[0] = *str++;
-	num[1] = *str++;
-	num[2] = 0;
-	day_ = static_cast<unsigned char>(strtol(num, 0, 10));
+	year_ = static_cast<unsigned short>(y);
+	month_ = static_cast<unsigned char>(m);
+	day_ = static_cast<unsigned char>(d);
 
 	return str;
 }
@@ -166,24 +442,12 @@ Date::convert(const char* str)
 const char*
 Time::convert(const char* str)
 {
-	char num[5];
-
-	num[0] = *str++;
-	num[1] = *str++;
-	num[2] = 0;
-	hour_ = static_cast<unsigned char>(strtol(num,0,10));
-	if (*str == ':') str++;
+	unsigned h, m, s;
+	str = parse_time(str, h, m, s, microsecond_);
 
-	num[0] = *str++;
-	num[1] = *str++;
-	num[2] = 0;
-	minute_ = static_cast<unsigned char>(strtol(num,0,10));
-	if (*str == ':') str++;
-
-	num[0] = *str++;
-	num[1] = *str++;
-	num[2] = 0;
-	second_ = static_cast<unsigned char>(strtol(num,0,10));
+	hour_ = static_cast<unsigned char>(h);
+	minute_ = static_cast<unsigned char>(m);
+	second_ = static_cast<unsigned char>(s);
 
 	return str;
 }
@@ -192,19 +456,17 @@ Time::convert(const char* str)
 const char*
 DateTime::convert(const char* str)
 {
-	Date d;
-	str = d.convert(str);
-	year_ = d.year();
-	month_ = d.month();
-	day_ = d.day();
-	
-	if (*str == ' ') ++str;
-
-	Time t;
-	str = t.convert(str);
-	hour_ = t.hour();
-	minute_ = t.minute();
-	second_ = t.second();
+	unsigned y, mon, d, h, min, s;
+	str = parse_date(str, y, mon, d);
+	if (*str == ' ' || *str == 'T') ++str;
+	str = parse_time(str, h, min, s, microsecond_);
+
+	year_ = static_cast<unsigned short>(y);
+	month_ = static_cast<unsigned char>(mon);
+	day_ = static_cast<unsigned char>(d);
+	hour_ = static_cast<unsigned char>(h);
+	minute_ = static_cast<unsigned char>(min);
+	second_ = static_cast<unsigned char>(s);
 
 	now_ = false;
 	
@@ -212,21 +474,57 @@ DateTime::convert(const char* str)
 }
 
 
+size_t
+Date::format(char* buf) const
+{
+	return format_date(buf, year_, month_, day_) - buf;
+}
+
+
+size_t
+Time::format(char* buf) const
+{
+	return format_time(buf, hour_, minute_, second_, microsecond_) - buf;
+}
+
+
+size_t
+DateTime::format(char* buf) const
+{
+	if (now_) {
+		memcpy(buf, "NOW()", 5);
+		return 5;
+	}
+	else {
+		char* p = format_date(buf, year_, month_, day_);
+		*p++ = ' ';
+		return format_time(p, hour_, minute_, second_, microsecond_) -
+				buf;
+	}
+}
+
+
+// Turns the result of comparing two packed values into compare()'s
+// return value
+template <typename T>
+static inline int
+packed_compare(T a, T b)
+{
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+
 int
 Date::compare(const Date& other) const
 {
-	if (year_ != other.year_) return year_ - other.year_;
-	if (month_ != other.month_) return month_ - other.month_;
-	return day_ - other.day_;
+	return packed_compare(packed(), other.packed());
 }
 
 
 int
 Time::compare(const Time& other) const
 {
-	if (hour_ != other.hour_) return hour_ - other.hour_;
-	if (minute_ != other.minute_) return minute_ - other.minute_;
-	return second_ - other.second_;
+	return packed_compare(packed(), other.packed());
 }
 
 
@@ -236,49 +534,45 @@ DateTime::compare(const DateTime& other) const
 	if (now_ && other.now_) {
 		return 0;
 	}
+	else if (int x = packed_compare(Date(*this).packed(),
+			Date(other).packed())) {
+		return x;
+	}
 	else {
-		Date d(*this), od(other);
-		Time t(*this), ot(other);
-
-		if (int x = d.compare(od)) {
-			return x;
-		}
-		else {
-			return t.compare(ot);
-		}
+		// Can't use our own packed() here; it isn't exact if any
+		// field is out of range.
+		return packed_compare(Time(*this).packed(),
+				Time(other).packed());
 	}
 }
 
 
 Date::operator std::string() const
 {
-	return stream2string(*this);
+	char buf[max_length];
+	return std::string(buf, format(buf));
 }
 
 
 DateTime::operator std::string() const
 {
-	return stream2string(*this);
+	char buf[max_length];
+	return std::string(buf, format(buf));
 }
 
 
 Time::operator std::string() const
 {
-	return stream2string(*this);
+	char buf[max_length];
+	return std::string(buf, format(buf));
 }
 
 
 Date::operator time_t() const
 {
-	struct tm tm;
-	safe_localtime(&tm, time(0));
-
-	tm.tm_mday = day_;
-	tm.tm_mon = month_ - 1;
-	tm.tm_year = year_ - 1900;
-	tm.tm_isdst = -1;
-
-	return mktime(&tm);
+	DateTime now(time(0));
+	return join_time(year_, month_, day_, now.hour(), now.minute(),
+			now.second());
 }
 
 
@@ -292,32 +586,16 @@ DateTime::operator time_t() const
 		return time(0);
 	}
 	else {
-		struct tm tm;
-		tm.tm_sec = second_;
-		tm.tm_min = minute_;
-		tm.tm_hour = hour_;
-		tm.tm_mday = day_;
-		tm.tm_mon = month_ - 1;
-		tm.tm_year = year_ - 1900;
-		tm.tm_isdst = -1;
-
-		return mktime(&tm);
+		return join_time(year_, month_, day_, hour_, minute_, second_);
 	}
 }
 
 
 Time::operator time_t() const
 {
-	struct tm tm;
-	safe_localtime(&tm, time(0));
-
-	tm.tm_sec = second_;
-	tm.tm_min = minute_;
-	tm.tm_hour = hour_;
-	tm.tm_isdst = -1;
-
-	return mktime(&tm);
+	DateTime now(time(0));
+	return join_time(now.year(), now.month(), now.day(), hour_, minute_,
+			second_);
 }
 
 } // end namespace mysqlpp
-
@@ -57,6 +57,7 @@ public:
 	hour_(0),
 	minute_(0),
 	second_(0),
+	microsecond_(0),
 	now_(true)
 	{
 	}
@@ -69,8 +70,10 @@ public:
 	/// \param h hour, 0-23
 	/// \param min minute, 0-59
 	/// \param s second, 0-59
+	/// \param us fractional second in microseconds, 0-999999
 	DateTime(unsigned short y, unsigned char mon, unsigned char d,
-			unsigned char h, unsigned char min, unsigned char s) :
+			unsigned char h, unsigned char min, unsigned char s,
+			unsigned long us = 0) :
 	Comparable<DateTime>(),
 	year_(y),
 	month_(mon),
@@ -78,6 +81,7 @@ public:
 	hour_(h),
 	minute_(min),
 	second_(s),
+	microsecond_(us),
 	now_(false)
 	{
 	}
@@ -91,14 +95,31 @@ public:
 	hour_(other.hour_),
 	minute_(other.minute_),
 	second_(other.second_),
+	microsecond_(other.microsecond_),
 	now_(other.now_)
 	{
 	}
 
+	/// \brief Assign another DateTime's value to this object
+	DateTime& operator =(const DateTime& rhs)
+	{
+		year_ = rhs.year_;
+		month_ = rhs.month_;
+		day_ = rhs.day_;
+		hour_ = rhs.hour_;
+		minute_ = rhs.minute_;
+		second_ = rhs.second_;
+		microsecond_ = rhs.microsecond_;
+		now_ = rhs.now_;
+		return *this;
+	}
+
 	/// \brief Initialize object from a C string containing a SQL
 	/// date-and-time string
 	///
-	/// String must be in the HH:MM:SS format.  It doesn't have to be
+	/// String must be in the YYYY-MM-DD HH:MM:SS format, optionally
+	/// followed by a fraction of a second, as MySQL 5.6 and newer
+	/// send for DATETIME(N) columns.  It doesn't have to be
 	/// zero-padded.
 	explicit DateTime(const char* str) { convert(str); }
 	
@@ -116,6 +137,13 @@ public:
 	}
 
 	/// \brief Initialize object from a \c time_t
+	///
+	/// The value is converted to local time, as with localtime().
+	/// We cache the local time zone's offset from UTC for each day we
+	/// see, so converting many values from the same few days doesn't
+	/// go through the C library each time.  This means a program that
+	/// changes its time zone while running, with \c tzset(), may see
+	/// the old zone's rules for days it's already converted.
 	explicit DateTime(time_t t);
 
 	/// \brief Compare this object to another.
@@ -127,6 +155,15 @@ public:
 	/// \brief Parse a SQL date and time string into this object.
 	const char* convert(const char*);
 
+	/// \brief Write the value into a buffer in SQL format
+	///
+	/// This is what the stream inserter and SQLTypeAdapter use.  The
+	/// buffer must hold at least max_length characters.  No null
+	/// terminator is added.
+	///
+	/// \return the number of characters written
+	size_t format(char* buf) const;
+
 	/// \brief Get the date/time value's day part, 1-31
 	unsigned char day() const { return day_; }
 
@@ -143,6 +180,14 @@ public:
 	/// conversion to string.
 	bool is_now() const { return now_; }
 
+	/// \brief Get the date/time value's fractional second part, in
+	/// microseconds, 0-999999
+	unsigned long microsecond() const { return microsecond_; }
+
+	/// \brief Change the date/time value's fractional second part, in
+	/// microseconds, 0-999999
+	void microsecond(unsigned long us) { microsecond_ = us; now_ = false; }
+
 	/// \brief Get the date/time value's minute part, 0-59
 	unsigned char minute() const { return minute_; }
 
@@ -165,8 +210,30 @@ public:
 	operator std::string() const;
 
 	/// \brief Convert to time_t
+	///
+	/// Like the \c time_t ctor, this uses a cached UTC offset when it
+	/// can, and falls back on mktime() when it can't, such as on the
+	/// day of a daylight saving time change.  The fractional second
+	/// is dropped.
 	operator time_t() const;
 
+	/// \brief Return the value packed into a single integer
+	///
+	/// The fields are laid out most significant first, so packed
+	/// values sort in date/time order, and two values are the same
+	/// if their packed forms are.  This makes it a cheap sort or hash
+	/// key.  It is only exact if every field is within its normal
+	/// range, so the year must be at most 65535, the hour at most 23,
+	/// and the fractional part under a second; compare() doesn't have
+	/// this limitation.
+	ulonglong packed() const
+	{
+		return (ulonglong(year_) << 46) | (ulonglong(month_) << 42) |
+				(ulonglong(day_) << 37) | (ulonglong(hour_) << 32) |
+				(ulonglong(minute_) << 26) | (ulonglong(second_) << 20) |
+				ulonglong(microsecond_);
+	}
+
 	/// \brief Get the date/time value's second part, 0-59
 	unsigned char second() const { return second_; }
 
@@ -189,6 +256,10 @@ public:
 	/// subtracting 1900 like some other date/time implementations.
 	void year(unsigned short y) { year_ = y; now_ = false; }
 
+	/// \brief Size of buffer format() needs, even for out-of-range
+	/// field values
+	enum { max_length = 32 };
+
 private:
 	unsigned short year_;	///< the year, as a simple integer
 	unsigned char month_;	///< the month, 1-12
@@ -196,6 +267,7 @@ private:
 	unsigned char hour_;	///< the hour, 0-23 (not 0-255 as in Time!)
 	unsigned char minute_;	///< the minute, 0-59
 	unsigned char second_;	///< the second, 0-59
+	unsigned long microsecond_;	///< fractional second, 0-999999
 
 	bool now_;	///< true if object not initialized with explicit value
 };
@@ -250,6 +322,15 @@ public:
 	{
 	}
 
+	/// \brief Assign another Date's value to this object
+	Date& operator =(const Date& rhs)
+	{
+		year_ = rhs.year_;
+		month_ = rhs.month_;
+		day_ = rhs.day_;
+		return *this;
+	}
+
 	/// \brief Initialize object from date part of date/time object
 	Date(const DateTime& other) :
 	Comparable<Date>(),
@@ -289,6 +370,11 @@ public:
 	/// \brief Parse a SQL date string into this object.
 	const char* convert(const char*);
 
+	/// \brief Write the value into a buffer in SQL format
+	///
+	/// \sa DateTime::format()
+	size_t format(char* buf) const;
+
 	/// \brief Get the date's day part, 1-31
 	unsigned char day() const { return day_; }
 
@@ -309,6 +395,16 @@ public:
 	/// The "time" part of the \c time_t is "now"
 	operator time_t() const;
 
+	/// \brief Return the value packed into a single integer
+	///
+	/// Packed values sort in date order, and are equal only if the
+	/// dates are, so this makes a cheap sort or hash key.
+	unsigned long packed() const
+	{
+		return (static_cast<unsigned long>(year_) << 16) |
+				(static_cast<unsigned long>(month_) << 8) | day_;
+	}
+
 	/// \brief Return our value in std::string form
 	std::string str() const { return *this; }
 
@@ -324,6 +420,9 @@ public:
 	/// subtracting 1900 like some other date implementations.
 	void year(unsigned short y) { year_ = y; }
 
+	/// \brief Size of buffer format() needs
+	enum { max_length = 13 };
+
 private:
 	unsigned short year_;	///< the year, as a simple integer, 1000-9999
 	unsigned char month_;	///< the month, 1-12
@@ -348,16 +447,19 @@ class MYSQLPP_EXPORT Time : public Comparable<Time>
 {
 public:
 	/// \brief Default constructor
-	Time() : hour_(0), minute_(0), second_(0) { }
+	Time() : hour_(0), minute_(0), second_(0), microsecond_(0) { }
 
 	/// \brief Initialize object
 	/// \param h hour, 0-255 (yes, > 1 day is legal in SQL!)
 	/// \param m minute, 0-59
 	/// \param s second, 0-59
-	Time(unsigned char h, unsigned char m, unsigned char s) :
+	/// \param us fractional second in microseconds, 0-999999
+	Time(unsigned char h, unsigned char m, unsigned char s,
+			unsigned long us = 0) :
 	hour_(h),
 	minute_(m),
-	second_(s)
+	second_(s),
+	microsecond_(us)
 	{
 	}
 
@@ -366,8 +468,19 @@ public:
 	Comparable<Time>(),
 	hour_(other.hour_),
 	minute_(other.minute_),
-	second_(other.second_)
+	second_(other.second_),
+	microsecond_(other.microsecond_)
+	{
+	}
+
+	/// \brief Assign another Time's value to this object
+	Time& operator =(const Time& rhs)
 	{
+		hour_ = rhs.hour_;
+		minute_ = rhs.minute_;
+		second_ = rhs.second_;
+		microsecond_ = rhs.microsecond_;
+		return *this;
 	}
 
 	/// \brief Initialize object from time part of date/time object
@@ -375,15 +488,16 @@ public:
 	Comparable<Time>(),
 	hour_(other.hour()),
 	minute_(other.minute()),
-	second_(other.second())
+	second_(other.second()),
+	microsecond_(other.microsecond())
 	{
 	}
 
 	/// \brief Initialize object from a C string containing a SQL
 	/// time string
 	///
-	/// String must be in the HH:MM:SS format.  It doesn't have to be
-	/// zero-padded.
+	/// String must be in the HH:MM:SS format, optionally followed by
+	/// a fraction of a second.  It doesn't have to be zero-padded.
 	explicit Time(const char* str) { convert(str); }
 
 	/// \brief Initialize object from a C++ string containing a
@@ -411,6 +525,11 @@ public:
 	/// \brief Parse a SQL time string into this object.
 	const char* convert(const char*);
 
+	/// \brief Write the value into a buffer in SQL format
+	///
+	/// \sa DateTime::format()
+	size_t format(char* buf) const;
+
 	/// \brief Get the time's hour part, 0-255
 	unsigned char hour() const { return hour_; }
 
@@ -420,6 +539,14 @@ public:
 	/// \brief Get the time's minute part, 0-59
 	unsigned char minute() const { return minute_; }
 
+	/// \brief Get the time's fractional second part, in microseconds,
+	/// 0-999999
+	unsigned long microsecond() const { return microsecond_; }
+
+	/// \brief Change the time's fractional second part, in
+	/// microseconds, 0-999999
+	void microsecond(unsigned long us) { microsecond_ = us; }
+
 	/// \brief Change the time's minute part, 0-59
 	void minute(unsigned char m) { minute_ = m; }
 
@@ -431,6 +558,16 @@ public:
 	/// The "date" part of the \c time_t is "today"
 	operator time_t() const;
 
+	/// \brief Return the value packed into a single integer
+	///
+	/// Packed values sort in time order, and are equal only if the
+	/// times are, so this makes a cheap sort or hash key.
+	ulonglong packed() const
+	{
+		return (ulonglong(hour_) << 48) | (ulonglong(minute_) << 40) |
+				(ulonglong(second_) << 32) | ulonglong(microsecond_);
+	}
+
 	/// \brief Get the time's second part, 0-59
 	unsigned char second() const { return second_; }
 
@@ -440,16 +577,21 @@ public:
 	/// Return our value in std::string form
 	std::string str() const { return *this; }
 
+	/// \brief Size of buffer format() needs
+	enum { max_length = 18 };
+
 private:
 	unsigned char hour_;	///< the hour, 0-255 (yes, > 1 day is legal SQL!)
 	unsigned char minute_;	///< the minute, 0-59
 	unsigned char second_;	///< the second, 0-59
+	unsigned long microsecond_;	///< fractional second, 0-999999
 };
 
 /// \brief Inserts a Time object into a C++ stream in a SQL-compatible
 /// format.
 ///
-/// The format is HH:MM:SS, zero-padded.
+/// The format is HH:MM:SS, zero-padded, followed by the fraction of a
+/// second if it isn't zero.
 ///
 /// \param os stream to insert time into
 /// \param t time to insert into stream
@@ -27,6 +27,7 @@
 #include "dbdriver.h"
 
 #include "exceptions.h"
+#include "sql_escape.h"
 
 #include <cstring>
 #include <memory>
@@ -39,12 +40,18 @@
 #	define SHUTDOWN_ARG
 #endif
 
+// The wait_status values are the same as the C API's MYSQL_WAIT_*
+// flags, so the non-blocking wrappers pass them straight through.
+
 using namespace std;
 
 namespace mysqlpp {
 
 DBDriver::DBDriver() :
-is_connected_(false)
+is_connected_(false),
+nonblocking_(false),
+escape_charset_(0),
+escape_charset_safe_(false)
 {
 	// We won't allow calls to mysql_*() functions that take a MYSQL
 	// object until we get a connection up.  Such calls are nonsense.
@@ -54,7 +61,10 @@ is_connected_(false)
 
 
 DBDriver::DBDriver(const DBDriver& other) :
-is_connected_(false)
+is_connected_(false),
+nonblocking_(false),
+escape_charset_(0),
+escape_charset_safe_(false)
 {
 	copy(other);
 }
@@ -144,8 +154,14 @@ DBDriver::disconnect()
 		mysql_close(&mysql_);
 		memset(&mysql_, 0, sizeof(mysql_));
 		is_connected_ = false;
+		nonblocking_ = false;
 		error_message_.clear();
 	}
+
+	// The next server we talk to may not have the same tables, and
+	// won't know about our prepared statements
+	schema_cache_.clear();
+	statement_cache_.clear();
 }
 
 
@@ -167,6 +183,46 @@ DBDriver::enable_ssl(const char* key, const char* cert,
 }
 
 
+size_t
+DBDriver::escape_string(char* to, const char* from, size_t length)
+{
+	error_message_.clear();
+	if (escape_locally()) {
+		return internal::escape_sql(to, from, length);
+	}
+	else {
+		return mysql_real_escape_string(&mysql_, to, from,
+				static_cast<unsigned long>(length));
+	}
+}
+
+
+// Common implementation of the std::string escape_string() variants.
+// Text with nothing to escape is copied as is, or not at all when it's
+// already in *ps; otherwise it's escaped into a buffer that then takes
+// the place of *ps, so it needs only the one allocation.
+static size_t
+escape_into(std::string* ps, const char* original, size_t length,
+		DBDriver* driver)
+{
+	const char* end = original + length;
+	if (!driver && internal::find_escapable(original, end) == end) {
+		if (original != ps->data()) {
+			ps->assign(original, length);
+		}
+		return length;
+	}
+
+	string escaped(length * 2 + 1, '\0');
+	length = driver ?
+			driver->escape_string(&escaped[0], original, length) :
+			internal::escape_sql(&escaped[0], original, length);
+	escaped.resize(length);
+	ps->swap(escaped);
+	return length;
+}
+
+
 size_t
 DBDriver::escape_string(std::string* ps, const char* original,
 		size_t length)
@@ -190,12 +246,17 @@ DBDriver::escape_string(std::string* ps, const char* original,
 		length = strlen(original);
 	}
 
-	char* escaped = new char[length * 2 + 1];
-	length = escape_string(escaped, original, length);
-	ps->assign(escaped, length);
-	delete[] escaped;
+	// A null driver means "escape it the way we would ourselves"
+	return escape_into(ps, original, length, escape_locally() ? 0 : this);
+}
 
-	return length;
+
+size_t
+DBDriver::escape_string_no_conn(char* to, const char* from, size_t length)
+{
+	// mysql_escape_string() uses the client library's default
+	// character set, which is always one escape_sql() handles.
+	return internal::escape_sql(to, from, length);
 }
 
 
@@ -220,12 +281,98 @@ DBDriver::escape_string_no_conn(std::string* ps, const char* original,
 		length = strlen(original);
 	}
 
-	char* escaped = new char[length * 2 + 1];
-	length = DBDriver::escape_string_no_conn(escaped, original, length);
-	ps->assign(escaped, length);
-	delete[] escaped;
+	return escape_into(ps, original, length, 0);
+}
+
+
+bool
+DBDriver::escape_locally()
+{
+	if (!connected()) {
+		// Nothing to ask, so escape as escape_string_no_conn() would
+		return true;
+	}
+	else if (mysql_.server_status & SERVER_STATUS_NO_BACKSLASH_ESCAPES) {
+		// The C API doubles quote characters instead in this mode
+		return false;
+	}
+
+	// The C API gives the same pointer for as long as the connection's
+	// character set stays the same, so this only looks the name up in
+	// our list when it changes.
+	const char* charset = character_set_name();
+	if (charset != escape_charset_) {
+		escape_charset_ = charset;
+		escape_charset_safe_ = internal::escape_sql_safe(charset);
+	}
+	return escape_charset_safe_;
+}
+
 
-	return length;
+int
+DBDriver::execute_start(bool& ok, const char* qstr, size_t length)
+{
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	if (nonblocking_) {
+		error_message_.clear();
+		int err = 0;
+		const int status = mysql_real_query_start(&err, &mysql_, qstr,
+				static_cast<unsigned long>(length));
+		ok = !err;
+		return status;
+	}
+#endif
+
+	ok = execute(qstr, length);
+	return 0;
+}
+
+
+int
+DBDriver::execute_cont(bool& ok, int status)
+{
+	error_message_.clear();
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	int err = 0;
+	status = mysql_real_query_cont(&err, &mysql_, status);
+	ok = !err;
+	return status;
+#else
+	// execute_start() always completes without one
+	(void)status;
+	ok = false;
+	return 0;
+#endif
+}
+
+
+int
+DBDriver::fetch_row_start(MYSQL_ROW& row, MYSQL_RES* res)
+{
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	if (nonblocking_) {
+		error_message_.clear();
+		return mysql_fetch_row_start(&row, res);
+	}
+#endif
+
+	row = fetch_row(res);
+	return 0;
+}
+
+
+int
+DBDriver::fetch_row_cont(MYSQL_ROW& row, MYSQL_RES* res, int status)
+{
+	error_message_.clear();
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	return mysql_fetch_row_cont(&row, res, status);
+#else
+	(void)res;
+	(void)status;
+	row = 0;
+	return 0;
+#endif
 }
 
 
@@ -246,6 +393,19 @@ DBDriver::query_info()
 }
 
 
+bool
+DBDriver::set_nonblocking()
+{
+	error_message_.clear();
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	if (!nonblocking_) {
+		nonblocking_ = mysql_options(&mysql_, MYSQL_OPT_NONBLOCK, 0) == 0;
+	}
+#endif
+	return nonblocking_;
+}
+
+
 bool
 DBDriver::set_option(unsigned int o, bool arg)
 {
@@ -339,6 +499,47 @@ DBDriver::shutdown()
 }
 
 
+int
+DBDriver::socket()
+{
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	if (nonblocking_) {
+		return static_cast<int>(mysql_get_socket(&mysql_));
+	}
+#endif
+	return -1;
+}
+
+
+int
+DBDriver::store_result_start(MYSQL_RES*& res)
+{
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	if (nonblocking_) {
+		error_message_.clear();
+		return mysql_store_result_start(&res, &mysql_);
+	}
+#endif
+
+	res = store_result();
+	return 0;
+}
+
+
+int
+DBDriver::store_result_cont(MYSQL_RES*& res, int status)
+{
+	error_message_.clear();
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	return mysql_store_result_cont(&res, &mysql_, status);
+#else
+	(void)status;
+	res = 0;
+	return 0;
+#endif
+}
+
+
 bool
 DBDriver::thread_aware()
 {
@@ -353,5 +554,17 @@ DBDriver::thread_aware()
 #endif
 }
 
+
+unsigned int
+DBDriver::timeout_ms()
+{
+#if defined(HAVE_MYSQL_NONBLOCKING)
+	if (nonblocking_) {
+		return mysql_get_timeout_value_ms(&mysql_);
+	}
+#endif
+	return 0;
+}
+
 } // end namespace mysqlpp
 
@@ -31,6 +31,8 @@
 #include "common.h"
 
 #include "options.h"
+#include "schema_cache.h"
+#include "statement_cache.h"
 
 #include <typeinfo>
 
@@ -65,6 +67,17 @@ public:
 		nr_not_supported	///< this C API doesn't support "next result"
 	};
 
+	/// \brief What a non-blocking call needs before it can go on
+	///
+	/// The *_start() and *_cont() functions return a combination of
+	/// these flags, or 0 once the call is complete.
+	enum wait_status {
+		wait_read = 1,		///< wait for socket() to be readable
+		wait_write = 2,		///< wait for socket() to be writable
+		wait_except = 4,	///< wait for an exceptional condition on socket()
+		wait_timeout = 8	///< wait for timeout_ms() to pass
+	};
+
 	/// \brief Create object
 	DBDriver();
 
@@ -88,6 +101,15 @@ public:
 		return mysql_affected_rows(&mysql_);
 	}
 
+	/// \brief Get the name of the character set the connection uses
+	///
+	/// Wraps \c mysql_character_set_name() in the MySQL C API.
+	const char* character_set_name()
+	{
+		error_message_.clear();
+		return mysql_character_set_name(&mysql_);
+	}
+
 	/// \brief Get database client library version
 	///
 	/// Wraps \c mysql_get_client_info() in the MySQL C API.
@@ -201,19 +223,19 @@ public:
 	///
 	/// \retval number of characters placed in escaped
 	///
-	/// Wraps \c mysql_real_escape_string() in the MySQL C API.
+	/// Gives the same result as \c mysql_real_escape_string() in the
+	/// MySQL C API.  For the common character sets, including UTF-8
+	/// and Latin-1, MySQL++ does the escaping itself, copying runs of
+	/// text that need no escaping in one go.  Other character sets,
+	/// and servers in \c NO_BACKSLASH_ESCAPES mode, are left to the C
+	/// API.
 	///
 	/// Proper SQL escaping takes the database's current character set 
 	/// into account, however if a database connection isn't available
 	/// DBDriver also provides a static version of this same method.
 	///
 	/// \sa escape_string_no_conn(char*, const char*, size_t)
-	size_t escape_string(char* to, const char* from, size_t length)
-	{
-		error_message_.clear();
-		return mysql_real_escape_string(&mysql_, to, from, 
-				static_cast<unsigned long>(length));
-	}
+	size_t escape_string(char* to, const char* from, size_t length);
 
 	/// \brief Return a SQL-escaped version of a character buffer
 	///
@@ -260,15 +282,12 @@ public:
 	/// \brief SQL-escapes the given string without reference to the 
 	/// character set of a database server.
 	///
-	/// Wraps \c mysql_escape_string() in the MySQL C API.
+	/// Gives the same result as \c mysql_escape_string() in the MySQL
+	/// C API, without calling it.
 	///
 	/// \sa escape_string(char*, const char*, size_t)
 	static size_t escape_string_no_conn(char* to, const char* from,
-			size_t length)
-	{
-		return mysql_escape_string(to, from,
-				static_cast<unsigned long>(length));
-	}
+			size_t length);
 
 	/// \brief SQL-escapes the given string without reference to the 
 	/// character set of a database server.
@@ -288,6 +307,26 @@ public:
 				static_cast<unsigned long>(length));
 	}
 
+	/// \brief Start executing a query without waiting on the network
+	///
+	/// Call execute_cont() until the return value is 0; \c ok then
+	/// says whether the query succeeded, as execute()'s return value
+	/// would have.
+	///
+	/// \return wait_status flags, or 0 if the call is complete
+	///
+	/// Wraps \c mysql_real_query_start() in the MariaDB C API.  On a
+	/// connection that isn't nonblocking(), this just calls execute().
+	int execute_start(bool& ok, const char* qstr, size_t length);
+
+	/// \brief Go on with a query begun by execute_start()
+	///
+	/// \param ok set to whether the query succeeded, once complete
+	/// \param status the wait_status flags that are now satisfied
+	///
+	/// Wraps \c mysql_real_query_cont() in the MariaDB C API.
+	int execute_cont(bool& ok, int status);
+
 	/// \brief Returns the next raw C API row structure from the given
 	/// result set.
 	///
@@ -301,6 +340,20 @@ public:
 		return mysql_fetch_row(res);
 	}
 
+	/// \brief Start fetching the next row of a "use" query's result
+	/// set without waiting on the network
+	///
+	/// Works like execute_start(), with \c row getting what
+	/// fetch_row() would have returned once the call is complete.
+	///
+	/// Wraps \c mysql_fetch_row_start() in the MariaDB C API.
+	int fetch_row_start(MYSQL_ROW& row, MYSQL_RES* res);
+
+	/// \brief Go on with a fetch begun by fetch_row_start()
+	///
+	/// Wraps \c mysql_fetch_row_cont() in the MariaDB C API.
+	int fetch_row_cont(MYSQL_ROW& row, MYSQL_RES* res, int status);
+
 	/// \brief Returns the lengths of the fields in the current row
 	/// from a "use" query.
 	///
@@ -332,6 +385,15 @@ public:
 				static_cast<unsigned int>(i));
 	}
 
+	/// \brief Returns information about all the fields in a result set
+	///
+	/// Wraps \c mysql_fetch_fields() in MySQL C API.
+	MYSQL_FIELD* fetch_fields(MYSQL_RES* res) const
+	{
+		error_message_.clear();
+		return mysql_fetch_fields(res);
+	}
+
 	/// \brief Jumps to the given field within the result set
 	///
 	/// Wraps \c mysql_field_seek() in MySQL C API.
@@ -432,6 +494,9 @@ public:
 		#endif
 	}
 
+	/// \brief Returns true if set_nonblocking() has taken effect
+	bool nonblocking() const { return nonblocking_; }
+
 	/// \brief Returns the number of fields in the given result set
 	///
 	/// Wraps \c mysql_num_fields() in MySQL C API.
@@ -505,6 +570,12 @@ public:
 		return mysql_field_count(&mysql_) == 0;
 	}
 
+	/// \brief Get the cache of column descriptions that result sets
+	/// from this connection share
+	///
+	/// \sa SchemaCache
+	SchemaCache& schema_cache() { return schema_cache_; }
+
 	/// \brief Asks the database server to switch to a different database
 	bool select_db(const char* db)
 	{
@@ -521,6 +592,48 @@ public:
 		return mysql_get_server_info(&mysql_);
 	}
 
+	/// \brief Go back to reading the data for LOAD DATA LOCAL INFILE
+	/// from the named file
+	///
+	/// Wraps \c mysql_set_local_infile_default() in the MySQL C API.
+	void set_local_infile_default()
+	{
+		mysql_set_local_infile_default(&mysql_);
+	}
+
+	/// \brief Supply the data for LOAD DATA LOCAL INFILE through
+	/// callbacks instead of from a file
+	///
+	/// The callbacks are used for every such statement until you call
+	/// set_local_infile_default().  BulkLoader uses this to stream rows
+	/// to the server as they're generated.
+	///
+	/// Wraps \c mysql_set_local_infile_handler() in the MySQL C API;
+	/// see its documentation for what the callbacks must do.
+	void set_local_infile_handler(
+			int (*init)(void**, const char*, void*),
+			int (*read)(void*, char*, unsigned int),
+			void (*end)(void*),
+			int (*error)(void*, char*, unsigned int),
+			void* userdata)
+	{
+		mysql_set_local_infile_handler(&mysql_, init, read, end, error,
+				userdata);
+	}
+
+	/// \brief Let the *_start() and *_cont() functions return when they
+	/// would otherwise wait on the network
+	///
+	/// This only works with a C API library that has MariaDB's
+	/// non-blocking interface.  Without one, the *_start() functions
+	/// do the whole job before returning, so code written for them
+	/// still works, just without any concurrency.
+	///
+	/// Wraps \c mysql_options(MYSQL_OPT_NONBLOCK) in the MariaDB C API.
+	///
+	/// \retval true if the connection is now non-blocking
+	bool set_nonblocking();
+
 	/// \brief Sets a connection option
 	///
 	/// This is the database-independent high-level option setting
@@ -597,6 +710,174 @@ public:
 		return mysql_stat(&mysql_);
 	}
 
+	/// \brief Get the connection's network socket
+	///
+	/// This is what to wait on when a non-blocking call returns
+	/// wait_read, wait_write or wait_except.
+	///
+	/// Wraps \c mysql_get_socket() in the MariaDB C API.  Returns -1
+	/// on a connection that isn't nonblocking().
+	int socket();
+
+	/// \brief Get the cache of statements prepared on this connection
+	///
+	/// \sa StatementCache
+	StatementCache& statement_cache() { return statement_cache_; }
+
+	/// \brief Creates a new prepared statement handle on this
+	/// connection
+	///
+	/// The caller owns the handle, and must pass it to
+	/// \c mysql_stmt_close() when done with it.  PreparedQuery is the
+	/// high-level interface to this.
+	///
+	/// Wraps \c mysql_stmt_init() in the MySQL C API.
+	MYSQL_STMT* stmt_init()
+	{
+		error_message_.clear();
+		return mysql_stmt_init(&mysql_);
+	}
+
+	/// \brief Returns the number of rows a prepared statement changed,
+	/// deleted or inserted
+	///
+	/// Wraps \c mysql_stmt_affected_rows() in the MySQL C API.
+	ulonglong stmt_affected_rows(MYSQL_STMT* stmt) const
+	{
+		return mysql_stmt_affected_rows(stmt);
+	}
+
+	/// \brief Hands the given parameter list to a prepared statement
+	///
+	/// Wraps \c mysql_stmt_bind_param() in the MySQL C API.
+	bool stmt_bind_param(MYSQL_STMT* stmt, MYSQL_BIND* binds) const
+	{
+		error_message_.clear();
+		return !mysql_stmt_bind_param(stmt, binds);
+	}
+
+	/// \brief Tells a prepared statement where to put each column of
+	/// the rows it fetches
+	///
+	/// Wraps \c mysql_stmt_bind_result() in the MySQL C API.
+	bool stmt_bind_result(MYSQL_STMT* stmt, MYSQL_BIND* binds) const
+	{
+		error_message_.clear();
+		return !mysql_stmt_bind_result(stmt, binds);
+	}
+
+	/// \brief Returns the error number for the last call on a
+	/// prepared statement
+	///
+	/// Wraps \c mysql_stmt_errno() in the MySQL C API.
+	int stmt_errnum(MYSQL_STMT* stmt) const
+	{
+		return mysql_stmt_errno(stmt);
+	}
+
+	/// \brief Returns the error message for the last call on a
+	/// prepared statement
+	///
+	/// Wraps \c mysql_stmt_error() in the MySQL C API.
+	const char* stmt_error(MYSQL_STMT* stmt) const
+	{
+		return mysql_stmt_error(stmt);
+	}
+
+	/// \brief Executes a prepared statement
+	///
+	/// Wraps \c mysql_stmt_execute() in the MySQL C API.
+	bool stmt_execute(MYSQL_STMT* stmt) const
+	{
+		error_message_.clear();
+		return !mysql_stmt_execute(stmt);
+	}
+
+	/// \brief Fetches the next row of a prepared statement's result
+	/// set into the buffers given to stmt_bind_result()
+	///
+	/// \return 0 on success, \c MYSQL_NO_DATA at the end of the
+	/// result set, \c MYSQL_DATA_TRUNCATED if some value didn't fit
+	/// its buffer, or 1 on error
+	///
+	/// Wraps \c mysql_stmt_fetch() in the MySQL C API.
+	int stmt_fetch(MYSQL_STMT* stmt) const
+	{
+		error_message_.clear();
+		return mysql_stmt_fetch(stmt);
+	}
+
+	/// \brief Fetches one column of the current row of a prepared
+	/// statement's result set again, into the given buffer
+	///
+	/// Wraps \c mysql_stmt_fetch_column() in the MySQL C API.
+	bool stmt_fetch_column(MYSQL_STMT* stmt, MYSQL_BIND* bind,
+			unsigned int column, unsigned long offset) const
+	{
+		error_message_.clear();
+		return !mysql_stmt_fetch_column(stmt, bind, column, offset);
+	}
+
+	/// \brief Returns the ID the last prepared statement execution
+	/// generated for an AUTO_INCREMENT column
+	///
+	/// Wraps \c mysql_stmt_insert_id() in the MySQL C API.
+	ulonglong stmt_insert_id(MYSQL_STMT* stmt) const
+	{
+		return mysql_stmt_insert_id(stmt);
+	}
+
+	/// \brief Returns the number of rows in a prepared statement's
+	/// stored result set
+	///
+	/// Wraps \c mysql_stmt_num_rows() in the MySQL C API.
+	ulonglong stmt_num_rows(MYSQL_STMT* stmt) const
+	{
+		return mysql_stmt_num_rows(stmt);
+	}
+
+	/// \brief Returns the number of parameters in a prepared statement
+	///
+	/// Wraps \c mysql_stmt_param_count() in the MySQL C API.
+	unsigned long stmt_param_count(MYSQL_STMT* stmt) const
+	{
+		return mysql_stmt_param_count(stmt);
+	}
+
+	/// \brief Has the server prepare the given SQL on a statement
+	/// handle from stmt_init()
+	///
+	/// Wraps \c mysql_stmt_prepare() in the MySQL C API.
+	bool stmt_prepare(MYSQL_STMT* stmt, const char* qstr,
+			size_t length) const
+	{
+		error_message_.clear();
+		return !mysql_stmt_prepare(stmt, qstr,
+				static_cast<unsigned long>(length));
+	}
+
+	/// \brief Returns descriptions of a prepared statement's result
+	/// columns, or 0 if it has none
+	///
+	/// Pass the returned result set to free_result() when done with it.
+	///
+	/// Wraps \c mysql_stmt_result_metadata() in the MySQL C API.
+	MYSQL_RES* stmt_result_metadata(MYSQL_STMT* stmt) const
+	{
+		error_message_.clear();
+		return mysql_stmt_result_metadata(stmt);
+	}
+
+	/// \brief Reads a prepared statement's whole result set into
+	/// client memory
+	///
+	/// Wraps \c mysql_stmt_store_result() in the MySQL C API.
+	bool stmt_store_result(MYSQL_STMT* stmt) const
+	{
+		error_message_.clear();
+		return !mysql_stmt_store_result(stmt);
+	}
+
 	/// \brief Saves the results of the query just execute()d in memory
 	/// and returns a pointer to the MySQL C API data structure the
 	/// results are stored in.
@@ -610,6 +891,20 @@ public:
 		return mysql_store_result(&mysql_);
 	}
 
+	/// \brief Start saving a query's results in memory without
+	/// waiting on the network
+	///
+	/// Works like execute_start(), with \c res getting what
+	/// store_result() would have returned once the call is complete.
+	///
+	/// Wraps \c mysql_store_result_start() in the MariaDB C API.
+	int store_result_start(MYSQL_RES*& res);
+
+	/// \brief Go on with a call begun by store_result_start()
+	///
+	/// Wraps \c mysql_store_result_cont() in the MariaDB C API.
+	int store_result_cont(MYSQL_RES*& res, int status);
+
 	/// \brief Returns true if MySQL++ and the underlying MySQL C API
 	/// library were both compiled with thread awareness.
 	///
@@ -671,6 +966,12 @@ public:
 		#endif
 	}
 
+	/// \brief Get how long to wait before calling a *_cont() function
+	/// when a non-blocking call returns wait_timeout
+	///
+	/// Wraps \c mysql_get_timeout_value_ms() in the MariaDB C API.
+	unsigned int timeout_ms();
+
 	/// \brief Returns a result set from the last-executed query which
 	/// we can walk through in linear fashion, which doesn't store all
 	/// result sets in memory.
@@ -693,6 +994,10 @@ protected:
 	/// delayed option setting code in connect_prepare()
 	bool set_option_impl(Option* o);
 
+	/// \brief Returns true if escape_string() can do the escaping
+	/// itself instead of calling the C API
+	bool escape_locally();
+
 private:
 	/// \brief Data type of the list of applied connection options
 	typedef std::deque<Option*> OptionList;
@@ -706,9 +1011,14 @@ private:
 
 	MYSQL mysql_;
 	bool is_connected_;
+	bool nonblocking_;
 	OptionList applied_options_;
 	OptionList pending_options_;
 	mutable std::string error_message_;
+	const char* escape_charset_;	///< charset escape_locally() last saw
+	bool escape_charset_safe_;		///< ...and whether it's one we handle
+	SchemaCache schema_cache_;
+	StatementCache statement_cache_;
 };
 
 
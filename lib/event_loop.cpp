@@ -0,0 +1,422 @@
+/***********************************************************************
+ event_loop.cpp - Implements the EventLoop class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#define MYSQLPP_NOT_HEADER
+#include "common.h"
+
+#include "event_loop.h"
+
+#include "bulk_insert.h"
+#include "connection.h"
+#include "dbdriver.h"
+#include "exceptions.h"
+
+#include <algorithm>
+
+// Queries only run concurrently if we can both start them without
+// blocking and wait on many sockets at once.
+#if defined(HAVE_MYSQL_NONBLOCKING) && defined(HAVE_SYS_EPOLL_H)
+#	define MYSQLPP_EVENT_LOOP_EPOLL
+#	include <sys/epoll.h>
+#	include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace mysqlpp {
+
+// The kinds of query an Op can be
+enum { exec_op, store_op, use_op };
+
+// How many epoll events run_once() takes at a time.  Any more stay
+// ready, so the next call gets them.
+static const int max_events = 64;
+
+
+struct EventLoop::Op
+{
+	// Where the query is up to
+	enum Stage { querying, storing, fetching };
+
+	Op(Connection& c, const std::string& s, AsyncHandler& h, int k) :
+	conn(&c),
+	driver(c.driver()),
+	handler(&h),
+	sql(s),
+	kind(k),
+	stage(querying),
+	started(false),
+	status(0),
+	deadline(0),
+	watched(0),
+	fd(-1)
+	{
+	}
+
+	Connection* conn;
+	DBDriver* driver;
+	AsyncHandler* handler;
+	std::string sql;
+	int kind;					// exec_op, store_op or use_op
+	Stage stage;
+	bool started;				// has the stage's *_start() been called?
+	int status;					// what the stage is waiting for, or 0
+	double deadline;			// when a wait_timeout expires, or 0
+	int watched;				// epoll events registered for fd
+	int fd;						// the connection's socket
+	UseQueryResult use_result;	// result set a use_op is reading
+};
+
+
+EventLoop::EventLoop() :
+OptionalExceptions(),
+epoll_fd_(-1)
+{
+#if defined(MYSQLPP_EVENT_LOOP_EPOLL)
+	// The size is only a hint, which newer kernels ignore
+	epoll_fd_ = epoll_create(max_events);
+#endif
+}
+
+
+EventLoop::~EventLoop()
+{
+	for (size_t i = 0; i < ops_.size(); ++i) {
+		delete ops_[i];
+	}
+
+#if defined(MYSQLPP_EVENT_LOOP_EPOLL)
+	if (epoll_fd_ >= 0) {
+		close(epoll_fd_);
+	}
+#endif
+}
+
+
+bool
+EventLoop::advance(Op* op, int ready)
+{
+	DBDriver* driver = op->driver;
+	for (;;) {
+		bool ok = true;
+		MYSQL_RES* res = 0;
+		MYSQL_ROW row = 0;
+
+		switch (op->stage) {
+			case Op::querying:
+				op->status = op->started ? driver->execute_cont(ok, ready) :
+						driver->execute_start(ok, op->sql.data(),
+							op->sql.length());
+				break;
+
+			case Op::storing:
+				op->status = op->started ?
+						driver->store_result_cont(res, ready) :
+						driver->store_result_start(res);
+				break;
+
+			case Op::fetching:
+				op->status = op->started ?
+						driver->fetch_row_cont(row, op->use_result, ready) :
+						driver->fetch_row_start(row, op->use_result);
+				break;
+		}
+
+		op->started = true;
+		if (op->status) {
+			watch(op);
+			return false;
+		}
+
+		// The call is complete, so act on its result, and start the
+		// next one if there is one
+		ready = 0;
+		op->started = false;
+		switch (op->stage) {
+			case Op::querying:
+				if (!ok) {
+					finish(op, false);
+					return true;
+				}
+				else if (op->kind == exec_op) {
+					finish(op, true);
+					return true;
+				}
+				else if (op->kind == store_op) {
+					op->stage = Op::storing;
+				}
+				else if (MYSQL_RES* r = driver->use_result()) {
+					op->use_result = UseQueryResult(r, driver, false);
+					op->stage = Op::fetching;
+				}
+				else {
+					// Error, or a query that returns no rows at all
+					finish(op, op->conn->errnum() == 0);
+					return true;
+				}
+				break;
+
+			case Op::storing:
+				if (res) {
+					finish(op, true, StoreQueryResult(res, driver, false));
+				}
+				else {
+					// Error, or a query that returns no rows at all
+					finish(op, op->conn->errnum() == 0);
+				}
+				return true;
+
+			case Op::fetching:
+				if (row) {
+					const unsigned long* lengths =
+							driver->fetch_lengths(op->use_result);
+					op->handler->row(*op->conn,
+							Row(row, &op->use_result, lengths, false));
+				}
+				else {
+					finish(op, op->conn->errnum() == 0);
+					return true;
+				}
+				break;
+		}
+	}
+}
+
+
+bool
+EventLoop::busy(const Connection& conn) const
+{
+	for (size_t i = 0; i < ops_.size(); ++i) {
+		if (ops_[i]->conn == &conn) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+bool
+EventLoop::concurrent() const
+{
+	return epoll_fd_ >= 0;
+}
+
+
+bool
+EventLoop::execute(Connection& conn, const std::string& sql,
+		AsyncHandler& handler)
+{
+	return start(conn, sql, handler, exec_op);
+}
+
+
+void
+EventLoop::finish(Op* op, bool ok, const StoreQueryResult& rows)
+{
+#if defined(MYSQLPP_EVENT_LOOP_EPOLL)
+	if (op->watched) {
+		epoll_event ev = { 0, { 0 } };
+		epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, op->fd, &ev);
+	}
+#endif
+
+	// Take the query out of the loop before calling the handler, so it
+	// can start another on the same connection, or throw.
+	ops_.erase(std::find(ops_.begin(), ops_.end(), op));
+	Connection& conn = *op->conn;
+	AsyncHandler* handler = op->handler;
+	const int kind = op->kind;
+	delete op;
+
+	if (!ok) {
+		handler->failed(conn, conn.errnum(), conn.error());
+	}
+	else if (kind == exec_op) {
+		DBDriver* driver = conn.driver();
+		handler->executed(conn, SimpleResult(true, driver->insert_id(),
+				driver->affected_rows(), driver->query_info()));
+	}
+	else if (kind == store_op) {
+		handler->stored(conn, rows);
+	}
+	else {
+		handler->used(conn);
+	}
+}
+
+
+size_t
+EventLoop::run_once(int timeout_ms)
+{
+	size_t done = 0;
+
+	// Queries just started, or put off by a handler throwing, can go
+	// on without waiting for anything.
+	std::vector<Op*> runnable;
+	for (size_t i = 0; i < ops_.size(); ++i) {
+		if (ops_[i]->status == 0) {
+			runnable.push_back(ops_[i]);
+		}
+	}
+	for (size_t i = 0; i < runnable.size(); ++i) {
+		done += advance(runnable[i], 0);
+	}
+	if (done || ops_.empty()) {
+		return done;
+	}
+
+#if defined(MYSQLPP_EVENT_LOOP_EPOLL)
+	// Don't sleep past the soonest C API timeout
+	const double now = internal::stats_clock();
+	for (size_t i = 0; i < ops_.size(); ++i) {
+		if (ops_[i]->deadline) {
+			const int left = ops_[i]->deadline > now ?
+					int((ops_[i]->deadline - now) * 1000) + 1 : 0;
+			if (timeout_ms < 0 || left < timeout_ms) {
+				timeout_ms = left;
+			}
+		}
+	}
+
+	// Each query is only in the epoll set once, and finishing one
+	// doesn't touch any other, so the list stays good as we go.
+	epoll_event events[max_events];
+	const int n = epoll_wait(epoll_fd_, events, max_events, timeout_ms);
+	for (int i = 0; i < n; ++i) {
+		int ready = 0;
+		if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+			ready |= DBDriver::wait_read;
+		}
+		if (events[i].events & EPOLLOUT) {
+			ready |= DBDriver::wait_write;
+		}
+		if (events[i].events & EPOLLPRI) {
+			ready |= DBDriver::wait_except;
+		}
+		done += advance(static_cast<Op*>(events[i].data.ptr), ready);
+	}
+
+	// Anything whose timeout has passed gets to find that out
+	std::vector<Op*> expired;
+	const double later = internal::stats_clock();
+	for (size_t i = 0; i < ops_.size(); ++i) {
+		if (ops_[i]->deadline && ops_[i]->deadline <= later) {
+			expired.push_back(ops_[i]);
+		}
+	}
+	for (size_t i = 0; i < expired.size(); ++i) {
+		done += advance(expired[i], DBDriver::wait_timeout);
+	}
+#else
+	(void)timeout_ms;
+#endif
+
+	return done;
+}
+
+
+void
+EventLoop::run()
+{
+	while (!ops_.empty()) {
+		run_once();
+	}
+}
+
+
+bool
+EventLoop::start(Connection& conn, const std::string& sql,
+		AsyncHandler& handler, int kind)
+{
+	if (!conn.connected()) {
+		error_ = "Can't start a query on a connection that isn't up";
+	}
+	else if (busy(conn)) {
+		error_ = "Connection already has a query in flight";
+	}
+	else {
+		Op* op = new Op(conn, sql, handler, kind);
+		if (concurrent() && op->driver->set_nonblocking()) {
+			op->fd = op->driver->socket();
+		}
+		ops_.push_back(op);
+		error_.clear();
+		return true;
+	}
+
+	if (throw_exceptions()) {
+		throw BadQuery(error_);
+	}
+	return false;
+}
+
+
+bool
+EventLoop::store(Connection& conn, const std::string& sql,
+		AsyncHandler& handler)
+{
+	return start(conn, sql, handler, store_op);
+}
+
+
+bool
+EventLoop::use(Connection& conn, const std::string& sql,
+		AsyncHandler& handler)
+{
+	return start(conn, sql, handler, use_op);
+}
+
+
+void
+EventLoop::watch(Op* op)
+{
+	op->deadline = (op->status & DBDriver::wait_timeout) ?
+			internal::stats_clock() + op->driver->timeout_ms() / 1000.0 :
+			0;
+
+#if defined(MYSQLPP_EVENT_LOOP_EPOLL)
+	int events = 0;
+	if (op->status & DBDriver::wait_read) {
+		events |= EPOLLIN;
+	}
+	if (op->status & DBDriver::wait_write) {
+		events |= EPOLLOUT;
+	}
+	if (op->status & DBDriver::wait_except) {
+		events |= EPOLLPRI;
+	}
+
+	if (events != op->watched) {
+		epoll_event ev;
+		ev.events = events;
+		ev.data.ptr = op;
+		epoll_ctl(epoll_fd_, !op->watched ? EPOLL_CTL_ADD :
+				events ? EPOLL_CTL_MOD : EPOLL_CTL_DEL, op->fd, &ev);
+		op->watched = events;
+	}
+#endif
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,294 @@
+/// \file event_loop.h
+/// \brief Declares the EventLoop class, which runs queries on many
+/// connections at once from a single thread.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_EVENT_LOOP_H)
+#define MYSQLPP_EVENT_LOOP_H
+
+#include "common.h"
+
+#include "noexceptions.h"
+#include "result.h"
+#include "row.h"
+
+#include <string>
+#include <vector>
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Make Doxygen ignore this
+class MYSQLPP_EXPORT Connection;
+#endif
+
+/// \brief Receives the results of queries run by an EventLoop
+///
+/// Derive from this and override the functions for the kinds of query
+/// you start.  EventLoop calls them from within run_once(), never from
+/// the functions that start a query, so a handler is free to start
+/// another query, even on the same connection.
+///
+/// AsyncResult is a ready-made handler that just holds on to the
+/// outcome, for code that would rather poll than be called back.
+
+class MYSQLPP_EXPORT AsyncHandler
+{
+public:
+	/// \brief Destroy object
+	virtual ~AsyncHandler() { }
+
+	/// \brief Called when a query started by EventLoop::execute()
+	/// succeeds
+	virtual void executed(Connection& /* conn */,
+			const SimpleResult& /* result */) { }
+
+	/// \brief Called when a query started by EventLoop::store()
+	/// succeeds
+	///
+	/// For a query that doesn't return rows, \c result is empty.
+	virtual void stored(Connection& /* conn */,
+			const StoreQueryResult& /* result */) { }
+
+	/// \brief Called for each row of a query started by
+	/// EventLoop::use()
+	virtual void row(Connection& /* conn */, const Row& /* row */) { }
+
+	/// \brief Called after the last row of a query started by
+	/// EventLoop::use()
+	virtual void used(Connection& /* conn */) { }
+
+	/// \brief Called when a query fails, in place of the functions
+	/// above
+	///
+	/// The arguments are the connection the query ran on, and the
+	/// error number and message from the C API.
+	virtual void failed(Connection& /* conn */, int /* errnum */,
+			const char* /* error */) { }
+};
+
+
+/// \brief An AsyncHandler that holds on to the outcome of a query, for
+/// polling
+///
+/// \code
+/// mysqlpp::AsyncResult a, b;
+/// loop.store(conn1, "SELECT * FROM stock", a);
+/// loop.store(conn2, "SELECT * FROM images", b);
+/// loop.run();
+/// if (a.succeeded()) print(a.rows());
+/// \endcode
+///
+/// Rows from a use() query aren't kept; override row() for those.
+
+class MYSQLPP_EXPORT AsyncResult : public AsyncHandler
+{
+public:
+	/// \brief Create an object that hasn't received an outcome yet
+	AsyncResult() :
+	ready_(false),
+	succeeded_(false),
+	errnum_(0)
+	{
+	}
+
+	/// \brief Returns true once the query is done, either way
+	bool ready() const { return ready_; }
+
+	/// \brief Returns true if the query is done and succeeded
+	bool succeeded() const { return succeeded_; }
+
+	/// \brief Get the result of an execute() query
+	const SimpleResult& result() const { return result_; }
+
+	/// \brief Get the result set of a store() query
+	const StoreQueryResult& rows() const { return rows_; }
+
+	/// \brief Get the error number, if the query failed
+	int errnum() const { return errnum_; }
+
+	/// \brief Get the error message, if the query failed
+	const std::string& error() const { return error_; }
+
+	/// \brief Forget the outcome, so the object can be used again
+	void reset() { *this = AsyncResult(); }
+
+	void executed(Connection&, const SimpleResult& result)
+	{
+		result_ = result;
+		ready_ = succeeded_ = true;
+	}
+
+	void stored(Connection&, const StoreQueryResult& result)
+	{
+		rows_ = result;
+		ready_ = succeeded_ = true;
+	}
+
+	void used(Connection&) { ready_ = succeeded_ = true; }
+
+	void failed(Connection&, int errnum, const char* error)
+	{
+		errnum_ = errnum;
+		error_ = error;
+		ready_ = true;
+	}
+
+private:
+	bool ready_;
+	bool succeeded_;
+	SimpleResult result_;
+	StoreQueryResult rows_;
+	int errnum_;
+	std::string error_;
+};
+
+
+/// \brief Runs queries on many connections at once from one thread
+///
+/// Normally each query blocks the calling thread until the server
+/// answers, so keeping many queries in flight takes as many threads.
+/// This class instead starts each query and moves on, using the
+/// non-blocking interface of MariaDB's C API library and, on Linux,
+/// epoll to find out which connections the server has answered.  One
+/// thread can keep hundreds of queries going this way, one per
+/// connection.
+///
+/// \code
+/// mysqlpp::EventLoop loop;
+/// std::vector<mysqlpp::AsyncResult> results(conns.size());
+/// for (size_t i = 0; i < conns.size(); ++i) {
+///     loop.store(conns[i], queries[i], results[i]);
+/// }
+/// loop.run();		// returns when all of them are done
+/// \endcode
+///
+/// The connections must already be connected; connecting still
+/// blocks.  Each can run only one query at a time, and must outlive
+/// its query, as must the handler.
+///
+/// Without the non-blocking C API or epoll, each query runs to
+/// completion inside run_once() instead, one after the other.
+/// Programs work the same either way, just without the concurrency;
+/// concurrent() tells which you have.
+
+class MYSQLPP_EXPORT EventLoop : public OptionalExceptions
+{
+public:
+	/// \brief Create an object with no queries in flight
+	EventLoop();
+
+	/// \brief Destroy object
+	///
+	/// Run any queries in flight to completion first.  The C API
+	/// can't abandon a query part way, so a connection left with one
+	/// isn't good for anything but closing.
+	~EventLoop();
+
+	/// \brief Returns true if queries really do run concurrently
+	bool concurrent() const;
+
+	/// \brief Start a query that doesn't return rows
+	///
+	/// The handler's executed() or failed() is called once it's done.
+	///
+	/// \retval false if the query couldn't be started, because the
+	/// connection is down or busy, and exceptions are disabled
+	bool execute(Connection& conn, const std::string& sql,
+			AsyncHandler& handler);
+
+	/// \brief Start a query, saving all of its results in memory
+	///
+	/// The handler's stored() or failed() is called once it's done.
+	bool store(Connection& conn, const std::string& sql,
+			AsyncHandler& handler);
+
+	/// \brief Start a query, handing its rows over as they arrive
+	///
+	/// The handler's row() is called for each row, and then used() or
+	/// failed().
+	bool use(Connection& conn, const std::string& sql,
+			AsyncHandler& handler);
+
+	/// \brief Returns true if a query is in flight on the connection
+	bool busy(const Connection& conn) const;
+
+	/// \brief Get the reason the last query couldn't be started
+	const char* error() const { return error_.c_str(); }
+
+	/// \brief Returns the number of queries in flight
+	size_t pending() const { return ops_.size(); }
+
+	/// \brief Wait for and handle whatever the server has answered
+	///
+	/// Handlers are called from here.  An exception a handler throws
+	/// comes out of this function; the other queries carry on with
+	/// the next call.
+	///
+	/// \param timeout_ms longest to wait for something to happen, in
+	/// milliseconds; -1 means no limit
+	///
+	/// \return number of queries that finished
+	size_t run_once(int timeout_ms = -1);
+
+	/// \brief Call run_once() until no queries are in flight
+	void run();
+
+private:
+	/// \brief One query in flight
+	struct Op;
+
+	/// \brief Hidden copy constructor and assignment operator; a loop
+	/// owns its queries, so there's no sensible way to copy one
+	EventLoop(const EventLoop&);
+	EventLoop& operator=(const EventLoop&);
+
+	/// \brief Common part of execute(), store() and use()
+	bool start(Connection& conn, const std::string& sql,
+			AsyncHandler& handler, int kind);
+
+	/// \brief Move a query on as far as it'll go without waiting
+	///
+	/// \param ready the wait_status flags now satisfied
+	///
+	/// \retval true if the query finished
+	bool advance(Op* op, int ready);
+
+	/// \brief Take a finished query out of the loop, and tell its
+	/// handler the outcome
+	void finish(Op* op, bool ok,
+			const StoreQueryResult& rows = StoreQueryResult());
+
+	/// \brief Tell epoll what a query is now waiting for
+	void watch(Op* op);
+
+	std::vector<Op*> ops_;		///< queries in flight
+	std::string error_;			///< why the last start() failed
+	int epoll_fd_;				///< the epoll instance, or -1
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_EVENT_LOOP_H)
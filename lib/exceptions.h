@@ -451,7 +451,8 @@ public:
 ///
 /// Thrown by Query::insertfrom() if it is unable to add VALUES
 /// to an empty query.  This means the size threshold or max packet
-/// size of the policy is set too small.
+/// size of the policy is set too small.  BulkInsert throws it when a
+/// row won't fit in an INSERT statement on its own.
 
 class MYSQLPP_EXPORT BadInsertPolicy : public Exception
 {
@@ -464,6 +465,40 @@ public:
 };
 
 
+/// \brief Exception thrown when a result set won't fit in the memory
+/// budget set for it
+///
+/// Thrown by Query::store() and store_next() when the result set grows
+/// past the limit set with Query::store_budget() or
+/// Connection::store_budget().
+
+class MYSQLPP_EXPORT ResultTooLarge : public Exception
+{
+public:
+	/// \brief Create exception object
+	///
+	/// \param budget the limit that was exceeded, in bytes
+	explicit ResultTooLarge(size_t budget) :
+	Exception(),
+	budget_(budget)
+	{
+		std::ostringstream outs;
+		outs << "Result set exceeds memory budget of " << budget <<
+				" bytes";
+		what_ = outs.str();
+	}
+
+	/// \brief Destroy exception
+	~ResultTooLarge() throw() { }
+
+	/// \brief Return the memory budget that was exceeded, in bytes
+	size_t budget() const { return budget_; }
+
+private:
+	size_t budget_;
+};
+
+
 } // end namespace mysqlpp
 
 #endif // !defined(MYSQLPP_EXCEPTIONS_H)
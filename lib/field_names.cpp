@@ -30,33 +30,112 @@
 #include "field_names.h"
 #include "result.h"
 
-#include <algorithm>
+#include <ctype.h>
+#include <string.h>
 
 namespace mysqlpp {
 
-namespace internal { extern void str_to_lwr(std::string& s); }
+// Case-insensitive hash of a field name.  This is 32-bit FNV-1a, run
+// over the lowercased bytes of the name.
+static unsigned int
+hash_name(const char* name, size_t length)
+{
+	unsigned int h = 2166136261U;
+	for (size_t i = 0; i < length; ++i) {
+		h ^= static_cast<unsigned char>(tolower(
+				static_cast<unsigned char>(name[i])));
+		h *= 16777619U;
+	}
+	return h;
+}
+
+
+// Case-insensitive comparison of a field name to a std::string
+static bool
+same_name(const char* name, size_t length, const std::string& other)
+{
+	if (length != other.length()) {
+		return false;
+	}
+	for (size_t i = 0; i < length; ++i) {
+		if (tolower(static_cast<unsigned char>(name[i])) !=
+				tolower(static_cast<unsigned char>(other[i]))) {
+			return false;
+		}
+	}
+	return true;
+}
+
 
 void
 FieldNames::init(const ResultBase* res)
 {
-	size_t num = res->num_fields();
-	reserve(num);
+	init(res->fields());
+}
+
+
+void
+FieldNames::init(const Fields& fields)
+{
+	reserve(fields.size());
+
+	for (Fields::const_iterator it = fields.begin();
+			it != fields.end(); ++it) {
+		push_back(it->name());
+	}
 
-	for (size_t i = 0; i < num; i++) {
-		push_back(res->fields().at(i).name());
+	build_index();
+}
+
+
+void
+FieldNames::build_index()
+{
+	// Size the table so it's never more than half full, which keeps
+	// the probe sequences short.
+	size_t slots = 4;
+	while (slots < size() * 2) {
+		slots *= 2;
+	}
+	index_.assign(slots, 0);
+
+	const size_t mask = slots - 1;
+	for (size_t i = 0; i < size(); ++i) {
+		const std::string& name = at(i);
+		size_t slot = hash_name(name.data(), name.length()) & mask;
+		while (index_[slot]) {
+			if (same_name(name.data(), name.length(),
+					at(index_[slot] - 1))) {
+				break;	// duplicate name; first one wins, as before
+			}
+			slot = (slot + 1) & mask;
+		}
+		if (!index_[slot]) {
+			index_[slot] = static_cast<unsigned int>(i + 1);
+		}
 	}
 }
 
 
 unsigned int
-FieldNames::operator [](const std::string& s) const
+FieldNames::find(const char* name, size_t length) const
 {
-	std::string temp1(s);
-	internal::str_to_lwr(temp1);
+	if (!index_.empty()) {
+		const size_t mask = index_.size() - 1;
+		size_t slot = hash_name(name, length) & mask;
+		while (unsigned int entry = index_[slot]) {
+			if ((entry <= size()) && same_name(name, length,
+					at(entry - 1))) {
+				return entry - 1;
+			}
+			slot = (slot + 1) & mask;
+		}
+	}
+
+	// Not in the index.  Either there's no such field, or the list has
+	// been changed since the index was built, so search the hard way.
 	for (const_iterator it = begin(); it != end(); ++it) {
-	std::string temp2(*it);
-		internal::str_to_lwr(temp2);
-		if (temp2.compare(temp1) == 0) {
+		if (same_name(name, length, *it)) {
 			return it - begin();
 		}
 	}
@@ -64,4 +143,38 @@ FieldNames::operator [](const std::string& s) const
 	return end() - begin();
 }
 
+
+unsigned int
+FieldNames::operator [](const char* s) const
+{
+	return find(s, strlen(s));
+}
+
+
+size_t
+FieldNames::bytes_used() const
+{
+	size_t bytes = sizeof(*this) + capacity() * sizeof(value_type) +
+			index_.capacity() * sizeof(unsigned int);
+	for (const_iterator it = begin(); it != end(); ++it) {
+		bytes += it->capacity() + 1;
+	}
+	return bytes;
+}
+
+
+unsigned int
+ColumnRef::index(const RefCountedPointer<FieldNames>& names) const
+{
+	if (!names) {
+		return 0;
+	}
+	else if (names.raw() != names_.raw()) {
+		index_ = (*names)[name_];
+		names_ = names;
+	}
+
+	return index_;
+}
+
 } // end namespace mysqlpp
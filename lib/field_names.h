@@ -28,6 +28,11 @@
 #ifndef MYSQLPP_FIELD_NAMES_H
 #define MYSQLPP_FIELD_NAMES_H
 
+#include "common.h"
+
+#include "field.h"
+#include "refcounted.h"
+
 #include <string>
 #include <vector>
 
@@ -39,7 +44,15 @@ class MYSQLPP_EXPORT ResultBase;
 #endif
 
 /// \brief Holds a list of SQL field names
-class FieldNames : public std::vector<std::string>
+///
+/// When created from a result set, this also builds a hash index of
+/// the names, so looking up a field's index by name doesn't have to
+/// compare the name against every field in the result set.  Lookups
+/// are case-insensitive, and don't allocate any memory.  Since a
+/// result set's Row objects all share a single FieldNames object,
+/// the index is built just once per result set.
+class FieldNames : public std::vector<std::string>,
+		public RefCounted
 {
 public:
 	/// \brief Default constructor
@@ -47,7 +60,9 @@ public:
 
 	/// \brief Copy constructor
 	FieldNames(const FieldNames& other) :
-	std::vector<std::string>()
+	std::vector<std::string>(),
+	RefCounted(),
+	index_(other.index_)
 	{
 		assign(other.begin(), other.end());
 	}
@@ -59,6 +74,13 @@ public:
 		init(res);
 	}
 
+	/// \brief Create field name list from a list of field descriptions
+	FieldNames(const Fields& fields) :
+	std::vector<std::string>()
+	{
+		init(fields);
+	}
+
 	/// \brief Create empty field name list, reserving space for
 	/// a fixed number of field names.
 	FieldNames(int i) :
@@ -66,6 +88,10 @@ public:
 	{
 	}
 
+	/// \brief Return the number of heap bytes this object uses,
+	/// including itself
+	size_t bytes_used() const;
+
 	/// \brief Initializes the field list from a result set
 	FieldNames& operator =(const ResultBase* res)
 	{
@@ -107,10 +133,95 @@ public:
 	}
 
 	/// \brief Get the index number of a field given its name
-	unsigned int operator [](const std::string& s) const;
+	///
+	/// Returns size() if there is no such field.
+	unsigned int operator [](const std::string& s) const
+			{ return find(s.data(), s.length()); }
+
+	/// \brief Get the index number of a field given its name, as a
+	/// C string
+	///
+	/// Returns size() if there is no such field.
+	unsigned int operator [](const char* s) const;
 
 private:
+	/// \brief Look up a field name in the hash index
+	///
+	/// If the index is missing or doesn't find the name -- either
+	/// of which can happen if someone changed the list through the
+	/// std::vector interface -- we fall back to a linear search, so
+	/// the result is always correct.
+	unsigned int find(const char* name, size_t length) const;
+
+	/// \brief Build the hash index from the current list of names
+	void build_index();
+
 	void init(const ResultBase* res);
+	void init(const Fields& fields);
+
+	/// \brief Hash table of field indices, plus 1; 0 marks an empty
+	/// slot.  Its size is always 0 or a power of 2.
+	std::vector<unsigned int> index_;
+};
+
+
+/// \brief A handle to a named column, resolved to an index once per
+/// result set
+///
+/// Looking a field up by name, as with \c row["price"], has to hash
+/// the name and probe the result set's field name index on every
+/// call.  That's cheap, but in a loop over a big result set it's
+/// entirely wasted effort, since the answer is the same for every row.
+/// A ColumnRef remembers the answer for the last result set it saw,
+/// so you only pay for the lookup once per result set:
+///
+/// \code
+///   mysqlpp::ColumnRef price("price");
+///   for (size_t i = 0; i < res.num_rows(); ++i) {
+///       total += double(res[i][price]);
+///   }
+/// \endcode
+///
+/// A ColumnRef can be used with rows from any number of result sets;
+/// it just looks the name up again whenever it sees a row from a
+/// different one.  It's not safe to share a ColumnRef among threads
+/// without locking, since using it changes it.
+class MYSQLPP_EXPORT ColumnRef
+{
+public:
+	/// \brief Create a handle for the given field name
+	ColumnRef(const char* name) :
+	name_(name),
+	index_(0)
+	{
+	}
+
+	/// \brief Create a handle for the given field name
+	ColumnRef(const std::string& name) :
+	name_(name),
+	index_(0)
+	{
+	}
+
+	/// \brief Return the field name this handle refers to
+	const std::string& name() const { return name_; }
+
+	/// \brief Return the index of our field within the given list of
+	/// field names, or its size() if the field isn't in it
+	unsigned int index(const RefCountedPointer<FieldNames>& names) const;
+
+private:
+	std::string name_;	///< the field name we look up
+
+	/// \brief The field name list we last looked our name up in
+	///
+	/// We hold a reference to it, rather than just a pointer, so it
+	/// can't be freed and another list allocated at the same address,
+	/// making our cached index bogus.
+	mutable RefCountedPointer<FieldNames> names_;
+
+	/// \brief Our field's index within names_
+	mutable unsigned int index_;
 };
 
 } // end namespace mysqlpp
@@ -35,10 +35,16 @@ namespace mysqlpp {
 
 void FieldTypes::init(const ResultBase* res)
 {
-	size_t num = res->num_fields();
-	reserve(num);
-	for (size_t i = 0; i < num; i++) {
-		push_back(res->field(unsigned(i)).type());
+	init(res->fields());
+}
+
+
+void FieldTypes::init(const Fields& fields)
+{
+	reserve(fields.size());
+	for (Fields::const_iterator it = fields.begin();
+			it != fields.end(); ++it) {
+		push_back(it->type());
 	}
 }
 
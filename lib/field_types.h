@@ -28,6 +28,8 @@
 #ifndef MYSQLPP_FIELD_TYPES_H
 #define MYSQLPP_FIELD_TYPES_H
 
+#include "field.h"
+#include "refcounted.h"
 #include "type_info.h"
 
 #include <vector>
@@ -40,7 +42,8 @@ class MYSQLPP_EXPORT ResultBase;
 #endif
 
 /// \brief A vector of SQL field types.
-class FieldTypes : public std::vector<mysql_type_info>
+class FieldTypes : public std::vector<mysql_type_info>,
+		public RefCounted
 {
 public:
 	/// \brief Default constructor
@@ -52,6 +55,13 @@ public:
 		init(res);
 	}
 
+	/// \brief Create list of field types from a list of field
+	/// descriptions
+	FieldTypes(const Fields& fields)
+	{
+		init(fields);
+	}
+
 	/// \brief Create fixed-size list of uninitialized field types
 	FieldTypes(int i) :
 	std::vector<mysql_type_info>(i)
@@ -77,6 +87,7 @@ public:
 
 private:
 	void init(const ResultBase* res);
+	void init(const Fields& fields);
 };
 
 } // end namespace mysqlpp
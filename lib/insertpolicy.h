@@ -161,6 +161,10 @@ private:
 /// This differs from the SizeThresholdInsertPolicy in that it builds
 /// the VALUES expression and checks whether it would cause the
 /// length of the INSERT statement to exceed the maximum size.
+///
+/// Query::insertfrom() builds each row's VALUES expression a second
+/// time to add it to the statement.  For large loads, BulkInsert does
+/// the same job building each one only once.
 template <class AccessController = Transaction>
 class MYSQLPP_EXPORT MaxPacketInsertPolicy
 {
@@ -171,7 +175,7 @@ public:
 	/// \param size the maximum allowed size for an INSERT
 	///     statement
 	MaxPacketInsertPolicy(Connection* con, int size) :
-	conn_(con), size_(size)
+	conn_(con), size_(size), row_(con)
 	{
 	}
 
@@ -184,7 +188,7 @@ public:
 	/// \param size the maximum allowed size for an INSERT
 	///     statement
 	MaxPacketInsertPolicy(int size) :
-	conn_(0), size_(size)
+	conn_(0), size_(size), row_(0)
 	{
 	}
 
@@ -203,10 +207,12 @@ public:
 	{
 		if (size < size_) {
 			// Haven't hit size threshold yet, so see if this next
-			// item pushes it over the line.
-			SQLStream s(conn_);
-			s << ",(" << object.value_list() << ")";
-			return (size_ - size) >= static_cast<int>(s.str().size());
+			// item pushes it over the line.  Reuse one stream for
+			// this, so we don't pay for setting one up on every row.
+			row_.writer().clear();
+			row_ << ",(" << object.value_list() << ")";
+			return (size_ - size) >=
+					static_cast<int>(row_.writer().length());
 		}
 		else {
 			// Already too much in query buffer!
@@ -220,6 +226,7 @@ public:
 private:
 	Connection* conn_;
 	int size_;
+	mutable SQLStream row_;
 };
 
 #endif // defined(MYSQLPP_DEFINE_INSERT_POLICY_TEMPLATES)
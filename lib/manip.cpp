@@ -28,12 +28,44 @@
 #include "manip.h"
 
 #include "query.h"
+#include "sql_escape.h"
 #include "sqlstream.h"
 
 using namespace std;
 
 namespace mysqlpp {
 
+// If the stream is a Query or SQLStream in a good state, return the
+// buffer it builds its SQL in, and set driver to the DBDriver it
+// escapes text with.  Otherwise, return 0.  This runs for each value
+// inserted with a manipulator, so it goes by the mark those classes
+// put on themselves instead of trying dynamic_cast on each of them.
+static SQLWriter*
+sql_writer(std::ostream& os, DBDriver*& driver)
+{
+	if (!os.good()) {
+		return 0;
+	}
+
+	switch (internal::sql_sink(os)) {
+		case internal::query_sink: {
+			Query& q = static_cast<Query&>(os);
+			driver = q.escape_driver();
+			return &q.writer();
+		}
+
+		case internal::sqlstream_sink: {
+			SQLStream& s = static_cast<SQLStream&>(os);
+			driver = s.escape_driver();
+			return &s.writer();
+		}
+
+		default:
+			return 0;
+	}
+}
+
+
 SQLQueryParms&
 operator <<(quote_type2 p, SQLTypeAdapter& in)
 {
@@ -55,34 +87,25 @@ operator <<(quote_type2 p, SQLTypeAdapter& in)
 ostream&
 operator <<(quote_type1 o, const SQLTypeAdapter& in)
 {
-	Query* pq = dynamic_cast<Query*>(o.ostr);
-
-	// If it's not a Query*, maybe it's a SQLStream*.
-	SQLStream* psqls = pq ? 0 : dynamic_cast<SQLStream*>(o.ostr);
-
-	// If it's a Query or a SQLStream, we'll be using unformatted output.
-	if (pq || psqls) {
-		if (in.quote_q()) o.ostr->put('\'');
-
-		// Now, is escaping appropriate for source data type of 'in'?
-		if (in.escape_q()) {
-			string escaped;
+	DBDriver* driver;
+	if (SQLWriter* w = sql_writer(*o.ostr, driver)) {
+		// It's a Query or a SQLStream, so quote and escape the data
+		// straight into its buffer, as far as its type calls for.
+		if (in.quote_q() && in.escape_q()) {
+			w->append_quoted(in.data(), in.length(), driver);
+		}
+		else {
+			if (in.quote_q()) w->append('\'');
 
-			// If it's not a Query*, then it has to be a SQLStream.
-			if (pq) {
-				pq->escape_string(&escaped, in.data(), in.length());
+			if (in.escape_q()) {
+				w->append_escaped(in.data(), in.length(), driver);
 			}
 			else {
-				psqls->escape_string(&escaped, in.data(), in.length());
+				w->append(in.data(), in.length());
 			}
 
-			o.ostr->write(escaped.data(), escaped.length());
-		}
-		else {
-			o.ostr->write(in.data(), in.length());
+			if (in.quote_q()) w->append('\'');
 		}
-
-		if (in.quote_q()) o.ostr->put('\'');
 	}
 	else {
 		// Some other stream type, so use formatted output.  User
@@ -98,18 +121,14 @@ operator <<(quote_type1 o, const SQLTypeAdapter& in)
 ostream&
 operator <<(quote_only_type1 o, const SQLTypeAdapter& in)
 {
-	Query* pq = dynamic_cast<Query*>(o.ostr);
-
-	// If it's not a Query*, maybe it's a SQLStream*.
-	SQLStream* psqls = pq ? 0 : dynamic_cast<SQLStream*>(o.ostr);
+	DBDriver* driver;
+	if (SQLWriter* w = sql_writer(*o.ostr, driver)) {
+		// It's a Query or SQLStream, so write straight into its buffer
+		if (in.quote_q()) w->append('\'');
 
-	// If it's a Query or SQLStream, use unformatted output
-	if (pq || psqls) {
-		if (in.quote_q()) o.ostr->put('\'');
+		w->append(in.data(), in.length());
 
-		o.ostr->write(in.data(), in.length());
-
-		if (in.quote_q()) o.ostr->put('\'');
+		if (in.quote_q()) w->append('\'');
 	}
 	else {
 		// Some other stream type, so use formatted output.  User
@@ -125,9 +144,11 @@ operator <<(quote_only_type1 o, const SQLTypeAdapter& in)
 ostream&
 operator <<(ostream& o, const SQLTypeAdapter& in)
 {
-	if (dynamic_cast<Query*>(&o) || dynamic_cast<SQLStream*>(&o)) {
+	DBDriver* driver;
+	if (SQLWriter* w = sql_writer(o, driver)) {
 		// It's a Query or a SQLStream, so use unformatted output.
-		return o.write(in.data(), in.length());
+		w->append(in.data(), in.length());
+		return o;
 	}
 	else {
 		// Some other stream type, so use formatted output.  We do this
@@ -172,18 +193,14 @@ operator <<(quote_double_only_type2 p, SQLTypeAdapter& in)
 ostream&
 operator <<(quote_double_only_type1 o, const SQLTypeAdapter& in)
 {
-	Query* pq = dynamic_cast<Query*>(o.ostr);
-
-	// If it's not a Query*, maybe it's a SQLStream*.
-	SQLStream* psqls = pq ? 0 : dynamic_cast<SQLStream*>(o.ostr);
-
-	// If it's a Query or a SQLStream, use unformatted output
-	if (pq || psqls) {
-		if (in.quote_q()) o.ostr->put('"');
+	DBDriver* driver;
+	if (SQLWriter* w = sql_writer(*o.ostr, driver)) {
+		// It's a Query or SQLStream, so write straight into its buffer
+		if (in.quote_q()) w->append('"');
 
-		o.ostr->write(in.data(), in.length());
+		w->append(in.data(), in.length());
 	
-		if (in.quote_q()) o.ostr->put('"');
+		if (in.quote_q()) w->append('"');
 	}
 	else {
 		// Some other stream type, so use formatted output.  User
@@ -215,31 +232,17 @@ operator <<(escape_type2 p, SQLTypeAdapter& in)
 ostream&
 operator <<(escape_type1 o, const SQLTypeAdapter& in)
 {
-	Query* pq = dynamic_cast<Query*>(o.ostr);
-
-	// If it's not a Query*, maybe it's a SQLStream*.
-	SQLStream* psqls = pq ? 0 : dynamic_cast<SQLStream*>(o.ostr);
-
-	if (pq || psqls) {
-		// It's a Query or a SQLStream, so we'll be using unformatted output.
-		// Now, is escaping appropriate for source data type of 'in'?
+	DBDriver* driver;
+	if (SQLWriter* w = sql_writer(*o.ostr, driver)) {
+		// It's a Query or a SQLStream, so escape straight into its
+		// buffer, if escaping is appropriate for the data type of 'in'.
 		if (in.escape_q()) {
-			string escaped;
-
-			// If it's not a Query*, then it has to be a SQLStream.
-			if (pq) {
-				pq->escape_string(&escaped, in.data(), in.length());
-			}
-			else {
-				psqls->escape_string(&escaped, in.data(), in.length());
-			}
-
-			return o.ostr->write(escaped.data(), escaped.length());
+			w->append_escaped(in.data(), in.length(), driver);
 		}
 		else {
-			// It's not escaped, so just write the unformatted output
-			return o.ostr->write(in.data(), in.length());
+			w->append(in.data(), in.length());
 		}
+		return *o.ostr;
 	}
 	else {
 		// Some other stream type, so use formatted output.  User
@@ -250,6 +253,33 @@ operator <<(escape_type1 o, const SQLTypeAdapter& in)
 }
 
 
+ostream&
+operator <<(tsv_type1 o, const SQLTypeAdapter& in)
+{
+	if (in.is_null()) {
+		return *o.ostr << "\\N";
+	}
+
+	DBDriver* driver;
+	if (SQLWriter* w = sql_writer(*o.ostr, driver)) {
+		// It's a Query or a SQLStream, so escape straight into its
+		// buffer.  Unlike SQL escaping, this doesn't depend on the
+		// data type, since LOAD DATA gives backslash the same meaning
+		// in every field.
+		w->append_tsv(in.data(), in.length());
+		return *o.ostr;
+	}
+	else {
+		// Some other stream type, so escape into a temporary.  This
+		// format is useful outside SQL, so we do the whole job here.
+		string temp(in.length() * 2 + 1, '\0');
+		temp.resize(internal::escape_tsv(&temp[0], in.data(),
+				in.length()));
+		return *o.ostr << temp;
+	}
+}
+
+
 SQLQueryParms&
 operator <<(do_nothing_type2 p, SQLTypeAdapter& in)
 {
@@ -261,9 +291,11 @@ operator <<(do_nothing_type2 p, SQLTypeAdapter& in)
 ostream&
 operator <<(do_nothing_type1 o, const SQLTypeAdapter& in)
 {
-	if (dynamic_cast<Query*>(o.ostr) || dynamic_cast<SQLStream*>(o.ostr)) {
+	DBDriver* driver;
+	if (SQLWriter* w = sql_writer(*o.ostr, driver)) {
 		// It's a Query or a SQLStream, so use unformatted output
-		return o.ostr->write(in.data(), in.length());
+		w->append(in.data(), in.length());
+		return *o.ostr;
 	}
 	else {
 		// Some other stream type, so use formatted output.  User
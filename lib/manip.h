@@ -373,6 +373,57 @@ MYSQLPP_EXPORT std::ostream&
 operator <<(escape_type1 o, const SQLTypeAdapter& in);
 
 
+/// \enum tsv_type0
+/// \anchor tsv_manip
+///
+/// The 'tsv' manipulator.
+///
+/// Writes the following argument as a field in the tab-separated
+/// format LOAD DATA reads by default: backslash, tab, newline,
+/// carriage return and nul get a backslash escape, and SQL null
+/// becomes \c \\N.  Use it in your own tsv_row() functions for
+/// BulkLoader.
+
+enum tsv_type0
+{
+	tsv						///< insert into a std::ostream to write next item as a LOAD DATA field
+};
+
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+
+struct tsv_type1
+{
+	std::ostream* ostr;
+	tsv_type1(std::ostream* o) :
+	ostr(o)
+	{
+	}
+};
+
+
+inline tsv_type1
+operator <<(std::ostream& o, tsv_type0 /* esc */)
+{
+	return tsv_type1(&o);
+}
+
+
+MYSQLPP_EXPORT std::ostream&
+operator <<(tsv_type1 o, const SQLTypeAdapter& in);
+
+
+template <class ST>
+inline std::ostream&
+operator <<(tsv_type1 o, const Set<ST>& in)
+{
+	return *o.ostr << in;
+}
+
+#endif // !defined(DOXYGEN_IGNORE)
+
+
 /// \enum do_nothing_type0
 /// \anchor do_nothing_manip
 ///
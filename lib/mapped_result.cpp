@@ -0,0 +1,405 @@
+/***********************************************************************
+ mapped_result.cpp - Implements the MappedResult class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "mapped_result.h"
+
+#include "dbdriver.h"
+#include "exceptions.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+namespace mysqlpp {
+
+// The temporary file holds each row's fields in order, each as an
+// 8-byte length in native byte order followed by the data and a null
+// terminator.  A SQL null is just this length value, with no data.
+// The length is 64 bits even where the C API's lengths are 32, so the
+// format doesn't depend on them, and LONGBLOB values of 4 GiB or more
+// don't collide with it.
+// After the rows comes the table of row offsets, aligned for ulonglong
+// access.  The file only lives as long as this process, so there's no
+// need for a portable format.
+static const ulonglong null_length = ~ulonglong(0);
+
+// Most rows have few enough fields that we can unpack them without
+// touching the heap.
+static const size_t small_row = 32;
+
+
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+typedef HANDLE file_handle;
+static const file_handle no_file = INVALID_HANDLE_VALUE;
+#else
+typedef int file_handle;
+static const file_handle no_file = -1;
+#endif
+
+
+// Return the reason the last platform file operation failed
+static std::string
+last_error()
+{
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+	char buf[256];
+	if (FormatMessageA(FORMAT_MESSAGE_FROM_SYSTEM |
+			FORMAT_MESSAGE_IGNORE_INSERTS, 0, GetLastError(), 0, buf,
+			sizeof(buf), 0)) {
+		return buf;
+	}
+	else {
+		return "unknown error";
+	}
+#else
+	return strerror(errno);
+#endif
+}
+
+
+// Create a temporary file in dir that will be deleted when closed
+static file_handle
+create_temp_file(const char* dir)
+{
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+	char tmpdir[MAX_PATH], path[MAX_PATH];
+	if (!dir) {
+		if (!GetTempPathA(sizeof(tmpdir), tmpdir)) {
+			return no_file;
+		}
+		dir = tmpdir;
+	}
+	if (!GetTempFileNameA(dir, "mpp", 0, path)) {
+		return no_file;
+	}
+	return CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, 0,
+			CREATE_ALWAYS,
+			FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, 0);
+#else
+	if (!dir && !(dir = getenv("TMPDIR"))) {
+		dir = "/tmp";
+	}
+	std::string tmpl(dir);
+	tmpl += "/mysqlpp-XXXXXX";
+	std::vector<char> path(tmpl.begin(), tmpl.end());
+	path.push_back('\0');
+
+	file_handle fh = mkstemp(&path[0]);
+	if (fh != no_file) {
+		// Nothing else needs the name, so drop it now.  The file
+		// itself lives on until we close it and unmap it.
+		unlink(&path[0]);
+	}
+	return fh;
+#endif
+}
+
+
+// Write all of a block of data to a file
+static bool
+write_all(file_handle fh, const char* data, size_t length)
+{
+	while (length > 0) {
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+		DWORD chunk = length > 0x40000000 ? 0x40000000 : DWORD(length);
+		DWORD written;
+		if (!WriteFile(fh, data, chunk, &written, 0)) {
+			return false;
+		}
+#else
+		ssize_t written = write(fh, data, length);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+#endif
+		data += written;
+		length -= size_t(written);
+	}
+	return true;
+}
+
+
+// Map a whole file into memory, read-only
+static char*
+map_file(file_handle fh, size_t length)
+{
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+	ulonglong len = length;
+	HANDLE mapping = CreateFileMappingA(fh, 0, PAGE_READONLY,
+			DWORD(len >> 32), DWORD(len & 0xFFFFFFFFU), 0);
+	if (!mapping) {
+		return 0;
+	}
+	// The view keeps the mapping object alive on its own
+	void* p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, length);
+	CloseHandle(mapping);
+	return static_cast<char*>(p);
+#else
+	void* p = mmap(0, length, PROT_READ, MAP_SHARED, fh, 0);
+	return p == MAP_FAILED ? 0 : static_cast<char*>(p);
+#endif
+}
+
+
+// Unmap a file mapped by map_file(); CellArena calls this when the
+// last String pointing into the file goes away.
+static void
+unmap_file(char* block, size_t length)
+{
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+	(void)length;
+	UnmapViewOfFile(block);
+#else
+	munmap(block, length);
+#endif
+}
+
+
+static void
+close_file(file_handle fh)
+{
+#if defined(MYSQLPP_PLATFORM_WINDOWS)
+	CloseHandle(fh);
+#else
+	close(fh);
+#endif
+}
+
+
+// Buffers writes to the temporary file, keeping track of where we are
+// in it.  The first failure sticks, so callers can check once at the
+// end.
+class spill_writer
+{
+public:
+	explicit spill_writer(file_handle fh) :
+	fh_(fh),
+	offset_(0),
+	ok_(true)
+	{
+		buffer_.reserve(buffer_size);
+	}
+
+	bool flush()
+	{
+		if (ok_ && !buffer_.empty()) {
+			ok_ = write_all(fh_, &buffer_[0], buffer_.size());
+		}
+		buffer_.clear();
+		return ok_;
+	}
+
+	ulonglong offset() const { return offset_; }
+
+	void put(const void* data, size_t length)
+	{
+		const char* p = static_cast<const char*>(data);
+		if (buffer_.size() + length > buffer_size) {
+			flush();
+			if (length > buffer_size) {
+				ok_ = ok_ && write_all(fh_, p, length);
+				offset_ += length;
+				return;
+			}
+		}
+		buffer_.insert(buffer_.end(), p, p + length);
+		offset_ += length;
+	}
+
+private:
+	enum { buffer_size = 64 * 1024 };
+
+	file_handle fh_;
+	std::vector<char> buffer_;
+	ulonglong offset_;
+	bool ok_;
+};
+
+
+MappedResult::MappedResult(MYSQL_RES* res, DBDriver* dbd, bool te,
+		const char* dir) :
+ResultBase(res, dbd, te),
+base_(0),
+index_(0),
+rows_(0),
+file_size_(0),
+copacetic_(false)
+{
+	if (res && dbd) {
+		spill(res, dbd, dir);
+	}
+}
+
+
+Row
+MappedResult::at(size_type i) const
+{
+	if (i >= rows_) {
+		if (throw_exceptions()) {
+			throw BadIndex("MappedResult", int(i), int(rows_) - 1);
+		}
+		else {
+			return Row();
+		}
+	}
+
+	return (*this)[i];
+}
+
+
+void
+MappedResult::fill(Row& r, size_type i) const
+{
+	const size_t nf = num_fields();
+	const char* small_fields[small_row];
+	unsigned long small_lengths[small_row];
+	std::vector<const char*> big_fields;
+	std::vector<unsigned long> big_lengths;
+	const char** fields = small_fields;
+	unsigned long* lengths = small_lengths;
+	if (nf > small_row) {
+		big_fields.resize(nf);
+		big_lengths.resize(nf);
+		fields = &big_fields[0];
+		lengths = &big_lengths[0];
+	}
+
+	const char* p = base_ + index_[i];
+	for (size_t j = 0; j < nf; ++j) {
+		ulonglong length;
+		memcpy(&length, p, sizeof(length));
+		p += sizeof(length);
+		if (length == null_length) {
+			fields[j] = 0;
+			lengths[j] = 0;
+		}
+		else {
+			fields[j] = p;
+			lengths[j] = static_cast<unsigned long>(length);
+			p += length + 1;
+		}
+	}
+
+	r.set_exceptions(throw_exceptions());
+	r.view(const_cast<MYSQL_ROW>(fields), this, lengths, file_);
+}
+
+
+void
+MappedResult::spill(MYSQL_RES* res, DBDriver* dbd, const char* dir)
+{
+	std::string error;
+	file_handle fh = create_temp_file(dir);
+	if (fh == no_file) {
+		error = "Can't create temporary file for result set: ";
+		error += last_error();
+	}
+	else {
+		// Write the rows out as fast as the server sends them.  The
+		// offset table is the only thing we keep in memory meanwhile.
+		spill_writer w(fh);
+		std::vector<ulonglong> offsets;
+		const size_t nf = num_fields();
+		while (MYSQL_ROW row = dbd->fetch_row(res)) {
+			const unsigned long* lengths = dbd->fetch_lengths(res);
+			if (!lengths) {
+				continue;
+			}
+
+			offsets.push_back(w.offset());
+			for (size_t i = 0; i < nf; ++i) {
+				if (row[i]) {
+					const ulonglong length = lengths[i];
+					w.put(&length, sizeof(length));
+					w.put(row[i], lengths[i]);
+					w.put("", 1);
+				}
+				else {
+					w.put(&null_length, sizeof(null_length));
+				}
+			}
+		}
+
+		// Pad to the alignment the offset table needs, then write it.
+		// Mappings start on a page boundary, so aligning the table
+		// within the file aligns it in memory, too.
+		static const char padding[sizeof(ulonglong)] = { 0 };
+		const ulonglong index_offset = (w.offset() + sizeof(ulonglong) - 1) /
+				sizeof(ulonglong) * sizeof(ulonglong);
+		w.put(padding, size_t(index_offset - w.offset()));
+		if (!offsets.empty()) {
+			w.put(&offsets[0], offsets.size() * sizeof(ulonglong));
+		}
+
+		const ulonglong size = w.offset();
+		if (!w.flush()) {
+			error = "Can't write result set to temporary file: ";
+			error += last_error();
+		}
+		else if (size != size_type(size)) {
+			error = "Result set is too big to map into memory";
+		}
+		else if (size > 0) {
+			if (char* base = map_file(fh, size_type(size))) {
+				file_ = new CellArena;
+				file_->adopt(base, size_type(size), unmap_file);
+				base_ = base;
+				index_ = reinterpret_cast<const ulonglong*>(
+						base + index_offset);
+				rows_ = offsets.size();
+				file_size_ = size_type(size);
+			}
+			else {
+				error = "Can't map result set's temporary file: ";
+				error += last_error();
+			}
+		}
+
+		// The mapping, if any, keeps the file alive from here on
+		close_file(fh);
+	}
+
+	// Free the C API result set whether or not we finished.  For a
+	// "use" result set, this reads and discards any rows we didn't get
+	// to, so the connection is ready for the next query either way.
+	dbd->free_result(res);
+
+	copacetic_ = error.empty();
+	if (!copacetic_ && throw_exceptions()) {
+		throw UseQueryError(error.c_str());
+	}
+}
+
+} // end namespace mysqlpp
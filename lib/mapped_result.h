@@ -0,0 +1,327 @@
+/// \file mapped_result.h
+/// \brief Declares the MappedResult class, which holds a result set in
+/// a memory-mapped temporary file.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_MAPPED_RESULT_H)
+#define MYSQLPP_MAPPED_RESULT_H
+
+#include "common.h"
+
+#include "cell_arena.h"
+#include "result.h"
+
+#include <iterator>
+
+namespace mysqlpp {
+
+/// \brief Result set type for result sets too big to hold in memory
+///
+/// StoreQueryResult gives you random access to the rows, but it needs
+/// enough memory to hold all of them.  UseQueryResult needs almost no
+/// memory, but it only goes forward, and it ties up the connection
+/// until you've read every row.  This class gives you random access
+/// without the memory: it reads the rows from a "use" query one at a
+/// time, writing them to a temporary file, and then maps that file
+/// back into memory.  The OS pages the data in as you touch it, so
+/// the only memory this object itself needs is a few bytes per field.
+///
+/// The connection is free for other queries as soon as you get one
+/// of these back from Query::store_mapped().
+///
+/// Rows come back by value, but fetching one doesn't copy the data.
+/// The Strings in a row are views onto the mapped file, and they keep
+/// it mapped as long as they exist, just as a StoreQueryResult in
+/// arena mode does with its arena.  So you can keep rows and Strings
+/// past the life of the MappedResult itself.
+///
+/// \code
+///   mysqlpp::MappedResult res = query.store_mapped();
+///   for (size_t i = res.num_rows(); i-- > 0; ) {
+///       mysqlpp::Row row = res[i];
+///       std::cout << row["id"] << '\t' << row["name"] << std::endl;
+///   }
+/// \endcode
+///
+/// The temporary file goes in the directory named by the \c TMPDIR
+/// environment variable, or in \c /tmp if that isn't set.  On Windows,
+/// it goes in the directory returned by \c GetTempPath().  The file is
+/// deleted as soon as it's created, or marked for deletion on close,
+/// so it goes away on its own, even if the program crashes.
+///
+/// Copying a MappedResult is cheap: the copy shares the mapping.
+
+class MYSQLPP_EXPORT MappedResult : public ResultBase
+{
+private:
+	/// \brief Pointer to bool data member, for use by safe bool
+	/// conversion operator.
+	///
+	/// \see http://www.artima.com/cppsource/safebool.html
+	typedef bool MappedResult::*private_bool_type;
+
+public:
+	/// \brief Type of row counts and indices
+	typedef size_t size_type;
+
+	/// \brief Iterator over the rows in the result set
+	///
+	/// Since rows are built on the fly, dereferencing one of these
+	/// returns a reference to a Row held within the iterator itself,
+	/// which stays valid until the iterator moves.  Because of that,
+	/// it's only an input iterator as far as the standard library is
+	/// concerned, but it supports random-access arithmetic anyway.
+	class const_iterator
+	{
+	public:
+		/// \brief iterator_traits boilerplate
+		typedef std::input_iterator_tag iterator_category;
+		typedef Row value_type;			///< iterator_traits boilerplate
+		typedef ptrdiff_t difference_type;	///< iterator_traits boilerplate
+		typedef const Row* pointer;		///< iterator_traits boilerplate
+		typedef const Row& reference;	///< iterator_traits boilerplate
+
+		/// \brief Create a singular iterator
+		const_iterator() :
+		res_(0),
+		i_(0),
+		row_i_(0)
+		{
+		}
+
+		/// \brief Get the row we point at
+		reference operator *() const { return fetch(); }
+
+		/// \brief Get a pointer to the row we point at
+		pointer operator ->() const { return &fetch(); }
+
+		/// \brief Get the row \c n places past the one we point at
+		value_type operator [](difference_type n) const
+				{ return (*res_)[i_ + n]; }
+
+		/// \brief Advance to the next row
+		const_iterator& operator ++() { ++i_; return *this; }
+
+		/// \brief Advance to the next row, returning the old position
+		const_iterator operator ++(int)
+				{ const_iterator tmp(*this); ++i_; return tmp; }
+
+		/// \brief Back up to the previous row
+		const_iterator& operator --() { --i_; return *this; }
+
+		/// \brief Back up to the previous row, returning the old
+		/// position
+		const_iterator operator --(int)
+				{ const_iterator tmp(*this); --i_; return tmp; }
+
+		/// \brief Move \c n rows forward
+		const_iterator& operator +=(difference_type n)
+				{ i_ += n; return *this; }
+
+		/// \brief Move \c n rows back
+		const_iterator& operator -=(difference_type n)
+				{ i_ -= n; return *this; }
+
+		/// \brief Return an iterator \c n rows forward of \c it
+		friend const_iterator operator +(const_iterator it,
+				difference_type n) { return it += n; }
+
+		/// \brief Return an iterator \c n rows back from \c it
+		friend const_iterator operator -(const_iterator it,
+				difference_type n) { return it -= n; }
+
+		/// \brief Return the number of rows between two iterators
+		friend difference_type operator -(const const_iterator& a,
+				const const_iterator& b)
+				{ return difference_type(a.i_) - difference_type(b.i_); }
+
+		/// \brief Iterator comparisons
+		friend bool operator ==(const const_iterator& a,
+				const const_iterator& b) { return a.i_ == b.i_; }
+		/// \brief Iterator comparisons
+		friend bool operator !=(const const_iterator& a,
+				const const_iterator& b) { return a.i_ != b.i_; }
+		/// \brief Iterator comparisons
+		friend bool operator <(const const_iterator& a,
+				const const_iterator& b) { return a.i_ < b.i_; }
+
+	private:
+		const_iterator(const MappedResult* res, size_type i) :
+		res_(res),
+		i_(i),
+		row_i_(0)
+		{
+		}
+
+		/// \brief Build the current row, if we haven't already
+		const Row& fetch() const
+		{
+			if (!row_ || row_i_ != i_) {
+				res_->fill(row_, i_);
+				row_i_ = i_;
+			}
+			return row_;
+		}
+
+		const MappedResult* res_;	///< the result set we iterate
+		size_type i_;				///< index of the current row
+		mutable Row row_;			///< the current row, once built
+		mutable size_type row_i_;	///< index of the row in row_
+
+		friend class MappedResult;
+	};
+
+	/// \brief Same as const_iterator, since rows can't be changed
+	typedef const_iterator iterator;
+
+	/// \brief Default constructor
+	MappedResult() :
+	ResultBase(),
+	base_(0),
+	index_(0),
+	rows_(0),
+	file_size_(0),
+	copacetic_(false)
+	{
+	}
+
+	/// \brief Fully initialize object
+	///
+	/// \param result C API result set to read the rows from, as from
+	/// DBDriver::use_result(); we free it when we're done with it
+	/// \param dbd database driver the result set came from
+	/// \param te if true, throw exceptions on errors
+	/// \param dir directory to put the temporary file in; if 0, we use
+	/// the default described above
+	///
+	/// \throw UseQueryError if we can't create, write or map the file
+	MappedResult(MYSQL_RES* result, DBDriver* dbd, bool te = true,
+			const char* dir = 0);
+
+	/// \brief Initialize object as a copy of another MappedResult
+	MappedResult(const MappedResult& other) :
+	ResultBase(other),
+	file_(other.file_),
+	base_(other.base_),
+	index_(other.index_),
+	rows_(other.rows_),
+	file_size_(other.file_size_),
+	copacetic_(other.copacetic_)
+	{
+	}
+
+	/// \brief Copy another MappedResult object's data into this one
+	MappedResult& operator =(const MappedResult& rhs)
+	{
+		if (this != &rhs) {
+			ResultBase::copy(rhs);
+			file_ = rhs.file_;
+			base_ = rhs.base_;
+			index_ = rhs.index_;
+			rows_ = rhs.rows_;
+			file_size_ = rhs.file_size_;
+			copacetic_ = rhs.copacetic_;
+		}
+		return *this;
+	}
+
+	/// \brief Get the row at the given index, with bounds checking
+	///
+	/// \throw mysqlpp::BadIndex if \c i is past the end
+	Row at(size_type i) const;
+
+	/// \brief Return an iterator pointing to the first row
+	const_iterator begin() const { return const_iterator(this, 0); }
+
+	/// \brief Returns true if there are no rows
+	bool empty() const { return rows_ == 0; }
+
+	/// \brief Return an iterator pointing past the last row
+	const_iterator end() const { return const_iterator(this, rows_); }
+
+	/// \brief Returns the size of the temporary file, in bytes
+	size_type file_size() const { return file_size_; }
+
+	/// \brief Returns the number of rows in this result set
+	size_type num_rows() const { return rows_; }
+
+	/// \brief Get the row at the given index
+	Row operator [](size_type i) const
+	{
+		Row r;
+		fill(r, i);
+		return r;
+	}
+
+	/// \brief Returns the number of rows in this result set
+	size_type size() const { return rows_; }
+
+	/// \brief Exchange contents with another MappedResult
+	void swap(MappedResult& other)
+	{
+		ResultBase::swap(other);
+		file_.swap(other.file_);
+		std::swap(base_, other.base_);
+		std::swap(index_, other.index_);
+		std::swap(rows_, other.rows_);
+		std::swap(file_size_, other.file_size_);
+		std::swap(copacetic_, other.copacetic_);
+	}
+
+	/// \brief Test whether the query that created this result succeeded
+	///
+	/// \sa StoreQueryResult::operator private_bool_type()
+	operator private_bool_type() const
+	{
+		return copacetic_ ? &MappedResult::copacetic_ : 0;
+	}
+
+private:
+	/// \brief Write the rows of \c res to a temporary file in \c dir,
+	/// then map it
+	void spill(MYSQL_RES* res, DBDriver* dbd, const char* dir);
+
+	/// \brief Point \c r at the fields of row \c i
+	void fill(Row& r, size_type i) const;
+
+	/// \brief Owns the mapping, so Strings pointing into it can keep
+	/// it alive
+	RefCountedArena file_;
+
+	/// \brief Start of the mapping
+	const char* base_;
+
+	/// \brief Offset of each row within the mapping; this table is at
+	/// the end of the file itself
+	const ulonglong* index_;
+
+	size_type rows_;		///< number of rows in the result set
+	size_type file_size_;	///< size of the mapping, in bytes
+	bool copacetic_;		///< true if initialized from a good result set
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_MAPPED_RESULT_H)
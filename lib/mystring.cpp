@@ -41,7 +41,7 @@ String::at(size_type pos) const
 		throw BadIndex("String", int(pos), int(size()));
 	}
 	else {
-		return buffer_->data()[pos];
+		return data()[pos];
 	}
 }
 
@@ -49,9 +49,9 @@ String::at(size_type pos) const
 int
 String::compare(const String& other) const
 {
-	if (other.buffer_) {
+	if (other.initted()) {
 		return compare(0, std::max(length(), other.length()),
-				other.buffer_->data());
+				other.data());
 	}
 	else {
 		// Other object has no buffer, so we are greater unless empty or
@@ -86,7 +86,7 @@ int
 String::compare(size_type pos, size_type num,
 		const char* other) const
 {
-	if (buffer_ && other) {
+	if (initted() && other) {
 		return strncmp(data() + pos, other, num);
 	}
 	else if (!other) {
@@ -122,7 +122,7 @@ template <>
 std::string
 String::conv(std::string) const
 {
-	return buffer_ ? std::string(data(), length()) : std::string();
+	return initted() ? std::string(data(), length()) : std::string();
 }
 
 
@@ -130,7 +130,7 @@ template <>
 Date
 String::conv(Date) const
 {
-	return buffer_ ? Date(c_str()) : Date();
+	return initted() ? Date(c_str()) : Date();
 }
 
 
@@ -138,7 +138,7 @@ template <>
 DateTime
 String::conv(DateTime) const
 {
-	return buffer_ ? DateTime(c_str()) : DateTime();
+	return initted() ? DateTime(c_str()) : DateTime();
 }
 
 
@@ -146,7 +146,7 @@ template <>
 Time
 String::conv(Time) const
 {
-	return buffer_ ? Time(c_str()) : Time();
+	return initted() ? Time(c_str()) : Time();
 }
 
 #endif // !defined(DOXYGEN_IGNORE)
@@ -155,35 +155,39 @@ String::conv(Time) const
 const char*
 String::data() const
 {
-	return buffer_ ? buffer_->data() : 0;
+	return view_data_ ? view_data_ : buffer_ ? buffer_->data() : 0;
 }
 
 
 String::const_iterator
 String::end() const
 {
-	return buffer_ ? buffer_->data() + buffer_->length() : 0;
+	return initted() ? data() + length() : 0;
 }
 
 
 bool
 String::escape_q() const
 {
-	return buffer_ ? buffer_->type().escape_q() : false;
+	return initted() ? type().escape_q() : false;
 }
 
 
 bool
 String::is_null() const
 {
-	return buffer_ ? buffer_->is_null() : false;
+	return view_data_ ? view_null_ : buffer_ ? buffer_->is_null() : false;
 }
 
 
 void
 String::it_is_null()
 {
-	if (buffer_) {
+	if (view_data_) {
+		// The flag is ours, not the arena's, so this is safe
+		view_null_ = true;
+	}
+	else if (buffer_) {
 		buffer_->set_null();
 	}
 	else {
@@ -195,7 +199,7 @@ String::it_is_null()
 String::size_type
 String::length() const
 {
-	return buffer_ ? buffer_->length() : 0;
+	return view_data_ ? view_length_ : buffer_ ? buffer_->length() : 0;
 }
 
 
@@ -204,15 +208,28 @@ String::quote_q() const
 {
 	// If no buffer, it means we're an empty string, so we need to be 
 	// quoted to be expressed properly in SQL.
-	return buffer_ ? buffer_->type().quote_q() : true;
+	return initted() ? type().quote_q() : true;
+}
+
+
+RefCountedBuffer
+String::shared_buffer() const
+{
+	if (view_data_) {
+		return RefCountedBuffer(new SQLBuffer(view_data_, view_length_,
+				view_type_, view_null_));
+	}
+	else {
+		return buffer_;
+	}
 }
 
 
 void
 String::to_string(std::string& s) const
 {
-	if (buffer_) {
-		s.assign(buffer_->data(), buffer_->length());
+	if (initted()) {
+		s.assign(data(), length());
 	}
 	else {
 		s.clear();
@@ -235,7 +252,7 @@ String::to_string(std::string& s) const
 std::ostream&
 operator <<(std::ostream& o, const String& in)
 {
-	if (dynamic_cast<Query*>(&o)) {
+	if (internal::sql_sink(o) == internal::query_sink) {
 		// We can just insert the raw data into the stream
 		o.write(in.data(), in.length());
 	}
@@ -31,11 +31,14 @@
 
 #include "common.h"
 
+#include "cell_arena.h"
 #include "datetime.h"
 #include "exceptions.h"
 #include "null.h"
+#include "numparse.h"
 #include "sql_buffer.h"
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <limits>
@@ -101,6 +104,7 @@ namespace detail
 	};
 } // namespace detail
 
+class MYSQLPP_EXPORT Row;
 class MYSQLPP_EXPORT SQLTypeAdapter;
 #endif // !defined(DOXYGEN_IGNORE)
 
@@ -135,6 +139,19 @@ class MYSQLPP_EXPORT SQLTypeAdapter;
 /// This class also has some basic information about the type of data
 /// stored in it, to allow it to do the conversions more intelligently
 /// than a trivial implementation would allow.
+///
+/// Normally, a String owns a reference-counted SQLBuffer holding its
+/// own copy of the data.  A String can instead be a view onto data
+/// held in a CellArena, as in a StoreQueryResult stored in arena mode.
+/// Such a String behaves exactly like any other, but constructing and
+/// copying it doesn't allocate any memory.  It holds a reference to
+/// the arena, so the data remains valid as long as the String does.
+///
+/// The Strings in a RowView are also views, but onto the C API's own
+/// row buffer, which only lives until the next row is fetched.  These
+/// "borrowed" views don't hold a reference to anything, so copying
+/// one gives the copy its own buffer.  Only references and pointers
+/// to the Strings in a RowView can go stale.
 
 class MYSQLPP_EXPORT String
 {
@@ -165,7 +182,10 @@ public:
 	/// An object constructed this way is essentially useless, but
 	/// sometimes you just need to construct a default object.
 	String() :
-	buffer_()
+	buffer_(),
+	view_data_(0),
+	view_length_(0),
+	view_null_(false)
 	{
 	}
 
@@ -176,11 +196,37 @@ public:
 	/// This ctor only copies the pointer to the other String's data
 	/// buffer and increments its reference counter.  If you need a
 	/// deep copy, use one of the ctors that takes a string.
+	///
+	/// The exception is when \c other is a borrowed view from a
+	/// RowView, in which case we must copy the data.
 	String(const String& other) :
-	buffer_(other.buffer_)
+	view_data_(0),
+	view_length_(0),
+	view_null_(false)
 	{
+		copy(other);
 	}
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move ctor
+	///
+	/// Takes over the other String's buffer without touching its
+	/// reference count, leaving \c other empty.  Borrowed views are
+	/// copied instead, as with the copy ctor.
+	String(String&& other) :
+	view_data_(0),
+	view_length_(0),
+	view_null_(false)
+	{
+		if (other.view_data_ && !other.arena_) {
+			copy(other);
+		}
+		else {
+			swap(other);
+		}
+	}
+#endif
+
 	/// \brief Full constructor.
 	///
 	/// \param str the string this object represents, or 0 for SQL null
@@ -196,7 +242,33 @@ public:
 	explicit String(const char* str, size_type len,
 			mysql_type_info type = mysql_type_info::string_type,
 			bool is_null = false) :
-	buffer_(new SQLBuffer(str, len, type, is_null))
+	buffer_(new SQLBuffer(str, len, type, is_null)),
+	view_data_(0),
+	view_length_(0),
+	view_null_(false)
+	{
+	}
+
+	/// \brief Create a view onto data held in a CellArena
+	///
+	/// \param str the string this object represents; must point into
+	/// \c arena, or to static data
+	/// \param len the length of the string, not counting the null
+	/// terminator that must follow it
+	/// \param type MySQL type information for data within str
+	/// \param is_null string represents a SQL null, not literal data
+	/// \param arena the arena holding \c str
+	///
+	/// Unlike the other ctors, this one doesn't copy the data.  We just
+	/// take another reference to the arena, keeping it alive for as
+	/// long as this object or any copy of it exists.
+	String(const char* str, size_type len, mysql_type_info type,
+			bool is_null, const RefCountedArena& arena) :
+	arena_(arena),
+	view_data_(str),
+	view_length_(len),
+	view_type_(type),
+	view_null_(is_null)
 	{
 	}
 
@@ -211,7 +283,10 @@ public:
 			mysql_type_info type = mysql_type_info::string_type,
 			bool is_null = false) :
 	buffer_(new SQLBuffer(str.data(), static_cast<size_type>(str.length()),
-			type, is_null))
+			type, is_null)),
+	view_data_(0),
+	view_length_(0),
+	view_null_(false)
 	{
 	}
 
@@ -226,7 +301,10 @@ public:
 			mysql_type_info type = mysql_type_info::string_type,
 			bool is_null = false) :
 	buffer_(new SQLBuffer(str, static_cast<size_type>(strlen(str)),
-			type, is_null))
+			type, is_null)),
+	view_data_(0),
+	view_length_(0),
+	view_null_(false)
 	{
 	}
 
@@ -244,6 +322,7 @@ public:
 			bool is_null = false)
 	{
 		buffer_ = new SQLBuffer(str, len, type, is_null);
+		drop_view();
 	}
 
 	/// \brief Assign a C++ string to this object
@@ -258,6 +337,7 @@ public:
 	{
 		buffer_ = new SQLBuffer(str.data(),
 				static_cast<size_type>(str.length()), type, is_null);
+		drop_view();
 	}
 
 	/// \brief Assign a C string to this object
@@ -272,6 +352,7 @@ public:
 	{
 		buffer_ = new SQLBuffer(str, static_cast<size_type>(strlen(str)),
 				type, is_null);
+		drop_view();
 	}
 
 	/// \brief Return a character within the string.
@@ -447,7 +528,8 @@ public:
 	/// \brief Get this object's current MySQL type.
 	mysql_type_info type() const
 	{
-		return buffer_ ? buffer_->type() : mysql_type_info::string_type;
+		return view_data_ ? view_type_ :
+				buffer_ ? buffer_->type() : mysql_type_info::string_type;
 	}
 
 	/// \brief Assignment operator, from C++ string
@@ -456,6 +538,7 @@ public:
 		buffer_ = new SQLBuffer(rhs.data(),
 				static_cast<size_type>(rhs.length()),
 				mysql_type_info::string_type, false);
+		drop_view();
 
 		return *this;
 	}
@@ -469,6 +552,7 @@ public:
 		buffer_ = new SQLBuffer(str,
 				static_cast<size_type>(strlen(str)),
 				mysql_type_info::string_type, false);
+		drop_view();
 
 		return *this;
 	}
@@ -480,10 +564,35 @@ public:
 	/// deep copy, assign a string to this object instead.
 	String& operator =(const String& other)
 	{
-		buffer_ = other.buffer_;
+		return copy(other);
+	}
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move assignment operator
+	///
+	/// \sa String(String&&)
+	String& operator =(String&& other)
+	{
+		if (other.view_data_ && !other.arena_) {
+			return copy(other);
+		}
+		swap(other);
 		return *this;
 	}
+#endif
+
+	/// \brief Exchange contents with another String
+	///
+	/// This just swaps pointers, so it's cheap and can't throw.
+	void swap(String& other)
+	{
+		buffer_.swap(other.buffer_);
+		arena_.swap(other.arena_);
+		std::swap(view_data_, other.view_data_);
+		std::swap(view_length_, other.view_length_);
+		std::swap(view_type_, other.view_type_);
+		std::swap(view_null_, other.view_null_);
+	}
 
 	/// \brief Equality comparison operator
 	///
@@ -587,17 +696,17 @@ public:
 			{ return conv(static_cast<double>(0)); }
 	
 	/// \brief Converts this object's string data to a bool
-	operator bool() const { return buffer_ ? atoi(c_str()) : false; }
+	operator bool() const { return initted() ? atoi(c_str()) : false; }
 
 	/// \brief Converts this object's string data to a mysqlpp::Date
-	operator Date() const { return buffer_ ? Date(*this) : Date(); }
+	operator Date() const { return initted() ? Date(*this) : Date(); }
 
 	/// \brief Converts this object's string data to a mysqlpp::DateTime
 	operator DateTime() const
-			{ return buffer_ ? DateTime(*this) : DateTime(); }
+			{ return initted() ? DateTime(*this) : DateTime(); }
 
 	/// \brief Converts this object's string data to a mysqlpp::Time
-	operator Time() const { return buffer_ ? Time(*this) : Time(); }
+	operator Time() const { return initted() ? Time(*this) : Time(); }
 
 	/// \brief Converts the String to a nullable data type
 	///
@@ -607,50 +716,97 @@ public:
 
 private:
 	/// \brief Do the actual numeric conversion via @p Type.
+	///
+	/// \sa internal::parse_number()
 	template <class Type>
 	Type do_conv(const char* type_name) const
 	{
-		if (buffer_) {
-			std::stringstream buf;
-			buf.write(data(), static_cast<std::streamsize>(length()));
-			buf.imbue(std::locale::classic()); // "C" locale
+		if (initted()) {
 			Type num = Type();
-			
-			if (buf >> num) {
-				char c;
-				if (!(buf >> c)) {
-					// Nothing left in buffer, so conversion complete,
-					// and thus successful.
+			switch (internal::parse_number(data(), length(), num)) {
+				case internal::pr_ok:
+				case internal::pr_empty:
+				case internal::pr_overflow:
 					return num;
-				}
-
-				if (c == '.' &&
-						(typeid(Type) != typeid(float)) &&
-						(typeid(Type) != typeid(double))) {
-					// Conversion stopped on a decimal point -- locale
-					// doesn't matter to MySQL -- so only way to succeed
-					// is if it's an integer and everything following
-					// the decimal is inconsequential.
-					c = '0';	// handles '.' at end of string
-					while (buf >> c && c == '0') /* spin */ ;
-					if (buf.eof() && c == '0') {
-						return num;  // only zeros after decimal point
-					}
-				}
-			}
-			else if (buf.eof()) {
-				return num;  // nothing to convert, return default value
-			}
 
-			throw BadConversion(type_name, data(), 0, length());
+				default:
+					throw BadConversion(type_name, data(), 0, length());
+			}
 		}
 		else {
 			return 0;
 		}
 	}
 
+	/// \brief Make this object a borrowed view onto data we don't own
+	///
+	/// Row uses this to build a RowView over the C API's row buffer.
+	/// Unlike the arena view ctor, we don't keep the data alive, so
+	/// copies of this object get their own buffer.  See copy().
+	void borrow(const char* str, size_type len, mysql_type_info type,
+			bool is_null)
+	{
+		buffer_ = 0;
+		arena_ = 0;
+		view_data_ = str;
+		view_length_ = len;
+		view_type_ = type;
+		view_null_ = is_null;
+	}
+
+	/// \brief Make this object share another String's data
+	///
+	/// This backs the copy ctor and assignment operator.  If \c other
+	/// is a borrowed view, its data can vanish at any time, so we copy
+	/// it into a new buffer.  Otherwise, we just take another reference
+	/// to its buffer or arena.
+	String& copy(const String& other)
+	{
+		if (other.view_data_ && !other.arena_) {
+			buffer_ = other.shared_buffer();
+			drop_view();
+		}
+		else {
+			buffer_ = other.buffer_;
+			arena_ = other.arena_;
+			view_data_ = other.view_data_;
+			view_length_ = other.view_length_;
+			view_type_ = other.view_type_;
+			view_null_ = other.view_null_;
+		}
+
+		return *this;
+	}
+
+	/// \brief Forget about any view data we were looking at
+	///
+	/// Called after giving this object a buffer of its own.
+	void drop_view()
+	{
+		arena_ = 0;
+		view_data_ = 0;
+		view_length_ = 0;
+		view_null_ = false;
+	}
+
+	/// \brief Returns true if we hold data, in a buffer or a view
+	bool initted() const { return view_data_ || buffer_; }
+
+	/// \brief Return a buffer holding our data
+	///
+	/// If we're a view, this copies the data into a new buffer.
+	/// SQLTypeAdapter needs this, since it can only hold its data in
+	/// a SQLBuffer.
+	RefCountedBuffer shared_buffer() const;
+
 	RefCountedBuffer buffer_;	///< reference-counted data buffer
+	RefCountedArena arena_;		///< arena holding view_data_, if any
+	const char* view_data_;		///< if nonzero, we're a view
+	size_type view_length_;		///< bytes at view_data_, sans null
+	mysql_type_info view_type_;	///< SQL type of data at view_data_
+	bool view_null_;			///< if true, view is of a SQL null
 
+	friend class Row;
 	friend class SQLTypeAdapter;
 };
 
@@ -765,6 +921,27 @@ template <> MYSQLPP_EXPORT Time String::conv(Time) const;
 
 #endif // !defined(DOXYGEN_IGNORE)
 
+/// \brief Swaps two String objects
+inline void
+swap(String& x, String& y)
+{
+	x.swap(y);
+}
+
 } // end namespace mysqlpp
 
+#if !defined(DOXYGEN_IGNORE)
+// Let standard algorithms like std::sort() swap Strings cheaply.  C++98
+// library implementations call std::swap() by its qualified name, so
+// the ADL overload above isn't enough.
+namespace std {
+	template <>
+	inline void
+	swap(mysqlpp::String& x, mysqlpp::String& y)
+	{
+		x.swap(y);
+	}
+}
+#endif // !defined(DOXYGEN_IGNORE)
+
 #endif // !defined(MYSQLPP_MYSTRING_H)
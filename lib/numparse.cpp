@@ -0,0 +1,428 @@
+/***********************************************************************
+ numparse.cpp - Implements the locale-independent number parsers used
+	by String::conv().
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#define MYSQLPP_NOT_HEADER
+#include "common.h"
+
+#include "numparse.h"
+
+#include <limits>
+#include <locale>
+#include <sstream>
+
+#include <float.h>
+#include <string.h>
+
+using namespace std;
+
+namespace mysqlpp {
+namespace internal {
+
+// Like isspace() in the "C" locale, but without the function call or
+// the locale lookup.
+static inline bool
+is_space(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+static inline bool
+is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+
+#if !defined(MYSQLPP_NO_LONG_LONGS)
+// Returns true if this machine stores integers least significant byte
+// first.  The compiler folds this to a constant.
+static inline bool
+little_endian()
+{
+	const unsigned int one = 1;
+	return *reinterpret_cast<const unsigned char*>(&one) == 1;
+}
+
+
+// Returns true if all 8 bytes of chunk are ASCII digits.  Adding 6 to
+// each byte pushes anything above '9' into the next 16s column, so a
+// byte is a digit only if both it and its sum have a high nybble of 3.
+static inline bool
+is_8_digits(ulonglong chunk)
+{
+	return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+			(((chunk + 0x0606060606060606ULL) &
+			0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+
+// Converts 8 ASCII digits, loaded little-endian, to their value.  Each
+// step combines pairs of adjacent lanes, so it takes three multiplies
+// instead of eight.
+static inline ulonglong
+parse_8_digits(ulonglong chunk)
+{
+	const ulonglong mask = 0x000000FF000000FFULL;
+	const ulonglong mul1 = 0x000F424000000064ULL;	// 100 + 10^6 << 32
+	const ulonglong mul2 = 0x0000271000000001ULL;	// 1 + 10^4 << 32
+	chunk -= 0x3030303030303030ULL;
+	chunk = (chunk * 10) + (chunk >> 8);
+	return (((chunk & mask) * mul1) +
+			(((chunk >> 16) & mask) * mul2)) >> 32;
+}
+#endif
+
+
+// Scans the digits starting at p, accumulating them into value.  We do
+// 8 at a time while there's no chance of overflow, then fall back to a
+// digit at a time with an overflow check.  Returns false on overflow,
+// leaving p somewhere in the digit string.
+static bool
+scan_digits(const char*& p, const char* e, ulonglong& value)
+{
+	const ulonglong max = numeric_limits<ulonglong>::max();
+
+	// Leading zeros don't count toward the overflow limit
+	while (p != e && *p == '0') {
+		++p;
+	}
+
+#if !defined(MYSQLPP_NO_LONG_LONGS)
+	// A ulonglong holds any 19-digit number, so up to that many digits
+	// need no overflow checks.
+	if (little_endian()) {
+		const char* safe_end = e - p > 19 ? p + 19 : e;
+		while (safe_end - p >= 8) {
+			ulonglong chunk;
+			memcpy(&chunk, p, sizeof(chunk));
+			if (!is_8_digits(chunk)) {
+				break;
+			}
+			value = value * 100000000 + parse_8_digits(chunk);
+			p += 8;
+		}
+	}
+#endif
+
+	for (; p != e && is_digit(*p); ++p) {
+		unsigned d = *p - '0';
+		if (value > (max - d) / 10) {
+			return false;
+		}
+		value = value * 10 + d;
+	}
+
+	return true;
+}
+
+
+// Returns true if everything from p to e is whitespace
+static inline bool
+only_space(const char* p, const char* e)
+{
+	while (p != e && is_space(*p)) {
+		++p;
+	}
+	return p == e;
+}
+
+
+// Parse text as an integer, returning its magnitude and sign separately
+// so the callers can apply their own range limits.  at_end tells them
+// whether the digits ran to the end of the text, since iostreams only
+// clamped out-of-range values in that case, and we do as it did.
+static parse_result
+parse_integer(const char* p, size_t len, ulonglong& magnitude,
+		bool& negative, bool& at_end)
+{
+	const char* e = p + len;
+	while (p != e && is_space(*p)) {
+		++p;
+	}
+	negative = false;
+	if (p != e && (*p == '-' || *p == '+')) {
+		negative = *p++ == '-';
+	}
+	if (p == e) {
+		return pr_empty;	// iostreams took a lone sign as 0, too
+	}
+
+	const char* digits = p;
+	magnitude = 0;
+	bool fits = scan_digits(p, e, magnitude);
+	while (!fits && p != e && is_digit(*p)) {
+		++p;
+	}
+	if (p == digits) {
+		return pr_bad;		// no digits at all
+	}
+	at_end = p == e;
+	if (!fits) {
+		return at_end ? pr_overflow : pr_bad;
+	}
+
+	// MySQL gives us things like "12.000" for some DECIMAL values, so
+	// allow a fraction as long as it doesn't change the value.
+	if (p != e && *p == '.') {
+		++p;
+		while (p != e && *p == '0') {
+			++p;
+		}
+	}
+
+	return only_space(p, e) ? pr_ok : pr_bad;
+}
+
+
+// Parse text as a signed integer of type T
+template <typename T>
+static parse_result
+parse_signed(const char* str, size_t len, T& out)
+{
+	ulonglong magnitude;
+	bool negative, at_end;
+	parse_result r = parse_integer(str, len, magnitude, negative, at_end);
+	if (r == pr_ok) {
+		// Written this way to avoid overflow in computing -min()
+		const ulonglong limit = negative ?
+				ulonglong(-(numeric_limits<T>::min() + 1)) + 1 :
+				ulonglong(numeric_limits<T>::max());
+		if (magnitude > limit) {
+			r = at_end ? pr_overflow : pr_bad;
+		}
+		else {
+			out = !negative ? T(magnitude) :
+					magnitude ? T(-T(magnitude - 1) - 1) : T(0);
+		}
+	}
+
+	if (r == pr_overflow) {
+		out = negative ? numeric_limits<T>::min() :
+				numeric_limits<T>::max();
+	}
+	else if (r == pr_empty) {
+		out = 0;
+	}
+	return r;
+}
+
+
+// Parse text as an unsigned integer of type T
+template <typename T>
+static parse_result
+parse_unsigned(const char* str, size_t len, T& out)
+{
+	ulonglong magnitude;
+	bool negative, at_end;
+	parse_result r = parse_integer(str, len, magnitude, negative, at_end);
+	if (r == pr_ok) {
+		if (magnitude > ulonglong(numeric_limits<T>::max())) {
+			r = at_end ? pr_overflow : pr_bad;
+		}
+		else {
+			out = negative ? T(0 - T(magnitude)) : T(magnitude);
+		}
+	}
+
+	if (r == pr_overflow) {
+		out = numeric_limits<T>::max();		// whatever the sign
+	}
+	else if (r == pr_empty) {
+		out = 0;
+	}
+	return r;
+}
+
+
+parse_result
+parse_number(const char* str, size_t len, long& out)
+{
+	return parse_signed(str, len, out);
+}
+
+
+parse_result
+parse_number(const char* str, size_t len, unsigned long& out)
+{
+	return parse_unsigned(str, len, out);
+}
+
+
+#if !defined(MYSQLPP_NO_LONG_LONGS)
+parse_result
+parse_number(const char* str, size_t len, long long& out)
+{
+	return parse_signed(str, len, out);
+}
+
+
+parse_result
+parse_number(const char* str, size_t len, unsigned long long& out)
+{
+	return parse_unsigned(str, len, out);
+}
+#endif
+
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+// Powers of ten that are exactly representable in a double
+static const double exact_pow10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+	1e20, 1e21, 1e22
+};
+#endif
+
+
+// Parse a floating-point value with iostreams, for the cases the fast
+// path in parse_number(double) can't handle exactly.  This is the way
+// String::conv() always used to do it.
+static parse_result
+parse_double_slow(const char* str, size_t len, double& out)
+{
+	istringstream buf(string(str, len));
+	buf.imbue(locale::classic());
+	double num = 0;
+	if (buf >> num) {
+		char c;
+		if (buf >> c) {
+			return pr_bad;
+		}
+		out = num;
+		return pr_ok;
+	}
+	else if (buf.eof()) {
+		// It failed at the end of the text: either there were no
+		// digits, as with a lone sign, which it takes as 0, or the
+		// value was out of range, which it clamps to DBL_MAX.
+		out = num;
+		return num == 0 ? pr_empty : pr_overflow;
+	}
+	else {
+		return pr_bad;
+	}
+}
+
+
+parse_result
+parse_number(const char* str, size_t len, double& out)
+{
+	const char* p = str;
+	const char* e = str + len;
+	while (p != e && is_space(*p)) {
+		++p;
+	}
+	if (p == e) {
+		out = 0;
+		return pr_empty;
+	}
+
+	bool negative = false;
+	if (*p == '-' || *p == '+') {
+		negative = *p++ == '-';
+	}
+
+	// Gather up to 19 significant digits into an integer mantissa,
+	// noting where the decimal point falls.  Anything longer goes the
+	// slow way, since we can't round it correctly here.
+	ulonglong mantissa = 0;
+	int digits = 0, exponent = 0;
+	bool any_digits = false;
+	for (; p != e && is_digit(*p); ++p, any_digits = true) {
+		if (mantissa || *p != '0') {
+			if (++digits > 19) {
+				return parse_double_slow(str, len, out);
+			}
+			mantissa = mantissa * 10 + (*p - '0');
+		}
+	}
+	if (p != e && *p == '.') {
+		for (++p; p != e && is_digit(*p); ++p, any_digits = true) {
+			if (mantissa || *p != '0') {
+				if (++digits > 19) {
+					return parse_double_slow(str, len, out);
+				}
+				mantissa = mantissa * 10 + (*p - '0');
+			}
+			--exponent;
+		}
+	}
+	if (!any_digits) {
+		return parse_double_slow(str, len, out);	// let it decide
+	}
+
+	if (p != e && (*p == 'e' || *p == 'E')) {
+		++p;
+		bool neg_exp = false;
+		if (p != e && (*p == '-' || *p == '+')) {
+			neg_exp = *p++ == '-';
+		}
+		if (p == e || !is_digit(*p)) {
+			return parse_double_slow(str, len, out);
+		}
+		int exp = 0;
+		for (; p != e && is_digit(*p); ++p) {
+			if (exp < 10000) {
+				exp = exp * 10 + (*p - '0');
+			}
+		}
+		exponent += neg_exp ? -exp : exp;
+	}
+
+	if (!only_space(p, e)) {
+		return pr_bad;
+	}
+
+	// Clinger's fast path: if both the mantissa and the power of ten
+	// are exact doubles, one IEEE multiply or divide rounds correctly.
+	// That doesn't hold where the FPU keeps extra precision.
+	double value;
+	if (mantissa == 0) {
+		value = 0;
+	}
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+	else if (mantissa <= (ulonglong(1) << 53) &&
+			exponent >= -22 && exponent <= 22) {
+		value = double(mantissa);
+		if (exponent < 0) {
+			value /= exact_pow10[-exponent];
+		}
+		else {
+			value *= exact_pow10[exponent];
+		}
+	}
+#endif
+	else {
+		return parse_double_slow(str, len, out);
+	}
+
+	out = negative ? -value : value;
+	return pr_ok;
+}
+
+} // end namespace mysqlpp::internal
+} // end namespace mysqlpp
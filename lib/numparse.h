@@ -0,0 +1,91 @@
+/// \file numparse.h
+/// \brief Declares the number parsers behind String::conv()
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_NUMPARSE_H)
+#define MYSQLPP_NUMPARSE_H
+
+#include "common.h"
+
+#include <stddef.h>
+
+namespace mysqlpp {
+	namespace internal {
+		/// \brief Outcomes of a parse_number() call
+		enum parse_result {
+			pr_ok,			///< parsed a number; the output is set
+			pr_empty,		///< no digits, at most a sign; output is 0
+			pr_bad,			///< not a number, or trailing garbage
+			pr_overflow		///< out of range; output is clamped
+		};
+
+		/// \brief Parse SQL text as a number
+		///
+		/// These implement String::conv().  They take the text MySQL
+		/// gives us for a numeric column, which needn't be
+		/// null-terminated, and parse it without allocating memory or
+		/// paying any attention to the C++ or C locale: the decimal
+		/// point is always '.'.
+		///
+		/// The rules are the ones String::conv() has always followed:
+		/// leading and trailing whitespace is skipped, empty text or
+		/// a lone sign is zero, and anything else left over is an
+		/// error.  The integer versions also accept a fraction made
+		/// entirely of zeros, such as "12.000", since MySQL gives us
+		/// that for some DECIMAL values, but not "12.5".  As with the
+		/// iostreams we used to use here, a negative value given to an
+		/// unsigned type wraps around, and a value out of range for
+		/// the type is clamped to its limit, but only if nothing at
+		/// all follows the number.
+		///
+		/// \param str text to parse
+		/// \param len number of bytes in \c str
+		/// \param out receives the value; set to 0 on pr_empty, to
+		/// the clamped value on pr_overflow, and left alone on
+		/// pr_bad
+		MYSQLPP_EXPORT parse_result parse_number(const char* str,
+				size_t len, long& out);
+
+		/// \copydoc parse_number(const char*, size_t, long&)
+		MYSQLPP_EXPORT parse_result parse_number(const char* str,
+				size_t len, unsigned long& out);
+
+#if !defined(MYSQLPP_NO_LONG_LONGS)
+		/// \copydoc parse_number(const char*, size_t, long&)
+		MYSQLPP_EXPORT parse_result parse_number(const char* str,
+				size_t len, long long& out);
+
+		/// \copydoc parse_number(const char*, size_t, long&)
+		MYSQLPP_EXPORT parse_result parse_number(const char* str,
+				size_t len, unsigned long long& out);
+#endif
+
+		/// \copydoc parse_number(const char*, size_t, long&)
+		MYSQLPP_EXPORT parse_result parse_number(const char* str,
+				size_t len, double& out);
+	} // end namespace mysqlpp::internal
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_NUMPARSE_H)
@@ -0,0 +1,709 @@
+/***********************************************************************
+ prepared_query.cpp - Implements the PreparedQuery class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "prepared_query.h"
+
+#include "connection.h"
+#include "dbdriver.h"
+
+#include <sstream>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+using namespace std;
+
+namespace mysqlpp {
+
+// Initial size of a text column's fetch buffer, unless the column is
+// declared shorter.  fetch() grows the buffer when a value doesn't fit.
+static const unsigned long initial_text_buffer = 256;
+
+
+// Returns true if the given error means the server or the C API has
+// forgotten a prepared statement, so it never ran: ER_UNKNOWN_STMT_HANDLER,
+// CR_NO_PREPARE_STMT, or CR_STMT_CLOSED after a reconnect.  Not all C
+// API versions define the names.
+static bool
+stale_statement(unsigned int err)
+{
+	return err == 1243 || err == 2030 || err == 2056;
+}
+
+
+PreparedQuery::Param::Param() :
+bound(false),
+type(MYSQL_TYPE_NULL),
+is_unsigned(false),
+null_flag(1)
+{
+	number.i = 0;
+	memset(&time, 0, sizeof(time));
+}
+
+
+PreparedQuery::Column::Column(const MYSQL_FIELD& field) :
+is_unsigned((field.flags & UNSIGNED_FLAG) != 0),
+null_flag(0),
+error_flag(0),
+length(0),
+digits(numeric_limits<double>::digits10)
+{
+	number.i = 0;
+	memset(&time, 0, sizeof(time));
+
+	switch (field.type) {
+		case MYSQL_TYPE_TINY:
+		case MYSQL_TYPE_SHORT:
+		case MYSQL_TYPE_INT24:
+		case MYSQL_TYPE_LONG:
+		case MYSQL_TYPE_LONGLONG:
+		case MYSQL_TYPE_YEAR:
+			kind = integer;
+			type = MYSQL_TYPE_LONGLONG;
+			break;
+
+		case MYSQL_TYPE_FLOAT:
+			digits = numeric_limits<float>::digits10;
+			// fall through
+		case MYSQL_TYPE_DOUBLE:
+			kind = real;
+			type = MYSQL_TYPE_DOUBLE;
+			break;
+
+		case MYSQL_TYPE_DATE:
+		case MYSQL_TYPE_NEWDATE:
+			kind = temporal;
+			type = MYSQL_TYPE_DATE;
+			break;
+
+		case MYSQL_TYPE_TIME:
+		case MYSQL_TYPE_DATETIME:
+		case MYSQL_TYPE_TIMESTAMP:
+			kind = temporal;
+			type = field.type;
+			break;
+
+		default:
+			// Decimals, strings, blobs, and anything else without an
+			// exact C++ counterpart come back as text, as with Query.
+			kind = text;
+			type = MYSQL_TYPE_STRING;
+			buffer.resize(field.length > 0 &&
+					field.length < initial_text_buffer ?
+					field.length : initial_text_buffer);
+			break;
+	}
+}
+
+
+PreparedQuery::PreparedQuery(Connection* c, const string& sql, bool te) :
+OptionalExceptions(te),
+conn_(c),
+sql_(sql),
+copacetic_(false)
+{
+	prepare_statement();
+}
+
+
+PreparedQuery::PreparedQuery(const PreparedQuery& other) :
+OptionalExceptions(other.throw_exceptions()),
+conn_(other.conn_),
+sql_(other.sql_),
+params_(other.params_),
+copacetic_(false)
+{
+	// Sharing other's statement would point its result buffers at ours
+	prepare_statement();
+}
+
+
+PreparedQuery&
+PreparedQuery::operator =(const PreparedQuery& rhs)
+{
+	if (this != &rhs) {
+		// Let go of our statement first, so the cache can give it back
+		// to us if it's for the same SQL
+		stmt_ = RefCountedPointer<MYSQL_STMT>();
+		set_exceptions(rhs.throw_exceptions());
+		conn_ = rhs.conn_;
+		sql_ = rhs.sql_;
+		params_ = rhs.params_;
+		error_.clear();
+		prepare_statement();
+	}
+	return *this;
+}
+
+
+PreparedQuery&
+PreparedQuery::bind(unsigned int i, double value)
+{
+	Param& p = param(i);
+	p.bound = true;
+	p.type = MYSQL_TYPE_DOUBLE;
+	p.null_flag = 0;
+	p.number.d = value;
+	return *this;
+}
+
+
+PreparedQuery&
+PreparedQuery::bind(unsigned int i, const char* value)
+{
+	return value ? bind_text(i, MYSQL_TYPE_STRING, value, strlen(value)) :
+			bind_null(i);
+}
+
+
+PreparedQuery&
+PreparedQuery::bind(unsigned int i, const std::string& value)
+{
+	return bind_text(i, MYSQL_TYPE_STRING, value.data(), value.length());
+}
+
+
+PreparedQuery&
+PreparedQuery::bind(unsigned int i, const String& value)
+{
+	return value.is_null() ? bind_null(i) :
+			bind_text(i, MYSQL_TYPE_STRING, value.data(), value.length());
+}
+
+
+PreparedQuery&
+PreparedQuery::bind(unsigned int i, const Date& value)
+{
+	return bind_time(i, MYSQL_TYPE_DATE,
+			DateTime(value.year(), value.month(), value.day(), 0, 0, 0));
+}
+
+
+PreparedQuery&
+PreparedQuery::bind(unsigned int i, const DateTime& value)
+{
+	return bind_time(i, MYSQL_TYPE_DATETIME,
+			value.is_now() ? DateTime(::time(0)) : value);
+}
+
+
+PreparedQuery&
+PreparedQuery::bind(unsigned int i, const Time& value)
+{
+	return bind_time(i, MYSQL_TYPE_TIME, DateTime(0, 0, 0, value.hour(),
+			value.minute(), value.second(), value.microsecond()));
+}
+
+
+PreparedQuery&
+PreparedQuery::bind_blob(unsigned int i, const char* data, size_t length)
+{
+	return bind_text(i, MYSQL_TYPE_BLOB, data, length);
+}
+
+
+PreparedQuery&
+PreparedQuery::bind_integer(unsigned int i, longlong value,
+		bool is_unsigned)
+{
+	Param& p = param(i);
+	p.bound = true;
+	p.type = MYSQL_TYPE_LONGLONG;
+	p.is_unsigned = is_unsigned;
+	p.null_flag = 0;
+	p.number.i = value;
+	return *this;
+}
+
+
+PreparedQuery&
+PreparedQuery::bind_null(unsigned int i)
+{
+	Param& p = param(i);
+	p.bound = true;
+	p.type = MYSQL_TYPE_NULL;
+	p.null_flag = 1;
+	p.data.clear();
+	return *this;
+}
+
+
+bool
+PreparedQuery::bind_results()
+{
+	binds_.assign(columns_.size(), MYSQL_BIND());
+	for (size_t i = 0; i < columns_.size(); ++i) {
+		Column& c = columns_[i];
+		MYSQL_BIND& b = binds_[i];
+		b.buffer_type = c.type;
+		b.is_unsigned = c.is_unsigned;
+		b.is_null = &c.null_flag;
+		b.error = &c.error_flag;
+		switch (c.kind) {
+			case Column::integer:	b.buffer = &c.number.i; break;
+			case Column::real:		b.buffer = &c.number.d; break;
+			case Column::temporal:	b.buffer = &c.time; break;
+			case Column::text:
+				b.buffer = &c.buffer[0];
+				b.buffer_length = static_cast<unsigned long>(c.buffer.size());
+				b.length = &c.length;
+				break;
+		}
+	}
+
+	return binds_.empty() ||
+			conn_->driver()->stmt_bind_result(stmt(), &binds_[0]);
+}
+
+
+PreparedQuery&
+PreparedQuery::bind_text(unsigned int i, enum_field_types type,
+		const char* data, size_t length)
+{
+	Param& p = param(i);
+	p.bound = true;
+	p.type = type;
+	p.null_flag = 0;
+	p.data.assign(data, length);
+	return *this;
+}
+
+
+PreparedQuery&
+PreparedQuery::bind_time(unsigned int i, enum_field_types type,
+		const DateTime& value)
+{
+	Param& p = param(i);
+	p.bound = true;
+	p.type = type;
+	p.null_flag = 0;
+	memset(&p.time, 0, sizeof(p.time));
+	p.time.year = value.year();
+	p.time.month = value.month();
+	p.time.day = value.day();
+	p.time.hour = value.hour();
+	p.time.minute = value.minute();
+	p.time.second = value.second();
+	p.time.second_part = value.microsecond();
+	p.time.time_type = type == MYSQL_TYPE_DATE ? MYSQL_TIMESTAMP_DATE :
+			type == MYSQL_TYPE_TIME ? MYSQL_TIMESTAMP_TIME :
+			MYSQL_TIMESTAMP_DATETIME;
+	return *this;
+}
+
+
+String
+PreparedQuery::cell(size_t col) const
+{
+	const Column& c = column(col);
+	const mysql_type_info& type = metadata_.field_type(int(col));
+	if (c.null_flag) {
+		return String("NULL", 4, type, true);
+	}
+
+	switch (c.kind) {
+		case Column::integer:
+		case Column::real: {
+			ostringstream outs;
+			if (c.kind == Column::real) {
+				outs.precision(c.digits);
+				outs << c.number.d;
+			}
+			else if (c.is_unsigned) {
+				outs << ulonglong(c.number.i);
+			}
+			else {
+				outs << c.number.i;
+			}
+			const string s(outs.str());
+			return String(s.data(), s.length(), type);
+		}
+
+		case Column::temporal: {
+			const MYSQL_TIME& t = c.time;
+			char buf[DateTime::max_length + 1];
+			size_t len;
+			if (c.type == MYSQL_TYPE_DATE) {
+				len = Date(t.year, t.month, t.day).format(buf);
+			}
+			else if (c.type == MYSQL_TYPE_TIME) {
+				// SQL TIME can be negative, and have more than 255
+				// hours, unlike Time, so format those by hand.
+				len = 0;
+				if (t.neg) {
+					buf[len++] = '-';
+				}
+				len += sprintf(buf + len, "%02u:%02u:%02u",
+						t.hour, t.minute, t.second);
+			}
+			else {
+				len = DateTime(t.year, t.month, t.day, t.hour, t.minute,
+						t.second, t.second_part).format(buf);
+			}
+			return String(buf, len, type);
+		}
+
+		default:
+			return String(c.buffer.empty() ? "" : &c.buffer[0], c.length,
+					type);
+	}
+}
+
+
+const PreparedQuery::Column&
+PreparedQuery::column(size_t col) const
+{
+	if (col < columns_.size()) {
+		return columns_[col];
+	}
+	else {
+		throw BadIndex("PreparedQuery", int(col), int(columns_.size()));
+	}
+}
+
+
+int
+PreparedQuery::errnum() const
+{
+	return error_.empty() && stmt() ?
+			conn_->driver()->stmt_errnum(stmt()) : 0;
+}
+
+
+const char*
+PreparedQuery::error() const
+{
+	return error_.empty() && stmt() ?
+			conn_->driver()->stmt_error(stmt()) : error_.c_str();
+}
+
+
+SimpleResult
+PreparedQuery::execute()
+{
+	if (!stmt()) {
+		if (throw_exceptions()) {
+			throw BadQuery(error());
+		}
+		return SimpleResult();
+	}
+
+	// Point a C API parameter list at our values.  The C API copies
+	// this list, so it can go away after we hand it over.
+	vector<MYSQL_BIND> binds(params_.size());
+	for (size_t i = 0; i < params_.size(); ++i) {
+		Param& p = params_[i];
+		if (!p.bound) {
+			ostringstream outs;
+			outs << "No value given for parameter " << i <<
+					" of prepared statement";
+			error_ = outs.str();
+			copacetic_ = false;
+			if (throw_exceptions()) {
+				throw BadParamCount(error_.c_str());
+			}
+			return SimpleResult();
+		}
+
+		MYSQL_BIND& b = binds[i];
+		b.buffer_type = p.type;
+		b.is_unsigned = p.is_unsigned;
+		b.is_null = &p.null_flag;
+		switch (p.type) {
+			case MYSQL_TYPE_NULL:
+				break;
+
+			case MYSQL_TYPE_LONGLONG:
+				b.buffer = &p.number.i;
+				break;
+
+			case MYSQL_TYPE_DOUBLE:
+				b.buffer = &p.number.d;
+				break;
+
+			case MYSQL_TYPE_DATE:
+			case MYSQL_TYPE_DATETIME:
+			case MYSQL_TYPE_TIME:
+				b.buffer = &p.time;
+				break;
+
+			default:
+				b.buffer = const_cast<char*>(p.data.data());
+				b.buffer_length = static_cast<unsigned long>(p.data.length());
+				break;
+		}
+	}
+
+	error_.clear();
+	if (!run(binds)) {
+		if (!stale_statement(conn_->driver()->stmt_errnum(stmt()))) {
+			fail();
+			return SimpleResult();
+		}
+
+		// The server forgot the statement, so it never ran.  Drop it
+		// from the cache, prepare it again, and retry.
+		conn_->driver()->statement_cache().erase(
+				StatementCache::normalize(sql_));
+		if (!prepare_statement()) {
+			return SimpleResult();
+		}
+		else if (!run(binds)) {
+			fail();
+			return SimpleResult();
+		}
+	}
+
+	copacetic_ = true;
+	DBDriver* dbd = conn_->driver();
+	return SimpleResult(true, dbd->stmt_insert_id(stmt()),
+			dbd->stmt_affected_rows(stmt()), dbd->query_info());
+}
+
+
+bool
+PreparedQuery::fail()
+{
+	copacetic_ = false;
+	if (throw_exceptions()) {
+		throw BadQuery(error(), errnum());
+	}
+	return false;
+}
+
+
+bool
+PreparedQuery::fetch()
+{
+	if (!stmt() || binds_.empty()) {
+		return false;
+	}
+
+	DBDriver* dbd = conn_->driver();
+	switch (dbd->stmt_fetch(stmt())) {
+		case 0:						return true;
+		case MYSQL_NO_DATA:			return false;
+		case MYSQL_DATA_TRUNCATED:	break;
+		default:					return fail();
+	}
+
+	// Some text values didn't fit their buffers.  Grow those buffers to
+	// fit, and ask for the values again.
+	for (size_t i = 0; i < columns_.size(); ++i) {
+		Column& c = columns_[i];
+		if (c.kind == Column::text && !c.null_flag &&
+				c.length > c.buffer.size()) {
+			c.buffer.resize(c.length);
+			MYSQL_BIND& b = binds_[i];
+			b.buffer = &c.buffer[0];
+			b.buffer_length = c.length;
+			if (!dbd->stmt_fetch_column(stmt(), &b, unsigned(i), 0)) {
+				return fail();
+			}
+		}
+	}
+
+	// The C API kept pointers to the old buffers
+	return bind_results() || fail();
+}
+
+
+void
+PreparedQuery::get(size_t col, float& value) const
+{
+	const Column& c = column(col);
+	if (c.kind == Column::real && !c.null_flag) {
+		value = float(c.number.d);
+	}
+	else {
+		value = cell(col).conv(float());
+	}
+}
+
+
+void
+PreparedQuery::get(size_t col, double& value) const
+{
+	const Column& c = column(col);
+	if (c.kind == Column::real && !c.null_flag) {
+		value = c.number.d;
+	}
+	else if (c.kind == Column::integer && !c.null_flag) {
+		value = c.is_unsigned ? double(ulonglong(c.number.i)) :
+				double(c.number.i);
+	}
+	else {
+		value = cell(col).conv(double());
+	}
+}
+
+
+void
+PreparedQuery::get(size_t col, std::string& value) const
+{
+	const Column& c = column(col);
+	if (c.kind == Column::text && !c.null_flag) {
+		value.assign(c.buffer.empty() ? "" : &c.buffer[0], c.length);
+	}
+	else {
+		const String s(cell(col));
+		value.assign(s.data(), s.length());
+	}
+}
+
+
+void
+PreparedQuery::get(size_t col, String& value) const
+{
+	value = cell(col);
+}
+
+
+void
+PreparedQuery::get(size_t col, Date& value) const
+{
+	const Column& c = column(col);
+	if (c.type == MYSQL_TYPE_DATE && !c.null_flag) {
+		value = Date(c.time.year, c.time.month, c.time.day);
+	}
+	else {
+		value = cell(col).conv(Date());
+	}
+}
+
+
+void
+PreparedQuery::get(size_t col, DateTime& value) const
+{
+	const Column& c = column(col);
+	if ((c.type == MYSQL_TYPE_DATETIME || c.type == MYSQL_TYPE_TIMESTAMP) &&
+			!c.null_flag) {
+		const MYSQL_TIME& t = c.time;
+		value = DateTime(t.year, t.month, t.day, t.hour, t.minute,
+				t.second, t.second_part);
+	}
+	else {
+		value = cell(col).conv(DateTime());
+	}
+}
+
+
+void
+PreparedQuery::get(size_t col, Time& value) const
+{
+	const Column& c = column(col);
+	if (c.type == MYSQL_TYPE_TIME && !c.null_flag && !c.time.neg &&
+			c.time.hour < 256) {
+		const MYSQL_TIME& t = c.time;
+		value = Time(t.hour, t.minute, t.second, t.second_part);
+	}
+	else {
+		value = cell(col).conv(Time());
+	}
+}
+
+
+ulonglong
+PreparedQuery::num_rows() const
+{
+	return stmt() ? conn_->driver()->stmt_num_rows(stmt()) : 0;
+}
+
+
+bool
+PreparedQuery::prepare_statement()
+{
+	// Reuse the connection's copy of this statement if it has one
+	DBDriver* dbd = conn_->driver();
+	StatementCache& cache = dbd->statement_cache();
+	const string key(StatementCache::normalize(sql_));
+	stmt_ = cache.find(key);
+	if (!stmt()) {
+		stmt_ = dbd->stmt_init();
+		if (!stmt()) {
+			error_ = "Failed to create prepared statement handle";
+			copacetic_ = false;
+			if (throw_exceptions()) {
+				throw BadQuery(error_);
+			}
+			return false;
+		}
+		else if (!dbd->stmt_prepare(stmt(), sql_.data(), sql_.length())) {
+			return fail();
+		}
+		cache.insert(key, stmt_);
+	}
+
+	// Result column descriptions go through the connection's
+	// SchemaCache like any other result set's.  Getting them from the
+	// statement doesn't involve the server.
+	params_.resize(dbd->stmt_param_count(stmt()));
+	columns_.clear();
+	binds_.clear();
+	metadata_ = Metadata();
+	if (MYSQL_RES* res = dbd->stmt_result_metadata(stmt())) {
+		metadata_ = Metadata(res, dbd, throw_exceptions());
+		const MYSQL_FIELD* fields = dbd->fetch_fields(res);
+		const size_t num_fields = metadata_.num_fields();
+		columns_.reserve(num_fields);
+		for (size_t i = 0; i < num_fields; ++i) {
+			columns_.push_back(Column(fields[i]));
+		}
+		dbd->free_result(res);
+	}
+
+	copacetic_ = true;
+	return true;
+}
+
+
+PreparedQuery::Param&
+PreparedQuery::param(unsigned int i)
+{
+	if (i < params_.size()) {
+		return params_[i];
+	}
+	else {
+		throw BadIndex("PreparedQuery parameter", int(i),
+				int(params_.size()));
+	}
+}
+
+
+bool
+PreparedQuery::run(vector<MYSQL_BIND>& binds)
+{
+	// Buffer the result set on the client, so the connection is free
+	// for other queries while the caller walks through it.
+	DBDriver* dbd = conn_->driver();
+	return (binds.empty() || dbd->stmt_bind_param(stmt(), &binds[0])) &&
+			dbd->stmt_execute(stmt()) &&
+			(columns_.empty() ||
+				(bind_results() && dbd->stmt_store_result(stmt())));
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,517 @@
+/// \file prepared_query.h
+/// \brief Declares the PreparedQuery class, which runs server-side
+/// prepared statements through the MySQL binary protocol.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_PREPARED_QUERY_H)
+#define MYSQLPP_PREPARED_QUERY_H
+
+#include "common.h"
+
+#include "datetime.h"
+#include "exceptions.h"
+#include "noexceptions.h"
+#include "null.h"
+#include "raw_row.h"
+#include "refcounted.h"
+#include "result.h"
+#include "statement_cache.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Make Doxygen ignore this
+class MYSQLPP_EXPORT Connection;
+#endif
+
+
+/// \brief A server-side prepared statement
+///
+/// Query sends its SQL to the server as text: every parameter gets
+/// turned into a string, escaped, and parsed again by the server each
+/// time, and every value in the result comes back as text for
+/// String::conv() to parse.  This class uses the C API's \c MYSQL_STMT
+/// interface instead.  The server parses the statement once, in the
+/// ctor, and after that each execute() sends only the parameter values,
+/// in binary form.  Result columns come back the same way: integers,
+/// floating-point numbers and dates land in typed buffers, and only
+/// text and other columns without a C++ counterpart stay as text.
+///
+/// Get one from Connection::prepare():
+///
+/// \code
+/// mysqlpp::PreparedQuery pq = conn.prepare(
+///         "select item, num, weight from stock where id = ?");
+/// for (int id = 1; id <= 10; ++id) {
+///     pq.bind(0, id).execute();
+///     while (pq.fetch()) {
+///         std::string item = pq.get<std::string>(0);
+///         int num = pq.get<int>(1);
+///         ...
+///     }
+/// }
+/// \endcode
+///
+/// Parameters keep their values between executions, so you only need
+/// to rebind the ones that change.  execute() buffers the whole result
+/// set on the client, like Query::store(), so you can run other
+/// queries on the connection while walking through it.
+///
+/// The get() conversions give the same results as String::conv()
+/// would on the text form of the value: a SQL null read into a type
+/// that can't hold it throws BadConversion, unless you read it into a
+/// Null<T>; and a number that doesn't fit the type you ask for is
+/// handled like the same number in text form.
+///
+/// Statements come from the connection's StatementCache when it has
+/// them, so preparing the same SQL again is cheap.  If the server has
+/// forgotten the statement by the time you execute() it, as after the
+/// C API reconnects on its own, this prepares it again and retries.
+///
+/// Other PreparedQuery objects for the same SQL on the same connection
+/// don't share this one's server-side statement: while this object
+/// holds it, preparing the SQL again gets a statement of its own, so
+/// each object keeps its own result set.  The same goes for copies of
+/// a PreparedQuery.  As with Connection, don't share one among threads
+/// without your own locking.
+
+class MYSQLPP_EXPORT PreparedQuery : public OptionalExceptions
+{
+private:
+	/// \brief Pointer to bool data member, for use by safe bool
+	/// conversion operator.
+	///
+	/// \see http://www.artima.com/cppsource/safebool.html
+	typedef bool PreparedQuery::*private_bool_type;
+
+public:
+	/// \brief Prepare a statement on the given connection, or reuse
+	/// one from its StatementCache
+	///
+	/// \param c connection to prepare the statement on
+	/// \param sql SQL statement, with \c ? for each parameter
+	/// \param te if true, throw exceptions on errors
+	///
+	/// \throw BadQuery if the server rejects the statement, and
+	/// exceptions are enabled.  Otherwise, test the object in bool
+	/// context to find out whether preparation succeeded.
+	///
+	/// You normally call Connection::prepare() instead.
+	PreparedQuery(Connection* c, const std::string& sql, bool te = true);
+
+	/// \brief Create an object for the same SQL as \c other, with the
+	/// same parameter values
+	///
+	/// The copy gets a statement of its own, so it doesn't disturb
+	/// \c other's result set.  It has no result set until you
+	/// execute() it.
+	///
+	/// \throw BadQuery if preparing the copy's statement fails, and
+	/// exceptions are enabled
+	PreparedQuery(const PreparedQuery& other);
+
+	/// \brief Make this object a copy of \c rhs
+	///
+	/// This drops our statement and result set, and gets a statement
+	/// of our own for \c rhs's SQL, as the copy constructor does.
+	PreparedQuery& operator =(const PreparedQuery& rhs);
+
+	/// \brief Set a parameter to a boolean value
+	PreparedQuery& bind(unsigned int i, bool value)
+			{ return bind_integer(i, value, true); }
+
+	/// \brief Set a parameter to a \c short \c int value
+	PreparedQuery& bind(unsigned int i, short value)
+			{ return bind_integer(i, value, false); }
+
+	/// \brief Set a parameter to an \c unsigned \c short \c int value
+	PreparedQuery& bind(unsigned int i, unsigned short value)
+			{ return bind_integer(i, value, true); }
+
+	/// \brief Set a parameter to an \c int value
+	PreparedQuery& bind(unsigned int i, int value)
+			{ return bind_integer(i, value, false); }
+
+	/// \brief Set a parameter to an \c unsigned \c int value
+	PreparedQuery& bind(unsigned int i, unsigned int value)
+			{ return bind_integer(i, value, true); }
+
+	/// \brief Set a parameter to a \c long \c int value
+	PreparedQuery& bind(unsigned int i, long value)
+			{ return bind_integer(i, value, false); }
+
+	/// \brief Set a parameter to an \c unsigned \c long \c int value
+	PreparedQuery& bind(unsigned int i, unsigned long value)
+			{ return bind_integer(i, value, true); }
+
+	/// \brief Set a parameter to a \c longlong value
+	PreparedQuery& bind(unsigned int i, longlong value)
+			{ return bind_integer(i, value, false); }
+
+	/// \brief Set a parameter to a \c ulonglong value
+	PreparedQuery& bind(unsigned int i, ulonglong value)
+			{ return bind_integer(i, longlong(value), true); }
+
+	/// \brief Set a parameter to a \c float value
+	PreparedQuery& bind(unsigned int i, float value)
+			{ return bind(i, double(value)); }
+
+	/// \brief Set a parameter to a \c double value
+	PreparedQuery& bind(unsigned int i, double value);
+
+	/// \brief Set a parameter to a C string
+	PreparedQuery& bind(unsigned int i, const char* value);
+
+	/// \brief Set a parameter to a string
+	PreparedQuery& bind(unsigned int i, const std::string& value);
+
+	/// \brief Set a parameter to a String's value, or to SQL null if
+	/// the String is null
+	PreparedQuery& bind(unsigned int i, const String& value);
+
+	/// \brief Set a parameter to a date
+	PreparedQuery& bind(unsigned int i, const Date& value);
+
+	/// \brief Set a parameter to a date and time
+	///
+	/// A DateTime set to "now" gets the client's current time, since
+	/// a parameter can't be the SQL \c NOW() function.
+	PreparedQuery& bind(unsigned int i, const DateTime& value);
+
+	/// \brief Set a parameter to a time
+	PreparedQuery& bind(unsigned int i, const Time& value);
+
+	/// \brief Set a parameter to a nullable value
+	template <class T, class B>
+	PreparedQuery& bind(unsigned int i, const Null<T, B>& value)
+	{
+		return value.is_null ? bind_null(i) : bind(i, value.data);
+	}
+
+	/// \brief Set a parameter to a block of binary data
+	///
+	/// Unlike the string overloads of bind(), this sends the data as a
+	/// \c BLOB, so the server doesn't apply character set conversions.
+	PreparedQuery& bind_blob(unsigned int i, const char* data, size_t length);
+
+	/// \brief Set a parameter to SQL null
+	PreparedQuery& bind_null(unsigned int i);
+
+	/// \brief Return the server's error code for the last failure
+	int errnum() const;
+
+	/// \brief Return the server's error message for the last failure
+	const char* error() const;
+
+	/// \brief Run the statement with the current parameter values
+	///
+	/// If the statement returns rows, call fetch() to walk through
+	/// them.
+	///
+	/// \throw BadParamCount if a parameter hasn't been given a value,
+	/// and BadQuery if the server reports an error.  With exceptions
+	/// disabled, the returned object is false in bool context instead.
+	SimpleResult execute();
+
+	/// \brief Move to the next row of the result set from the last
+	/// execute()
+	///
+	/// \retval false if there are no more rows, or on error when
+	/// exceptions are disabled
+	///
+	/// \throw BadQuery if the C API reports an error
+	bool fetch();
+
+	/// \brief Convert a column of the current row to the type of
+	/// \c value
+	///
+	/// This is the general case, for types with no binary conversion
+	/// below.  It converts the column's text form with String::conv().
+	///
+	/// \throw BadIndex if there is no column \c col
+	template <class T>
+	void get(size_t col, T& value) const
+	{
+		value = cell(col).conv(T());
+	}
+
+	/// \brief Convert a column of the current row to a nullable value
+	template <class T, class B>
+	void get(size_t col, Null<T, B>& value) const
+	{
+		if (is_null(col)) {
+			value = null;
+		}
+		else {
+			T v;
+			get(col, v);
+			value = v;
+		}
+	}
+
+#if !defined(DOXYGEN_IGNORE)
+	// Doxygen will not generate documentation for this section.
+	void get(size_t col, bool& value) const { get_integer(col, value); }
+	void get(size_t col, short& value) const { get_integer(col, value); }
+	void get(size_t col, unsigned short& value) const
+			{ get_integer(col, value); }
+	void get(size_t col, int& value) const { get_integer(col, value); }
+	void get(size_t col, unsigned int& value) const
+			{ get_integer(col, value); }
+	void get(size_t col, long& value) const { get_integer(col, value); }
+	void get(size_t col, unsigned long& value) const
+			{ get_integer(col, value); }
+	void get(size_t col, longlong& value) const { get_integer(col, value); }
+	void get(size_t col, ulonglong& value) const
+			{ get_integer(col, value); }
+	void get(size_t col, float& value) const;
+	void get(size_t col, double& value) const;
+	void get(size_t col, std::string& value) const;
+	void get(size_t col, String& value) const;
+	void get(size_t col, Date& value) const;
+	void get(size_t col, DateTime& value) const;
+	void get(size_t col, Time& value) const;
+#endif // !defined(DOXYGEN_IGNORE)
+
+	/// \brief Return a column of the current row, converted to type T
+	///
+	/// Use as \c pq.get<int>(0).
+	template <class T>
+	T get(size_t col) const
+	{
+		T value;
+		get(col, value);
+		return value;
+	}
+
+	/// \brief Returns true if a column of the current row is SQL null
+	///
+	/// \throw BadIndex if there is no column \c col
+	bool is_null(size_t col) const { return column(col).null_flag != 0; }
+
+	/// \brief Return the description of the statement's result columns
+	///
+	/// This is empty if the statement doesn't return rows.
+	const ResultBase& metadata() const { return metadata_; }
+
+	/// \brief Return the number of columns the statement returns
+	size_t num_fields() const { return columns_.size(); }
+
+	/// \brief Return the number of parameters in the statement
+	size_t num_params() const { return params_.size(); }
+
+	/// \brief Return the number of rows in the result set from the
+	/// last execute()
+	ulonglong num_rows() const;
+
+	/// \brief Test whether the statement was prepared without error
+	operator private_bool_type() const
+	{
+		return stmt_ && copacetic_ ? &PreparedQuery::copacetic_ : 0;
+	}
+
+	/// \brief Run the statement and put the rows it returns into a
+	/// sequence container of SSQLS objects
+	///
+	/// Each SSQLS is filled from the binary result buffers through a
+	/// RawRow, the same way Query::storein() fills them from text rows.
+	template <class Sequence>
+	void storein(Sequence& con)
+	{
+		typedef typename Sequence::value_type T;
+		if (!execute()) {
+			return;
+		}
+
+		const RawRow::ColumnMap columns(T::raw_columns(metadata_));
+		const RawRow raw(metadata_, columns, *this);
+		while (fetch()) {
+			con.push_back(T());
+			try {
+				con.back().set(raw);
+			}
+			catch (...) {
+				con.pop_back();
+				throw;
+			}
+		}
+	}
+
+private:
+#if MYSQL_VERSION_ID >= 80001 && !defined(MARIADB_BASE_VERSION) && \
+		!defined(MARIADB_PACKAGE_VERSION)
+	typedef bool bind_bool;		///< C API's flag type in MYSQL_BIND
+#else
+	typedef my_bool bind_bool;	///< C API's flag type in MYSQL_BIND
+#endif
+
+	/// \brief A parameter value, in the form MYSQL_BIND points to
+	struct Param {
+		bool bound;					///< true once given a value
+		enum_field_types type;		///< C API buffer type
+		bool is_unsigned;			///< for integer types
+		bind_bool null_flag;		///< true if SQL null
+		union {
+			longlong i;
+			double d;
+		} number;					///< value of numeric types
+		MYSQL_TIME time;			///< value of date and time types
+		std::string data;			///< value of string and blob types
+
+		Param();
+	};
+
+	/// \brief A result column's fetch buffer
+	struct Column {
+		/// \brief The form we ask the C API to give the column in
+		enum Kind { integer, real, temporal, text } kind;
+
+		enum_field_types type;		///< C API buffer type
+		bool is_unsigned;			///< for integer columns
+		bind_bool null_flag;		///< true if the value is SQL null
+		bind_bool error_flag;		///< true if the value was truncated
+		unsigned long length;		///< length of the value, if text
+		union {
+			longlong i;
+			double d;
+		} number;					///< value of numeric columns
+		MYSQL_TIME time;			///< value of date and time columns
+		std::vector<char> buffer;	///< value of text columns
+		int digits;					///< precision of floating-point text
+
+		Column(const MYSQL_FIELD& field);
+	};
+
+	/// \brief ResultBase can only be built by subclasses; this is the
+	/// one that holds our result column descriptions.
+	class Metadata : public ResultBase
+	{
+	public:
+		Metadata() { }
+		Metadata(MYSQL_RES* res, DBDriver* dbd, bool te) :
+		ResultBase(res, dbd, te)
+		{
+		}
+		Metadata(const Metadata& other) : ResultBase(other) { }
+		Metadata& operator =(const Metadata& rhs)
+				{ copy(rhs); return *this; }
+	};
+
+	/// \brief Common part of the integer bind() overloads
+	PreparedQuery& bind_integer(unsigned int i, longlong value,
+			bool is_unsigned);
+
+	/// \brief Common part of the date and time bind() overloads
+	PreparedQuery& bind_time(unsigned int i, enum_field_types type,
+			const DateTime& value);
+
+	/// \brief Common part of the string bind() overloads
+	PreparedQuery& bind_text(unsigned int i, enum_field_types type,
+			const char* data, size_t length);
+
+	/// \brief Point the statement at our result buffers
+	bool bind_results();
+
+	/// \brief Get a prepared statement for sql_, and set up our
+	/// parameter and result column lists to match it
+	bool prepare_statement();
+
+	/// \brief Bind parameters, run the statement, and buffer its
+	/// results, without reporting errors
+	bool run(std::vector<MYSQL_BIND>& binds);
+
+	/// \brief Return a column's text form as a String
+	String cell(size_t col) const;
+
+	/// \brief Return a result column, or throw BadIndex
+	const Column& column(size_t col) const;
+
+	/// \brief Report a C API error on the statement
+	///
+	/// \return false, for the convenience of callers
+	bool fail();
+
+	/// \brief Convert an integer column to an integral C++ type,
+	/// going through text only if it doesn't fit
+	template <class T>
+	void get_integer(size_t col, T& value) const
+	{
+		typedef std::numeric_limits<T> limits;
+		const Column& c = column(col);
+		if (c.kind == Column::integer && !c.null_flag) {
+			const longlong i = c.number.i;
+			if ((c.is_unsigned || i >= 0) ?
+					ulonglong(i) <= ulonglong(limits::max()) :
+					limits::is_signed && i >= longlong(limits::min())) {
+				value = static_cast<T>(i);
+				return;
+			}
+		}
+		value = cell(col).conv(T());
+	}
+
+	/// \brief Return a parameter, or throw BadIndex
+	Param& param(unsigned int i);
+
+	/// \brief Return the C API statement handle
+	MYSQL_STMT* stmt() const
+			{ return const_cast<MYSQL_STMT*>(stmt_.raw()); }
+
+	Connection* conn_;				///< connection we were prepared on
+	std::string sql_;				///< the statement, for re-preparing it
+	RefCountedPointer<MYSQL_STMT> stmt_;	///< the C API statement
+	std::vector<Param> params_;		///< parameter values
+	std::vector<Column> columns_;	///< current row's column values
+	std::vector<MYSQL_BIND> binds_;	///< C API view of columns_
+	Metadata metadata_;				///< result column descriptions
+	bool copacetic_;				///< false if the last operation failed
+	std::string error_;				///< our own error, if not the C API's
+};
+
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+
+namespace internal {
+
+// Reads a column from a PreparedQuery's result buffers for RawRow
+template <class T>
+void
+get_bound(const PreparedQuery& pq, int col, T& value)
+{
+	pq.get(size_t(col), value);
+}
+
+} // end namespace internal
+
+#endif // !defined(DOXYGEN_IGNORE)
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_PREPARED_QUERY_H)
@@ -32,6 +32,16 @@ using namespace std;
 
 namespace mysqlpp {
 
+// Find the position of the named parameter in the query's template.
+// Unknown names have always meant position 0.
+static size_t
+position(const Query* q, const char* name)
+{
+	short n = q->query_template().index(name);
+	return n < 0 ? 0 : n;
+}
+
+
 size_t
 SQLQueryParms::escape_string(std::string* ps, const char* original,
 		size_t length) const
@@ -50,7 +60,7 @@ SQLTypeAdapter&
 SQLQueryParms::operator [](const char* str)
 {
 	if (parent_) {
-		return operator [](parent_->parsed_nums_[str]);
+		return operator [](position(parent_, str));
 	}
 	throw ObjectNotInitialized("SQLQueryParms object has no parent!");
 }
@@ -59,7 +69,7 @@ const SQLTypeAdapter&
 SQLQueryParms::operator[] (const char* str) const
 {
 	if (parent_) {
-		return operator [](parent_->parsed_nums_[str]);
+		return operator [](position(parent_, str));
 	}
 	throw ObjectNotInitialized("SQLQueryParms object has no parent!");
 }
@@ -77,6 +77,15 @@ public:
 	/// \brief Clears the list
 	void clear() { erase(begin(), end()); }
 
+	/// \brief Exchange parameter values with another list
+	///
+	/// Each list stays bound to its own Query object.
+	void swap(SQLQueryParms& other)
+	{
+		std::vector<SQLTypeAdapter>::swap(other);
+		std::swap(processing_, other.processing_);
+	}
+
 	/// \brief Indirect access to Query::escape_string()
 	///
 	/// \internal Needed by \c operator<<(Manip&, \c const \c T&) where
@@ -32,6 +32,18 @@
 
 namespace mysqlpp {
 
+// Override any global locale setting on the given stream; we want to
+// use the classic C locale so we don't get weird things like thousands
+// separators in integers inserted into the query stream.  Imbuing a
+// stream isn't free, so skip it when there's nothing to override.
+static void
+use_classic_locale(std::ostream& os)
+{
+	if (std::locale() != std::locale::classic()) {
+		os.imbue(std::locale::classic());
+	}
+}
+
 // Force insertfrom() policy template instantiation.  Required to make 
 // VC++ happy.
 Query::RowCountInsertPolicy<Transaction> RowCountInsertPolicyI(0);
@@ -48,21 +60,19 @@ std::ostream(0),
 OptionalExceptions(te),
 template_defaults(this),
 conn_(c),
-copacetic_(true)
+copacetic_(true),
+store_mode_(StoreQueryResult::sm_cells),
+store_budget_(0)
 {
-	// Set up our internal IOStreams string buffer
-	init(&sbuffer_);
+	// Set up our internal IOStreams buffer
+	init(&writer_);
+	use_classic_locale(*this);
+	internal::mark_sql_sink(*this, internal::query_sink);
 
-	// Insert passed query string into our string buffer, if given
+	// Insert passed query string into our buffer, if given
 	if (qstr) {
-		sbuffer_.str(qstr);
-		seekp(0, std::ios::end);	// allow more insertions at end
+		writer_.append(qstr);
 	} 
-
-	// Override any global locale setting; we want to use the classic C
-	// locale so we don't get weird things like thousands separators in
-	// integers inserted into the query stream.
-	imbue(std::locale::classic());
 }
 
 Query::Query(const Query& q) :
@@ -74,17 +84,42 @@ std::ostream(0),
 #endif
 OptionalExceptions(q.throw_exceptions())
 {
-	// Set up our internal IOStreams string buffer
-	init(&sbuffer_);
-
-	// See above for reason we override locale for Query streams.
-	imbue(std::locale::classic());
+	// Set up our internal IOStreams buffer
+	init(&writer_);
+	use_classic_locale(*this);
+	internal::mark_sql_sink(*this, internal::query_sink);
 
 	// Copy the other query as best we can
 	operator =(q);
 }
 
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+Query::Query(Query&& q) :
+#if defined(MYSQLPP_HAVE_STD__NOINIT)
+// ditto above
+std::ostream(std::_Noinit),
+#else
+std::ostream(0),
+#endif
+OptionalExceptions(q.throw_exceptions()),
+template_defaults(this),
+conn_(0),
+copacetic_(true),
+store_mode_(StoreQueryResult::sm_cells),
+store_budget_(0)
+{
+	// Set up our internal IOStreams buffer
+	init(&writer_);
+	use_classic_locale(*this);
+	internal::mark_sql_sink(*this, internal::query_sink);
+
+	// Take the other query's state, leaving it with our blank slate
+	swap(q);
+}
+#endif
+
+
 ulonglong
 Query::affected_rows()
 {
@@ -92,6 +127,13 @@ Query::affected_rows()
 }
 
 
+size_t
+Query::effective_store_budget() const
+{
+	return store_budget_ ? store_budget_ : conn_->store_budget();
+}
+
+
 int
 Query::errnum() const
 {
@@ -106,6 +148,13 @@ Query::error() const
 }
 
 
+DBDriver*
+Query::escape_driver() const
+{
+	return conn_ && *conn_ ? conn_->driver() : 0;
+}
+
+
 size_t
 Query::escape_string(std::string* ps, const char* original,
 		size_t length) const
@@ -143,7 +192,7 @@ Query::exec(const std::string& str)
 {
 	if ((copacetic_ = conn_->driver()->execute(str.data(),
 			static_cast<unsigned long>(str.length()))) == true) {
-		if (parse_elems_.size() == 0) {
+		if (template_.empty()) {
 			// Not a template query, so auto-reset
 			reset();
 		}
@@ -161,8 +210,7 @@ Query::exec(const std::string& str)
 SimpleResult 
 Query::execute() 
 { 
-	AutoFlag<> af(template_defaults.processing_);
-	return execute(str(template_defaults)); 
+	return execute(template_defaults); 
 }
 
 
@@ -170,14 +218,18 @@ SimpleResult
 Query::execute(SQLQueryParms& p)
 {
 	AutoFlag<> af(template_defaults.processing_);
-	return execute(str(p));
+	if (!template_.empty()) {
+		proc(p);
+	}
+
+	return execute(writer_.data(), writer_.length());
 }
 
 
 SimpleResult
 Query::execute(const SQLTypeAdapter& s)
 {
-	if ((parse_elems_.size() == 2) && !template_defaults.processing_) {
+	if ((template_.elements().size() == 2) && !template_defaults.processing_) {
 		// We're a template query and this isn't a recursive call, so
 		// take s to be a lone parameter for the query.  We will come
 		// back in here with a completed query, but the processing_
@@ -195,7 +247,7 @@ Query::execute(const SQLTypeAdapter& s)
 SimpleResult
 Query::execute(const char* str, size_t len)
 {
-	if ((parse_elems_.size() == 2) && !template_defaults.processing_) {
+	if ((template_.elements().size() == 2) && !template_defaults.processing_) {
 		// We're a template query and this isn't a recursive call, so
 		// take s to be a lone parameter for the query.  We will come
 		// back in here with a completed query, but the processing_
@@ -204,7 +256,7 @@ Query::execute(const char* str, size_t len)
 		return execute(SQLQueryParms() << str << len );
 	}
 	if ((copacetic_ = conn_->driver()->execute(str, len)) == true) {
-		if (parse_elems_.size() == 0) {
+		if (template_.empty()) {
 			// Not a template query, so auto-reset
 			reset();
 		}
@@ -247,15 +299,24 @@ Query::operator=(const Query& rhs)
 	template_defaults = rhs.template_defaults;
 	conn_ = rhs.conn_;
 	copacetic_ = rhs.copacetic_;
+	store_mode_ = rhs.store_mode_;
+	store_budget_ = rhs.store_budget_;
+
+	writer_ = rhs.writer_;
 
-	*this << rhs.sbuffer_.str();
+	template_ = rhs.template_;
 
-	parse_elems_  = rhs.parse_elems_;
-	parsed_names_ = rhs.parsed_names_;
-	parsed_nums_  = rhs.parsed_nums_;
+	return *this;
+}
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+Query&
+Query::operator=(Query&& rhs)
+{
+	swap(rhs);
 	return *this;
 }
+#endif
 
 Query::operator void*() const
 {
@@ -266,159 +327,53 @@ Query::operator void*() const
 void
 Query::parse()
 {
-	std::string str = "";
-	char num[4];
-	std::string name;
-
-	char* s = new char[sbuffer_.str().size() + 1];
-	memcpy(s, sbuffer_.str().data(), sbuffer_.str().size());
-	s[sbuffer_.str().size()] = '\0';
-	const char* s0 = s;
-
-	while (*s) {
-		if (*s == '%') {
-			// Following might be a template parameter declaration...
-			s++;
-			if (*s == '%') {
-				// Doubled percent sign, so insert literal percent sign.
-				str += *s++;
-			}
-			else if (isdigit(*s)) {
-				// Number following percent sign, so it signifies a
-				// positional parameter.  First step: find position
-				// value, up to 3 digits long.
-				num[0] = *s;
-				s++;
-				if (isdigit(*s)) {
-					num[1] = *s;
-					num[2] = 0;
-					s++;
-					if (isdigit(*s)) {
-						num[2] = *s;
-						num[3] = 0;
-						s++;
-					}
-					else {
-						num[2] = 0;
-					}
-				}
-				else {
-					num[1] = 0;
-				}
-				signed char n = atoi(num);
-
-				// Look for option character following position value.
-				char option = ' ';
-				if (*s == 'q' || *s == 'Q') {
-					option = *s++;
-				}
-
-				// Is it a named parameter?
-				if (*s == ':') {
-					// Save all alphanumeric and underscore characters
-					// following colon as parameter name.
-					s++;
-					for (/* */; isalnum(*s) || *s == '_'; ++s) {
-						name += *s;
-					}
-
-					// Eat trailing colon, if it's present.
-					if (*s == ':') {
-						s++;
-					}
-
-					// Update maps that translate parameter name to
-					// number and vice versa.
-					if (n >= static_cast<short>(parsed_names_.size())) {
-						parsed_names_.insert(parsed_names_.end(),
-								static_cast<std::vector<std::string>::size_type>(
-										n + 1) - parsed_names_.size(),
-								std::string());
-					}
-					parsed_names_[n] = name;
-					parsed_nums_[name] = n;
-				}
-
-				// Finished parsing parameter; save it.
-				parse_elems_.push_back(SQLParseElement(str, option, n));
-				str = "";
-				name = "";
-			}
-			else {
-				// Insert literal percent sign, because sign didn't
-				// precede a valid parameter string; this allows users
-				// to play a little fast and loose with the rules,
-				// avoiding a double percent sign here.
-				str += '%';
-			}
-		}
-		else {
-			// Regular character, so just copy it.
-			str += *s++;
-		}
-	}
-
-	parse_elems_.push_back(SQLParseElement(str, ' ', -1));
-	delete[] s0;
+	template_ = QueryTemplate(writer_.data(), writer_.length());
 }
 
 
-SQLTypeAdapter*
-Query::pprepare(char option, SQLTypeAdapter& S, bool replace)
+void
+Query::append_param(char option, const SQLTypeAdapter& S)
 {
 	if (S.is_processed()) {
-		return &S;
-	}
-
-	if (option == 'q') {
-		std::string temp(S.quote_q() ? "'" : "", S.quote_q() ? 1 : 0);
-
-		if (S.escape_q()) {
-			char *escaped = new char[S.size() * 2 + 1];
-			size_t len = conn_->driver()->escape_string(escaped,
-					S.data(), static_cast<unsigned long>(S.size()));
-			temp.append(escaped, len);
-			delete[] escaped;
+		writer_.append(S.data(), S.length());
+	}
+	else if (option == 'q') {
+		// proc() reserved room for the worst case, so escaping
+		// straight into the buffer doesn't reallocate.
+		DBDriver* driver = escape_driver();
+		if (S.quote_q() && S.escape_q()) {
+			writer_.append_quoted(S.data(), S.length(), driver);
 		}
-		else {
-			temp.append(S.data(), S.length());
+		else if (S.escape_q()) {
+			writer_.append_escaped(S.data(), S.length(), driver);
 		}
-
-		if (S.quote_q()) temp.append("'", 1);
-
-		SQLTypeAdapter* ss = new SQLTypeAdapter(temp);
-
-		if (replace) {
-			S = *ss;
-			S.set_processed();
-			delete ss;
-			return &S;
+		else if (S.quote_q()) {
+			writer_.append('\'').append(S.data(), S.length()).append('\'');
 		}
 		else {
-			return ss;
+			writer_.append(S.data(), S.length());
 		}
 	}
 	else if (option == 'Q' && S.quote_q()) {
-		std::string temp("'", 1);
-		temp.append(S.data(), S.length());
-		temp.append("'", 1);
-		SQLTypeAdapter *ss = new SQLTypeAdapter(temp);
-
-		if (replace) {
-			S = *ss;
-			S.set_processed();
-			delete ss;
-			return &S;
-		}
-		else {
-			return ss;
-		}
+		writer_.append('\'').append(S.data(), S.length()).append('\'');
 	}
 	else {
-		if (replace) {
-			S.set_processed();
-		}
-		return &S;
+		writer_.append(S.data(), S.length());
+	}
+}
+
+
+SQLQueryParms*
+Query::param_source(SQLQueryParms& p, size_t num)
+{
+	if (num < p.size()) {
+		return &p;
+	}
+	else if (num < template_defaults.size()) {
+		return &template_defaults;
+	}
+	else {
+		return 0;
 	}
 }
 
@@ -426,52 +381,79 @@ Query::pprepare(char option, SQLTypeAdapter& S, bool replace)
 void
 Query::proc(SQLQueryParms& p)
 {
-	sbuffer_.str("");
+	const QueryTemplate::Elements& elems = template_.elements();
+	QueryTemplate::Elements::const_iterator i;
+
+	// Reserve room for the literal text plus each parameter as it would
+	// be if every byte needed escaping, so the query gets built in one
+	// pass without reallocating.  writer_ keeps its capacity from one
+	// call to the next, so usually this doesn't allocate at all.
+	size_t size = template_.literal_length();
+	for (i = elems.begin(); i != elems.end(); ++i) {
+		SQLQueryParms* c = i->num >= 0 ? param_source(p, i->num) : 0;
+		if (c) {
+			const SQLTypeAdapter& param = (*c)[i->num];
+			size += param.is_null() ? 4 :
+					param.is_processed() ? param.length() :
+					i->option == 'q' ? param.length() * 2 + 3 :
+					param.length() + 2;
+		}
+	}
+	writer_.clear();
+	writer_.reserve(size);
 
-	for (std::vector<SQLParseElement>::iterator i = parse_elems_.begin();
-			i != parse_elems_.end(); ++i) {
-		MYSQLPP_QUERY_THISPTR << i->before;
+	for (i = elems.begin(); i != elems.end(); ++i) {
+		writer_.append(i->before);
 		int num = i->num;
 		if (num >= 0) {
-			SQLQueryParms* c;
-			if (size_t(num) < p.size()) {
-				c = &p;
-			}
-			else if (size_t(num) < template_defaults.size()) {
-				c = &template_defaults;
-			}
-			else {
-				*this << " ERROR";
+			SQLQueryParms* c = param_source(p, num);
+			if (!c) {
+				writer_.append(" ERROR", 6);
 				throw BadParamCount(
 						"Not enough parameters to fill the template.");
 			}
 
 			SQLTypeAdapter& param = (*c)[num];
 			if (param.is_null()) {
-				MYSQLPP_QUERY_THISPTR << "NULL";
+				writer_.append("NULL", 4);
 			}
-			else {
-				SQLTypeAdapter* ss = pprepare(i->option, param, c->bound());
-				MYSQLPP_QUERY_THISPTR << *ss;
-				if (ss != &param) {
-					// pprepare() returned a new string object instead of
-					// updating param in place, so we need to delete it.
-					delete ss;
+			else if (c->bound() && !param.is_processed()) {
+				// Parameter belongs to a Query, so it may be used again.
+				// Save the quoted and escaped form so we needn't redo it.
+				size_t start = writer_.length();
+				append_param(i->option, param);
+				if (i->option == 'q' ||
+						(i->option == 'Q' && param.quote_q())) {
+					param = SQLTypeAdapter(std::string(
+							writer_.data() + start, writer_.length() - start));
 				}
+				param.set_processed();
+			}
+			else {
+				append_param(i->option, param);
 			}
 		}
 	}
 }
 
 
+void
+Query::query_template(const QueryTemplate& t)
+{
+	clear();
+	writer_.clear();
+
+	template_ = t;
+}
+
+
 void
 Query::reset()
 {
-	seekp(0);
 	clear();
-	sbuffer_.str("");
+	writer_.clear();
 
-	parse_elems_.clear();
+	template_ = QueryTemplate();
 	template_defaults.clear();
 }
 
@@ -483,62 +465,107 @@ Query::result_empty()
 }
 
 
-StoreQueryResult 
-Query::store() 
-{ 
-	AutoFlag<> af(template_defaults.processing_);
-	return store(str(template_defaults)); 
-}
+// Functors that make the result object for each flavor of store(),
+// for Query::store_as().  streams() says whether to read the result
+// set a row at a time with use_result(), rather than letting the C API
+// read it all into memory first with store_result().
+struct StoreBuilder
+{
+	typedef StoreQueryResult result_type;
 
+	StoreBuilder(StoreQueryResult::storage_mode sm, size_t budget) :
+	sm_(sm),
+	budget_(budget)
+	{
+	}
 
-StoreQueryResult
-Query::store(SQLQueryParms& p)
+	// With a memory budget, StoreQueryResult reads the rows itself so
+	// it can stop as soon as it goes over.
+	bool streams() const { return budget_ != 0; }
+
+	result_type operator()(MYSQL_RES* res, DBDriver* dbd, bool te) const
+			{ return StoreQueryResult(res, dbd, te, sm_, budget_); }
+
+	StoreQueryResult::storage_mode sm_;
+	size_t budget_;
+};
+
+struct ColumnarBuilder
+{
+	typedef ColumnarResult result_type;
+
+	bool streams() const { return false; }
+
+	result_type operator()(MYSQL_RES* res, DBDriver* dbd, bool te) const
+			{ return ColumnarResult(res, dbd, te); }
+};
+
+struct MappedBuilder
+{
+	typedef MappedResult result_type;
+
+	// MappedResult writes the rows to disk as they arrive
+	bool streams() const { return true; }
+
+	result_type operator()(MYSQL_RES* res, DBDriver* dbd, bool te) const
+			{ return MappedResult(res, dbd, te); }
+};
+
+
+template <class Builder>
+typename Builder::result_type
+Query::store_as(const Builder& build, SQLQueryParms& p)
 {
 	AutoFlag<> af(template_defaults.processing_);
-	return store(str(p));
+	if (!template_.empty()) {
+		proc(p);
+	}
+
+	return store_as(build, writer_.data(), writer_.length());
 }
 
 
-StoreQueryResult
-Query::store(const SQLTypeAdapter& s)
+template <class Builder>
+typename Builder::result_type
+Query::store_as(const Builder& build, const SQLTypeAdapter& s)
 {
-	if ((parse_elems_.size() == 2) && !template_defaults.processing_) {
+	if ((template_.elements().size() == 2) && !template_defaults.processing_) {
 		// We're a template query and this isn't a recursive call, so
 		// take s to be a lone parameter for the query.  We will come
 		// back in here with a completed query, but the processing_
 		// flag will be set, allowing us to avoid an infinite loop.
 		AutoFlag<> af(template_defaults.processing_);
-		return store(SQLQueryParms() << s);
+		return store_as(build, SQLQueryParms() << s);
 	}
 	else {
 		// Take s to be the entire query string
-		return store(s.data(), s.length());
+		return store_as(build, s.data(), s.length());
 	}
 }
 
 
-StoreQueryResult
-Query::store(const char* str, size_t len)
+template <class Builder>
+typename Builder::result_type
+Query::store_as(const Builder& build, const char* str, size_t len)
 {
-	if ((parse_elems_.size() == 2) && !template_defaults.processing_) {
-		// We're a template query and this isn't a recursive call, so
-		// take s to be a lone parameter for the query.  We will come
-		// back in here with a completed query, but the processing_
-		// flag will be set, allowing us to avoid an infinite loop.
+	if ((template_.elements().size() == 2) && !template_defaults.processing_) {
+		// See comments in store_as(const Builder&, const SQLTypeAdapter&)
 		AutoFlag<> af(template_defaults.processing_);
-		return store(SQLQueryParms() << str << len );
+		return store_as(build, SQLQueryParms() << str << len );
 	}
+
 	MYSQL_RES* res = 0;
 	if ((copacetic_ = conn_->driver()->execute(str, len)) == true) {
-		res = conn_->driver()->store_result();
+		res = build.streams() ? conn_->driver()->use_result() :
+				conn_->driver()->store_result();
 	}
 
 	if (res) {
-		if (parse_elems_.size() == 0) {
+		if (template_.empty()) {
 			// Not a template query, so auto-reset
 			reset();
 		}
-		return StoreQueryResult(res, conn_->driver(), throw_exceptions());
+		return build(res, conn_->driver(), throw_exceptions());
 	}
 	else {
 		// Either result set is empty, or there was a problem executing
@@ -549,33 +576,119 @@ Query::store(const char* str, size_t len)
 		// such queries when the query strings come from "outside".)
 		copacetic_ = (conn_->errnum() == 0);
 		if (copacetic_) {
-			if (parse_elems_.size() == 0) {
+			if (template_.empty()) {
 				// Not a template query, so auto-reset
 				reset();
 			}
-			return StoreQueryResult();
+			return typename Builder::result_type();
 		}
 		else if (throw_exceptions()) {
 			throw BadQuery(error(), errnum());
 		}
 		else {
-			return StoreQueryResult();
+			return typename Builder::result_type();
 		}
 	}
 }
 
 
+StoreQueryResult 
+Query::store() 
+{ 
+	return store(template_defaults); 
+}
+
+
+StoreQueryResult
+Query::store(SQLQueryParms& p)
+{
+	return store_as(StoreBuilder(store_mode_, effective_store_budget()), p);
+}
+
+
+StoreQueryResult
+Query::store(const SQLTypeAdapter& s)
+{
+	return store_as(StoreBuilder(store_mode_, effective_store_budget()), s);
+}
+
+
+StoreQueryResult
+Query::store(const char* str, size_t len)
+{
+	return store_as(StoreBuilder(store_mode_, effective_store_budget()),
+			str, len);
+}
+
+
+ColumnarResult
+Query::store_columnar()
+{
+	return store_columnar(template_defaults);
+}
+
+
+ColumnarResult
+Query::store_columnar(SQLQueryParms& p)
+{
+	return store_as(ColumnarBuilder(), p);
+}
+
+
+ColumnarResult
+Query::store_columnar(const SQLTypeAdapter& s)
+{
+	return store_as(ColumnarBuilder(), s);
+}
+
+
+ColumnarResult
+Query::store_columnar(const char* str, size_t len)
+{
+	return store_as(ColumnarBuilder(), str, len);
+}
+
+
+MappedResult
+Query::store_mapped()
+{
+	return store_mapped(template_defaults);
+}
+
+
+MappedResult
+Query::store_mapped(SQLQueryParms& p)
+{
+	return store_as(MappedBuilder(), p);
+}
+
+
+MappedResult
+Query::store_mapped(const SQLTypeAdapter& s)
+{
+	return store_as(MappedBuilder(), s);
+}
+
+
+MappedResult
+Query::store_mapped(const char* str, size_t len)
+{
+	return store_as(MappedBuilder(), str, len);
+}
+
+
 StoreQueryResult
 Query::store_next()
 {
 #if MYSQL_VERSION_ID > 41000		// only in MySQL v4.1 +
 	DBDriver::nr_code rc = conn_->driver()->next_result();
 	if (rc == DBDriver::nr_more_results) {
-		// There are more results, so return next result set.
-		MYSQL_RES* res = conn_->driver()->store_result();
+		// There are more results, so return next result set
+		const StoreBuilder build(store_mode_, effective_store_budget());
+		MYSQL_RES* res = build.streams() ? conn_->driver()->use_result() :
+				conn_->driver()->store_result();
 		if (res) {
-			return StoreQueryResult(res, conn_->driver(),
-					throw_exceptions());
+			return build(res, conn_->driver(), throw_exceptions());
 		}
 		else {
 			// Result set is null, but throw an exception only i it is
@@ -613,19 +726,43 @@ Query::store_next()
 std::string
 Query::str(SQLQueryParms& p)
 {
-	if (!parse_elems_.empty()) {
+	if (!template_.empty()) {
 		proc(p);
 	}
 
-	return sbuffer_.str();
+	return writer_.str();
+}
+
+
+void
+Query::swap(Query& other)
+{
+	if (this == &other) {
+		return;
+	}
+
+	bool te = throw_exceptions();
+	set_exceptions(other.throw_exceptions());
+	other.set_exceptions(te);
+
+	template_defaults.swap(other.template_defaults);
+	std::swap(conn_, other.conn_);
+	std::swap(copacetic_, other.copacetic_);
+	std::swap(store_mode_, other.store_mode_);
+	std::swap(store_budget_, other.store_budget_);
+	std::swap(template_, other.template_);
+
+	writer_.swap(other.writer_);
+	std::ios::iostate state = rdstate();
+	clear(other.rdstate());
+	other.clear(state);
 }
 
 
 UseQueryResult 
 Query::use() 
 { 
-	AutoFlag<> af(template_defaults.processing_);
-	return use(str(template_defaults)); 
+	return use(template_defaults); 
 }
 
 
@@ -633,14 +770,18 @@ UseQueryResult
 Query::use(SQLQueryParms& p)
 {
 	AutoFlag<> af(template_defaults.processing_);
-	return use(str(p));
+	if (!template_.empty()) {
+		proc(p);
+	}
+
+	return use(writer_.data(), writer_.length());
 }
 
 
 UseQueryResult
 Query::use(const SQLTypeAdapter& s)
 {
-	if ((parse_elems_.size() == 2) && !template_defaults.processing_) {
+	if ((template_.elements().size() == 2) && !template_defaults.processing_) {
 		// We're a template query and this isn't a recursive call, so
 		// take s to be a lone parameter for the query.  We will come
 		// back in here with a completed query, but the processing_
@@ -658,7 +799,7 @@ Query::use(const SQLTypeAdapter& s)
 UseQueryResult
 Query::use(const char* str, size_t len)
 {
-	if ((parse_elems_.size() == 2) && !template_defaults.processing_) {
+	if ((template_.elements().size() == 2) && !template_defaults.processing_) {
 		// We're a template query and this isn't a recursive call, so
 		// take s to be a lone parameter for the query.  We will come
 		// back in here with a completed query, but the processing_
@@ -672,7 +813,7 @@ Query::use(const char* str, size_t len)
 	}
 
 	if (res) {
-		if (parse_elems_.size() == 0) {
+		if (template_.empty()) {
 			// Not a template query, so auto-reset
 			reset();
 		}
@@ -683,7 +824,7 @@ Query::use(const char* str, size_t len)
 		// empty result sets and actual error returns here.
 		copacetic_ = (conn_->errnum() == 0);
 		if (copacetic_) {
-			if (parse_elems_.size() == 0) {
+			if (template_.empty()) {
 				// Not a template query, so auto-reset
 				reset();
 			}
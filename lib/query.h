@@ -30,12 +30,17 @@
 
 #include "common.h"
 
+#include "columnar.h"
 #include "exceptions.h"
+#include "mapped_result.h"
 #include "noexceptions.h"
 #include "qparms.h"
+#include "raw_row.h"
 #include "querydef.h"
+#include "query_template.h"
 #include "result.h"
 #include "row.h"
+#include "sql_writer.h"
 #include "sqlstream.h"
 #include "stadapter.h"
 #include "transaction.h"
@@ -147,9 +152,23 @@ public:
 	/// what values they have in the original.
 	Query(const Query& q);
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Create a new query object, taking over another's state
+	///
+	/// Unlike the copy ctor, this brings along the query string and
+	/// template query state, leaving \c q empty.
+	Query(Query&& q);
+#endif
+
 	/// \brief Return the number of rows affected by the last query
 	ulonglong affected_rows();
 
+	/// \brief Get the driver escape_string() uses
+	///
+	/// Returns 0 if there's no connection to ask, in which case
+	/// escaping falls back on DBDriver::escape_string_no_conn().
+	DBDriver* escape_driver() const;
+
 	/// \brief Return a SQL-escaped version of a character buffer
 	///
 	/// \param ps pointer to C++ string to hold escaped version; if
@@ -225,6 +244,19 @@ public:
 	/// ctor.
 	Query& operator=(const Query& rhs);
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Take over another query's state
+	Query& operator=(Query&& rhs);
+#endif
+
+	/// \brief Exchange state with another query object
+	///
+	/// This swaps everything, including the query string built up so
+	/// far and any template query, without copying any of it where
+	/// the platform's IOStreams allow.  The Connection each Query is
+	/// tied to goes along with its state.
+	void swap(Query& other);
+
 	/// \brief Test whether the object has experienced an error condition
 	///
 	/// Allows for code constructs like this:
@@ -261,8 +293,31 @@ public:
 	/// other members that accept template query parameters.  See the
 	/// "Template Queries" chapter in the user manual for more
 	/// information.
+	///
+	/// This parses the query string into a QueryTemplate.  If you run
+	/// the same template through many Query objects, parse it into a
+	/// QueryTemplate once yourself and give that to each Query instead,
+	/// via query_template(const QueryTemplate&).
 	void parse();
 
+	/// \brief Get the template this object fills in
+	///
+	/// The returned template is empty unless you've called parse() or
+	/// query_template(const QueryTemplate&).
+	const QueryTemplate& query_template() const { return template_; }
+
+	/// \brief Use an already-parsed template query
+	///
+	/// This has the same effect as putting the template's text into
+	/// this object and calling parse(), except that the parsing has
+	/// already been done.  The template is shared, not copied, so this
+	/// is cheap.
+	///
+	/// Any query text already in this object is thrown away.  Default
+	/// parameter values in template_defaults are left alone; call
+	/// reset() first if they were meant for some other template.
+	void query_template(const QueryTemplate& t);
+
 	/// \brief Reset the query object so that it can be reused.
 	///
 	/// As of v3.0, Query objects auto-reset upon query execution unless
@@ -304,6 +359,18 @@ public:
 	/// this object holds, if any
 	std::string str(SQLQueryParms& p);
 
+	/// \brief Get the buffer the query is built in
+	///
+	/// Everything inserted into this object through its stream
+	/// interface lands in this buffer, but appending to the buffer
+	/// directly is much faster.  See SQLWriter for an example.  The
+	/// parameterless execute(), store(), use() and such send the
+	/// buffer's contents to the server without copying them.
+	///
+	/// A template query is filled in by writing it into this buffer,
+	/// replacing what was there.
+	SQLWriter& writer() { return writer_; }
+
 	/// \brief Execute a built-up query
 	///
 	/// Same as exec(), except that it uses the query string built up
@@ -512,6 +579,109 @@ public:
 	/// from plain C strings and other useful data types implicitly.
 	StoreQueryResult store(const char* str, size_t len);
 
+	/// \brief Execute a query that can return rows, returning all
+	/// of the rows stored column by column
+	///
+	/// This works just like store(), except that the result is a
+	/// ColumnarResult, in which each column is parsed once into an
+	/// array of native C++ values.  It's much faster than store() when
+	/// you want to scan a few columns of a large result set.
+	///
+	/// This function has the same set of overloads as store().
+	///
+	/// \sa ColumnarResult
+	ColumnarResult store_columnar();
+
+	/// \brief Store results from a template query using given
+	/// parameters, column by column.
+	///
+	/// \sa store(SQLQueryParms&)
+	ColumnarResult store_columnar(SQLQueryParms& p);
+
+	/// \brief Execute a query that can return rows, returning all
+	/// of the rows stored column by column
+	///
+	/// \sa store(const SQLTypeAdapter&)
+	ColumnarResult store_columnar(const SQLTypeAdapter& str);
+
+	/// \brief Execute a query that can return rows, returning all
+	/// of the rows stored column by column
+	///
+	/// \sa store(const char*, size_t)
+	ColumnarResult store_columnar(const char* str, size_t len);
+
+	/// \brief Execute a query that can return rows, spilling the rows
+	/// to a memory-mapped temporary file
+	///
+	/// This works like store(), except that the rows go to disk as they
+	/// arrive instead of into memory, and come back a page at a time
+	/// as you use them.  Use this for result sets too big to hold in
+	/// memory that you still need random access to.  The connection is
+	/// free for other queries once this returns.
+	///
+	/// This function has the same set of overloads as store().
+	///
+	/// \sa MappedResult
+	MappedResult store_mapped();
+
+	/// \brief Store results from a template query using given
+	/// parameters in a memory-mapped temporary file
+	///
+	/// \sa store(SQLQueryParms&)
+	MappedResult store_mapped(SQLQueryParms& p);
+
+	/// \brief Execute a query that can return rows, spilling the rows
+	/// to a memory-mapped temporary file
+	///
+	/// \sa store(const SQLTypeAdapter&)
+	MappedResult store_mapped(const SQLTypeAdapter& str);
+
+	/// \brief Execute a query that can return rows, spilling the rows
+	/// to a memory-mapped temporary file
+	///
+	/// \sa store(const char*, size_t)
+	MappedResult store_mapped(const char* str, size_t len);
+
+	/// \brief Get the way store() and store_next() hold result data
+	StoreQueryResult::storage_mode store_mode() const
+			{ return store_mode_; }
+
+	/// \brief Set the way store() and store_next() hold result data
+	///
+	/// By default, each field in a stored result set gets its own
+	/// separately-allocated buffer.  Pass StoreQueryResult::sm_arena to
+	/// have all of the data copied into a single block of memory
+	/// instead, which is much faster for large result sets.  Pass
+	/// StoreQueryResult::sm_view to have the fields point into the C
+	/// API's copy of the data, without copying it at all.
+	///
+	/// This setting survives reset(), so you only need to set it once
+	/// for each Query object.
+	void store_mode(StoreQueryResult::storage_mode sm)
+			{ store_mode_ = sm; }
+
+	/// \brief Get the memory budget for store() and store_next()
+	///
+	/// Returns 0 if this object has no budget of its own, in which
+	/// case it uses the Connection's.
+	size_t store_budget() const { return store_budget_; }
+
+	/// \brief Set the memory budget for store() and store_next()
+	///
+	/// When a budget is in effect, store() reads the result set from
+	/// the server a row at a time, and gives up as soon as
+	/// StoreQueryResult::bytes_used() goes over \c bytes, rather than
+	/// after the whole result set is in memory.  It then throws
+	/// ResultTooLarge, or if exceptions are disabled, returns an empty
+	/// result that tests as false.  Either way, the rest of the rows
+	/// are read and thrown away, so the connection is ready for the
+	/// next query.
+	///
+	/// Pass 0, the default, to use the Connection's budget instead.
+	/// See Connection::store_budget(size_t).  Like store_mode(), this
+	/// setting survives reset().
+	void store_budget(size_t bytes) { store_budget_ = bytes; }
+
 	/// \brief Execute a query, and call a functor for each returned row
 	///
 	/// This method wraps a use() query, calling the given functor for
@@ -519,6 +689,11 @@ public:
 	/// algorithm, but instead of iterating over some range within a
 	/// container, it iterates over a result set produced by a query.
 	///
+	/// The functor gets a <tt>Row&</tt> referring to the Row inside a
+	/// RowView onto the C API's row buffer, so it's only valid during
+	/// the call.  If the functor wants to keep the row, it must copy
+	/// it; see RowView.
+	///
 	/// \param query the query string
 	/// \param fn the functor called for each row
 	/// \return a copy of the passed functor
@@ -528,8 +703,8 @@ public:
 		mysqlpp::UseQueryResult res = use(query);
 		if (res) {
 			mysqlpp::NoExceptions ne(res);
-			while (mysqlpp::Row row = res.fetch_row()) {
-				fn(row);
+			while (mysqlpp::RowView& view = res.fetch_row_view()) {
+				fn(view.row());
 			}
 		}
 
@@ -549,8 +724,8 @@ public:
 		mysqlpp::UseQueryResult res = use();
 		if (res) {
 			mysqlpp::NoExceptions ne(res);
-			while (mysqlpp::Row row = res.fetch_row()) {
-				fn(row);
+			while (mysqlpp::RowView& view = res.fetch_row_view()) {
+				fn(view.row());
 			}
 		}
 
@@ -576,8 +751,8 @@ public:
 		mysqlpp::UseQueryResult res = use(query);
 		if (res) {
 			mysqlpp::NoExceptions ne(res);
-			while (mysqlpp::Row row = res.fetch_row()) {
-				fn(row);
+			while (mysqlpp::RowView& view = res.fetch_row_view()) {
+				fn(view.row());
 			}
 		}
 
@@ -599,7 +774,12 @@ public:
 	/// container is the destination, the query is the source, and the
 	/// functor is the predicate; it's just like an STL algorithm.
 	///
-	/// \param con the destination container; needs a push_back() method
+	/// As with for_each(), the functor sees a RowView of each row, so
+	/// no row is copied unless it's actually stored in \c con, and
+	/// then it's copied just once.
+	///
+	/// \param con the destination container; needs a push_back()
+	/// method, and back() as well if it holds Row objects
 	/// \param query the query string
 	/// \param fn the functor called for each row
 	/// \return a copy of the passed functor
@@ -609,9 +789,9 @@ public:
 		mysqlpp::UseQueryResult res = use(query);
 		if (res) {
 			mysqlpp::NoExceptions ne(res);
-			while (mysqlpp::Row row = res.fetch_row()) {
-				if (fn(row)) {
-					con.push_back(row);
+			while (mysqlpp::RowView& view = res.fetch_row_view()) {
+				if (fn(view.row())) {
+					internal::push_row(con, view.row());
 				}
 			}
 		}
@@ -626,7 +806,8 @@ public:
 	/// it uses the SSQLS instance to construct a "select * from TABLE"
 	/// query, using the table name field in the SSQLS.
 	///
-	/// \param con the destination container; needs a push_back() method
+	/// \param con the destination container; needs a push_back()
+	/// method, and back() as well if it holds Row objects
 	/// \param ssqls the SSQLS instance to get a table name from
 	/// \param fn the functor called for each row
 	/// \return a copy of the passed functor
@@ -639,9 +820,9 @@ public:
 		mysqlpp::UseQueryResult res = use(query);
 		if (res) {
 			mysqlpp::NoExceptions ne(res);
-			while (mysqlpp::Row row = res.fetch_row()) {
-				if (fn(row)) {
-					con.push_back(row);
+			while (mysqlpp::RowView& view = res.fetch_row_view()) {
+				if (fn(view.row())) {
+					internal::push_row(con, view.row());
 				}
 			}
 		}
@@ -655,7 +836,8 @@ public:
 	/// Just like store_if(Sequence&, const SQLTypeAdapter&, Function), but
 	/// it uses the query string held by the Query object already
 	///
-	/// \param con the destination container; needs a push_back() method
+	/// \param con the destination container; needs a push_back()
+	/// method, and back() as well if it holds Row objects
 	/// \param fn the functor called for each row
 	/// \return a copy of the passed functor
 	template <class Sequence, typename Function>
@@ -664,9 +846,9 @@ public:
 		mysqlpp::UseQueryResult res = use();
 		if (res) {
 			mysqlpp::NoExceptions ne(res);
-			while (mysqlpp::Row row = res.fetch_row()) {
-				if (fn(row)) {
-					con.push_back(row);
+			while (mysqlpp::RowView& view = res.fetch_row_view()) {
+				if (fn(view.row())) {
+					internal::push_row(con, view.row());
 				}
 			}
 		}
@@ -699,6 +881,10 @@ public:
 	/// this function just wraps store() when built against older API
 	/// libraries.
 	///
+	/// If what you want is to send many independent statements at
+	/// once, StatementBatch builds the multi-query and walks its
+	/// results for you, noting which statement any error came from.
+	///
 	/// \return StoreQueryResult object containing the next result set.
 	StoreQueryResult store_next();
 
@@ -728,6 +914,14 @@ public:
 	/// the front of the list.  So, you can pass a container and a query
 	/// string, or a container and template query parameters.
 	///
+	/// If the container holds SSQLS objects, each row is parsed
+	/// straight into a new element's members, without building a Row
+	/// first.  The matching of member names to column names happens
+	/// once, not once per row.  Since rows arrive one at a time, this
+	/// can't know the row count in advance, so if you have a good
+	/// estimate, call \c reserve() on a \c std::vector before calling
+	/// this to avoid reallocation.
+	///
 	/// \param con any STL sequence container, such as \c std::vector
 	///
 	/// \sa exec(), execute(), store(), and use()
@@ -754,14 +948,8 @@ public:
 	void storein_sequence(Sequence& con, const SQLTypeAdapter& s)
 	{
 		if (UseQueryResult result = use(s)) {
-			while (1) {
-				MYSQL_ROW d = result.fetch_raw_row();
-				if (!d) break;
-				Row row(d, &result, result.fetch_lengths(),
-						throw_exceptions());
-				if (!row) break;
-				con.push_back(typename Sequence::value_type(row));
-			}
+			internal::ResultDecoder<typename Sequence::value_type>::
+					fill_sequence(con, result);
 		}
 		else if (!result_empty()) {
 			// Underlying MySQL C API returned an empty result for this
@@ -825,14 +1013,8 @@ public:
 	void storein_set(Set& con, const SQLTypeAdapter& s)
 	{
 		if (UseQueryResult result = use(s)) {
-			while (1) {
-				MYSQL_ROW d = result.fetch_raw_row();
-				if (!d) break;
-				Row row(d, &result, result.fetch_lengths(),
-						throw_exceptions());
-				if (!row) break;
-				con.insert(typename Set::value_type(row));
-			}
+			internal::ResultDecoder<typename Set::value_type>::
+					fill_set(con, result);
 		}
 		else if (!result_empty()) {
 			// Underlying MySQL C API returned an empty result for this
@@ -1063,7 +1245,7 @@ public:
 	/// \param policy insert policy object, see insertpolicy.h for
 	/// details
 	///
-	/// \sa insert()
+	/// \sa insert(), BulkInsert
 	template <class Iter, class InsertPolicy>
 	Query& insertfrom(Iter first, Iter last, InsertPolicy& policy)
 	{
@@ -1294,6 +1476,8 @@ public:
 	mysql_query_define0(std::string, str)
 	mysql_query_define0(SimpleResult, execute)
 	mysql_query_define0(StoreQueryResult, store)
+	mysql_query_define0(ColumnarResult, store_columnar)
+	mysql_query_define0(MappedResult, store_mapped)
 	mysql_query_define0(UseQueryResult, use)
 	mysql_query_define1(storein_sequence)
 	mysql_query_define1(storein_set)
@@ -1314,23 +1498,57 @@ private:
 	/// \brief If true, last query succeeded
 	bool copacetic_;
 
-	/// \brief List of template query parameters
-	std::vector<SQLParseElement> parse_elems_;
+	/// \brief How store() holds the result data
+	StoreQueryResult::storage_mode store_mode_;
 
-	/// \brief Maps template parameter position values to the
-	/// corresponding parameter name.
-	std::vector<std::string> parsed_names_;
+	/// \brief Memory budget for store(); 0 means use the Connection's
+	size_t store_budget_;
 
-	/// \brief Maps template parameter names to their position value.
-	std::map<std::string, short int> parsed_nums_;
+	/// \brief Get the memory budget store() should enforce, if any
+	size_t effective_store_budget() const;
 
-	/// \brief String buffer for storing assembled query
-	std::stringbuf sbuffer_;
+	/// \brief Common implementation of the store(), store_columnar()
+	/// and store_mapped() overloads having the same parameters
+	///
+	/// \c build is a functor that makes the result object from the C
+	/// API result set; see query.cpp.
+	template <class Builder>
+	typename Builder::result_type store_as(const Builder& build,
+			SQLQueryParms& p);
 
-	/// \brief Process a parameterized query list.
-	void proc(SQLQueryParms& p);
+	/// \brief Common implementation of store(const SQLTypeAdapter&)
+	/// and friends
+	template <class Builder>
+	typename Builder::result_type store_as(const Builder& build,
+			const SQLTypeAdapter& s);
 
-	SQLTypeAdapter* pprepare(char option, SQLTypeAdapter& S, bool replace = true);
+	/// \brief Common implementation of store(const char*, size_t) and
+	/// friends
+	template <class Builder>
+	typename Builder::result_type store_as(const Builder& build,
+			const char* str, size_t len);
+
+	/// \brief Parsed template query, if any; shared with copies
+	QueryTemplate template_;
+
+	/// \brief Buffer for storing assembled query
+	///
+	/// Kept from one query to the next so it rarely has to grow.
+	SQLWriter writer_;
+
+	/// \brief Append a template query parameter to writer_, quoted
+	/// and escaped as the option character calls for
+	void append_param(char option, const SQLTypeAdapter& S);
+
+	/// \brief Find the list holding the value for a template query
+	/// parameter: either \c p or template_defaults
+	///
+	/// Returns 0 if neither list has a value in that position.
+	SQLQueryParms* param_source(SQLQueryParms& p, size_t num);
+
+	/// \brief Fill in the template query from the given parameters,
+	/// leaving the result in writer_
+	void proc(SQLQueryParms& p);
 };
 
 
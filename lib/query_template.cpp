@@ -0,0 +1,180 @@
+/***********************************************************************
+ query_template.cpp - Implements the QueryTemplate class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "query_template.h"
+
+#include <ctype.h>
+#include <string.h>
+
+using namespace std;
+
+namespace mysqlpp {
+
+// What the accessors return for an empty template
+static const QueryTemplate::Elements no_elements;
+static const string no_string;
+
+
+QueryTemplate::QueryTemplate()
+{
+}
+
+
+QueryTemplate::QueryTemplate(const std::string& text)
+{
+	compile(text.data(), text.length());
+}
+
+
+QueryTemplate::QueryTemplate(const char* text, size_t length)
+{
+	compile(text, length);
+}
+
+
+void
+QueryTemplate::compile(const char* text, size_t length)
+{
+	RefCountedPointer<Body> body(new Body);
+	body->text.assign(text, length);
+
+	string before;
+	const char* s = body->text.data();
+	const char* const end = s + length;
+	while (s != end) {
+		// Copy everything up to the next percent sign in one go
+		const char* pct = static_cast<const char*>(memchr(s, '%', end - s));
+		if (!pct) {
+			before.append(s, end);
+			break;
+		}
+		before.append(s, pct);
+		s = pct + 1;
+
+		if (s != end && *s == '%') {
+			// Doubled percent sign, so insert literal percent sign.
+			before += *s++;
+		}
+		else if (s != end && isdigit(static_cast<unsigned char>(*s))) {
+			// Number following percent sign, so it signifies a
+			// positional parameter, up to 3 digits long.
+			int position = 0;
+			for (int i = 0; i < 3 && s != end &&
+					isdigit(static_cast<unsigned char>(*s)); ++i) {
+				position = position * 10 + (*s++ - '0');
+			}
+			signed char n = position;
+
+			// Look for option character following position value.
+			char option = ' ';
+			if (s != end && (*s == 'q' || *s == 'Q')) {
+				option = *s++;
+			}
+
+			// Is it a named parameter?
+			if (s != end && *s == ':') {
+				// Save all alphanumeric and underscore characters
+				// following colon as parameter name.
+				const char* name = ++s;
+				while (s != end && (isalnum(static_cast<unsigned char>(*s)) ||
+						*s == '_')) {
+					++s;
+				}
+				string pname(name, s);
+
+				// Eat trailing colon, if it's present.
+				if (s != end && *s == ':') {
+					++s;
+				}
+
+				// Update tables that translate parameter name to
+				// number and vice versa.
+				if (n >= 0) {
+					if (size_t(n) >= body->names.size()) {
+						body->names.resize(size_t(n) + 1);
+					}
+					body->names[n] = pname;
+				}
+				body->nums[pname] = n;
+			}
+
+			// Finished parsing parameter; save it.
+			body->literal_length += before.length();
+			if (n >= 0 && size_t(n) >= body->parameters) {
+				body->parameters = size_t(n) + 1;
+			}
+			body->elements.push_back(SQLParseElement(before, option, n));
+			before.clear();
+		}
+		else {
+			// Insert literal percent sign, because sign didn't
+			// precede a valid parameter string; this allows users
+			// to play a little fast and loose with the rules,
+			// avoiding a double percent sign here.
+			before += '%';
+		}
+	}
+
+	body->literal_length += before.length();
+	body->elements.push_back(SQLParseElement(before, ' ', -1));
+	body_ = body;
+}
+
+
+const QueryTemplate::Elements&
+QueryTemplate::elements() const
+{
+	return body_ ? body_->elements : no_elements;
+}
+
+
+short
+QueryTemplate::index(const std::string& name) const
+{
+	if (body_) {
+		map<string, short>::const_iterator it = body_->nums.find(name);
+		if (it != body_->nums.end()) {
+			return it->second;
+		}
+	}
+	return -1;
+}
+
+
+const std::string&
+QueryTemplate::name(size_t position) const
+{
+	return body_ && position < body_->names.size() ?
+			body_->names[position] : no_string;
+}
+
+
+const std::string&
+QueryTemplate::str() const
+{
+	return body_ ? body_->text : no_string;
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,159 @@
+/// \file query_template.h
+/// \brief Declares the QueryTemplate class, a parsed template query
+/// that any number of Query objects can share.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_QUERY_TEMPLATE_H)
+#define MYSQLPP_QUERY_TEMPLATE_H
+
+#include "common.h"
+
+#include "mystring.h"	// qparms.h needs String to be complete
+#include "qparms.h"
+#include "refcounted.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mysqlpp {
+
+/// \brief A template query, parsed once and ready to fill in
+///
+/// Query::parse() turns the text in a Query object into one of these.
+/// You can also build one yourself from the template text, and then
+/// hand it to as many Query objects as you like with
+/// Query::query_template(const QueryTemplate&) or
+/// Connection::query(const QueryTemplate&).  Those Query objects then
+/// skip the parsing step altogether, which matters when a program runs
+/// the same template through many connections, as with a
+/// ConnectionPool:
+///
+/// \code
+/// static const mysqlpp::QueryTemplate find_item(
+///         "select * from stock where item = %0q:item");
+/// ...
+/// mysqlpp::Query query = conn->query(find_item);
+/// mysqlpp::StoreQueryResult res = query.store("Nürnberger Brats");
+/// \endcode
+///
+/// Copying a QueryTemplate is cheap: copies share the parsed form,
+/// which nothing changes once it's built.  It's therefore safe for
+/// several threads to use the same template, or copies of it, at once,
+/// as long as none of them assigns a new template to an object another
+/// thread is using.
+///
+/// The template syntax is described in the "Template Queries" chapter
+/// of the user manual.
+
+class MYSQLPP_EXPORT QueryTemplate
+{
+public:
+	/// \brief Type of the list of template elements
+	typedef std::vector<SQLParseElement> Elements;
+
+	/// \brief Create an empty template
+	///
+	/// A Query with an empty template treats its text as plain SQL.
+	QueryTemplate();
+
+	/// \brief Parse the given template query text
+	///
+	/// \param text template query, with \c %0 and such marking the
+	/// places to fill in
+	explicit QueryTemplate(const std::string& text);
+
+	/// \brief Parse the given template query text
+	///
+	/// \param text template query
+	/// \param length number of bytes in \c text
+	QueryTemplate(const char* text, size_t length);
+
+	/// \brief Get the parsed template
+	///
+	/// The last element holds the text following the last parameter,
+	/// and has a \c num of -1.
+	const Elements& elements() const;
+
+	/// \brief Returns true if this template has nothing in it
+	bool empty() const { return !body_; }
+
+	/// \brief Get the position of the named parameter
+	///
+	/// \retval the parameter's position, or -1 if the template has no
+	/// parameter by that name
+	short index(const std::string& name) const;
+
+	/// \brief Get the total length of the template's literal text
+	///
+	/// This is the length of a query built from this template, not
+	/// counting the values filled in for the parameters, so it's a
+	/// good starting size for a buffer to build the query in.
+	size_t literal_length() const
+			{ return body_ ? body_->literal_length : 0; }
+
+	/// \brief Get the name of the parameter at the given position
+	///
+	/// Returns an empty string if that parameter has no name.
+	const std::string& name(size_t position) const;
+
+	/// \brief Get the number of parameters needed to fill in the
+	/// template
+	///
+	/// This is one more than the highest parameter position used in
+	/// the template.
+	size_t parameters() const { return body_ ? body_->parameters : 0; }
+
+	/// \brief Get the template's text as it was before parsing
+	const std::string& str() const;
+
+private:
+	/// \brief The parsed form of a template, shared between copies
+	struct Body : public RefCounted
+	{
+		std::string text;		///< template as given to the ctor
+		Elements elements;		///< literal text and parameters
+		std::vector<std::string> names;	///< parameter names by position
+		std::map<std::string, short> nums;	///< positions by name
+		size_t literal_length;	///< sum of elements' literal text lengths
+		size_t parameters;		///< highest position used, plus one
+
+		Body() :
+		literal_length(0),
+		parameters(0)
+		{
+		}
+	};
+
+	/// \brief Parse the given text into a new body_
+	void compile(const char* text, size_t length);
+
+	/// \brief Parsed form of the template, or null if it's empty
+	RefCountedPointer<Body> body_;
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_QUERY_TEMPLATE_H)
@@ -0,0 +1,58 @@
+/***********************************************************************
+ raw_row.cpp - Implements the RawRow class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "raw_row.h"
+
+namespace mysqlpp {
+
+RawRow::ColumnMap::ColumnMap(const ResultBase& res,
+		const char* const* names, size_t count) :
+names_(names)
+{
+	columns_.reserve(count);
+	const size_t num_fields = res.num_fields();
+	for (size_t i = 0; i < count; ++i) {
+		size_t col = res.field_names() ?
+				(*res.field_names())[names[i]] : num_fields;
+		columns_.push_back(col < num_fields ? int(col) : -1);
+	}
+}
+
+
+bool
+RawRow::fetch(const UseQueryResult& res)
+{
+	row_ = res.fetch_raw_row();
+	lengths_ = row_ ? res.fetch_lengths() : 0;
+	if (row_ && !lengths_ && res.throw_exceptions()) {
+		throw UseQueryError("Failed to get field lengths");
+	}
+
+	// See UseQueryResult::fetch_row() for why running off the end of
+	// the result set isn't an error.
+	return row_ && lengths_;
+}
+
+} // end namespace mysqlpp
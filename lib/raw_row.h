@@ -0,0 +1,292 @@
+/// \file raw_row.h
+/// \brief Declares the RawRow class, which lets SSQLS objects decode
+/// themselves straight from the C API's row data.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_RAW_ROW_H)
+#define MYSQLPP_RAW_ROW_H
+
+#include "common.h"
+
+#include "result.h"
+
+#include <vector>
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+
+class MYSQLPP_EXPORT PreparedQuery;
+
+namespace internal {
+	// Defined in prepared_query.h
+	template <class T>
+	void get_bound(const PreparedQuery& pq, int col, T& value);
+}
+
+#endif // !defined(DOXYGEN_IGNORE)
+
+/// \brief A row straight from the C API, read through a map from the
+/// members of a structure to the columns of a result set
+///
+/// Query::storein() uses this to fill SSQLS objects without building
+/// a Row for each one.  Matching the SSQLS's member names to the result
+/// set's column names happens once per result set, in ColumnMap, rather
+/// than once per field per row.  After that, each row's fields are
+/// parsed right out of the C API's buffers into the SSQLS members.
+/// PreparedQuery::storein() uses it the same way, except that the
+/// fields come from the statement's typed result buffers.
+///
+/// The conversions are the same ones String::conv() does, so a member
+/// gets the same value this way as it would from a Row.  A member with
+/// no matching column is an error: get() throws BadFieldName if the
+/// result set has exceptions enabled, and otherwise gives the member
+/// the value it would get from an empty String.
+
+class MYSQLPP_EXPORT RawRow
+{
+public:
+	/// \brief Maps each member of a structure to the index of the
+	/// result set column having the same name
+	class MYSQLPP_EXPORT ColumnMap
+	{
+	public:
+		/// \brief Look up a list of member names in a result set
+		///
+		/// \param res the result set to find the columns in
+		/// \param names names of the structure's members, in order
+		/// \param count number of elements in \c names
+		ColumnMap(const ResultBase& res, const char* const* names,
+				size_t count);
+
+		/// \brief Return the column index for the given member, or
+		/// -1 if the result set has no column by that name
+		int operator [](size_t member) const { return columns_[member]; }
+
+		/// \brief Return the name of the given member
+		const char* name(size_t member) const { return names_[member]; }
+
+		/// \brief Return the number of members in the map
+		size_t size() const { return columns_.size(); }
+
+	private:
+		const char* const* names_;	///< member names, in order
+		std::vector<int> columns_;	///< column index for each member
+	};
+
+	/// \brief Create an object for reading rows from \c res through
+	/// \c columns
+	///
+	/// Both must outlive this object.
+	RawRow(const ResultBase& res, const ColumnMap& columns) :
+	res_(&res),
+	columns_(&columns),
+	stmt_(0),
+	row_(0),
+	lengths_(0)
+	{
+	}
+
+	/// \brief Create an object for reading the current row of a
+	/// prepared statement's result set through \c columns
+	///
+	/// \c res must describe \c stmt's result columns.  All three must
+	/// outlive this object.
+	RawRow(const ResultBase& res, const ColumnMap& columns,
+			const PreparedQuery& stmt) :
+	res_(&res),
+	columns_(&columns),
+	stmt_(&stmt),
+	row_(0),
+	lengths_(0)
+	{
+	}
+
+	/// \brief Read the next row from a "use" result set
+	///
+	/// \return false if there are no more rows
+	///
+	/// \throw UseQueryError if the C API can't give us the lengths of
+	/// the row's fields, and \c res has exceptions enabled
+	bool fetch(const UseQueryResult& res);
+
+	/// \brief Convert the field for the given member to that member's
+	/// type
+	///
+	/// \throw BadFieldName if the result set has no column for the
+	/// member, and the result set has exceptions enabled
+	template <class T>
+	void get(size_t member, T& value) const
+	{
+		const int col = (*columns_)[member];
+		if (col < 0) {
+			if (res_->throw_exceptions()) {
+				throw BadFieldName(columns_->name(member));
+			}
+			value = String().conv(T());
+		}
+		else if (stmt_) {
+			internal::get_bound(*stmt_, col, value);
+		}
+		else {
+			const bool is_null = row_[col] == 0;
+			const String cell(is_null ? "NULL" : row_[col],
+					is_null ? 4 : lengths_[col], res_->field_type(col),
+					is_null, no_arena_);
+			value = cell.conv(T());
+		}
+	}
+
+private:
+	const ResultBase* res_;		///< result set the row comes from
+	const ColumnMap* columns_;	///< member-to-column map
+	const PreparedQuery* stmt_;	///< statement the row comes from, if any
+	MYSQL_ROW row_;				///< current row's data
+	const unsigned long* lengths_;	///< current row's field lengths
+
+	/// \brief Null arena, passed to String's view constructor, since
+	/// the data belongs to the C API
+	RefCountedArena no_arena_;
+};
+
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+
+namespace internal {
+
+// Finds out whether T is an SSQLS that can fill itself from a RawRow.
+// Such types have a static raw_columns() member that builds their
+// ColumnMap.
+template <class T>
+struct IsRawRowDecodable
+{
+	typedef RawRow::ColumnMap (*map_function)(const ResultBase&);
+	template <map_function> struct check;
+	template <class U> static char test(check<&U::raw_columns>*);
+	template <class U> static long test(...);
+	enum { value = sizeof(test<T>(0)) == sizeof(char) };
+};
+
+
+// Appends an element built from row to con.  Passing a copy of a Row
+// to push_back() copies it a second time in C++98, so for a container
+// of Rows we copy the row once and swap the copy into a new empty
+// element.  Other element types are built from the Row and passed to
+// push_back(), which moves them in if it can.
+template <class Sequence, class T>
+inline void
+push_row(Sequence& con, Row& row, T*)
+{
+	con.push_back(T(row));
+}
+
+template <class Sequence>
+inline void
+push_row(Sequence& con, Row& row, Row*)
+{
+	Row copy(row);
+	con.push_back(Row());
+	con.back().swap(copy);
+}
+
+template <class Sequence>
+inline void
+push_row(Sequence& con, Row& row)
+{
+	push_row(con, row, static_cast<typename Sequence::value_type*>(0));
+}
+
+
+// Fills a container from a "use" result set.  The general case builds
+// each element from a Row, passed as Row& like the one fetch_row()
+// used to give it...
+template <class T, bool raw = IsRawRowDecodable<T>::value>
+struct ResultDecoder
+{
+	template <class Sequence>
+	static void fill_sequence(Sequence& con, UseQueryResult& result)
+	{
+		while (RowView& view = result.fetch_row_view()) {
+			push_row(con, view.row());
+		}
+	}
+
+	template <class Set>
+	static void fill_set(Set& con, UseQueryResult& result)
+	{
+		while (RowView& view = result.fetch_row_view()) {
+			con.insert(T(view.row()));
+		}
+	}
+};
+
+// ...but an SSQLS decodes itself from the raw row data.  Sequence
+// elements are decoded in place, so their members aren't copied.
+template <class T>
+struct ResultDecoder<T, true>
+{
+	template <class Sequence>
+	static void fill_sequence(Sequence& con, const UseQueryResult& result)
+	{
+		const RawRow::ColumnMap columns(T::raw_columns(result));
+		RawRow raw(result, columns);
+		while (raw.fetch(result)) {
+			con.push_back(T());
+			try {
+				con.back().set(raw);
+			}
+			catch (...) {
+				con.pop_back();
+				throw;
+			}
+		}
+	}
+
+	template <class Set>
+	static void fill_set(Set& con, const UseQueryResult& result)
+	{
+		const RawRow::ColumnMap columns(T::raw_columns(result));
+		RawRow raw(result, columns);
+		T value;
+		while (raw.fetch(result)) {
+			value.set(raw);
+			con.insert(value);
+		}
+	}
+};
+
+} // end namespace internal
+
+#endif // !defined(DOXYGEN_IGNORE)
+
+} // end namespace mysqlpp
+
+// RawRow::get() needs internal::get_bound()'s definition when it reads
+// from a prepared statement.
+#include "prepared_query.h"
+
+#endif // !defined(MYSQLPP_RAW_ROW_H)
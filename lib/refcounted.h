@@ -1,9 +1,10 @@
 /// \file refcounted.h
-/// \brief Declares the RefCountedPointer template
+/// \brief Declares the RefCountedPointer template and the RefCounted
+/// base class
 
 /***********************************************************************
- Copyright (c) 2007-2011 by Educational Technology Resources, Inc. and
- (c) 2007 by Jonathan Wakely.  Others may also hold copyrights on
+ Copyright (c) 2007-2011, 2026 by Educational Technology Resources,
+ Inc. and (c) 2007 by Jonathan Wakely.  Others may also hold copyrights on
  code in this file.  See the CREDITS.txt file in the top directory
  of the distribution for details.
 
@@ -28,12 +29,131 @@
 #if !defined(MYSQLPP_REFCOUNTED_H)
 #define MYSQLPP_REFCOUNTED_H
 
+#include "common.h"
+
 #include <memory>
 
 #include <stddef.h>
 
+#if defined(MYSQLPP_PLATFORM_VISUAL_CPP)
+#	include <intrin.h>
+#endif
+
 namespace mysqlpp {
 
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+namespace internal {
+	// Reference count updates.  These are atomic where we know how to
+	// make them so, which is everywhere we build regularly.  Elsewhere
+	// they're plain increments, so sharing refcounted objects between
+	// threads isn't safe there.
+	inline void
+	atomic_increment(volatile long* p)
+	{
+#if defined(MYSQLPP_PLATFORM_VISUAL_CPP)
+		_InterlockedIncrement(p);
+#elif defined(__GNUC__)
+		__sync_add_and_fetch(p, 1);
+#else
+		++*p;
+#endif
+	}
+
+	// Returns the new count
+	inline long
+	atomic_decrement(volatile long* p)
+	{
+#if defined(MYSQLPP_PLATFORM_VISUAL_CPP)
+		return _InterlockedDecrement(p);
+#elif defined(__GNUC__)
+		return __sync_sub_and_fetch(p, 1);
+#else
+		return --*p;
+#endif
+	}
+} // end namespace mysqlpp::internal
+
+template <class T, bool intrusive> struct RefCountPolicy;
+#endif // !defined(DOXYGEN_IGNORE)
+
+
+/// \brief Base class for objects that hold their own reference count
+///
+/// RefCountedPointer normally has to allocate a separate counter for
+/// each object it manages.  If the object's class derives from this
+/// one, RefCountedPointer uses the counter in here instead, so the
+/// object costs just the one allocation.  SQLBuffer, FieldNames and
+/// the other refcounted types inside MySQL++ are all done this way.
+///
+/// Copying an object of a derived class doesn't copy the count; the
+/// copy starts out unowned, like any newly created object.
+class RefCounted
+{
+protected:
+	/// \brief Create object with no owners
+	RefCounted() : refs_(0) { }
+
+	/// \brief Create object with no owners; the count isn't copied
+	RefCounted(const RefCounted&) : refs_(0) { }
+
+	/// \brief Assignment leaves the reference count alone
+	RefCounted& operator =(const RefCounted&) { return *this; }
+
+	/// \brief Destroy object
+	///
+	/// This isn't virtual: RefCountedPointer deletes objects through
+	/// a pointer to the derived type, not to this class.
+	~RefCounted() { }
+
+private:
+	template <class T, bool intrusive> friend struct RefCountPolicy;
+
+	mutable volatile long refs_;	///< number of RefCountedPointers to us
+};
+
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+
+// Finds out whether T derives from RefCounted.  T must be a complete
+// type here, else we'd silently get the wrong answer, so the sizeof()
+// check below refuses to compile if it isn't.
+template <class T>
+struct IsRefCounted
+{
+	static char test(const volatile RefCounted*);
+	static long test(...);
+	enum {
+		complete = sizeof(T),
+		value = sizeof(test(static_cast<T*>(0))) == sizeof(char)
+	};
+};
+
+// How RefCountedPointer finds the reference count for an object: for
+// most types, it's a separately allocated counter...
+template <class T, bool intrusive = IsRefCounted<T>::value>
+struct RefCountPolicy
+{
+	static volatile long* attach(T*) { return new long(1); }
+	static void detach(volatile long* refs) { delete refs; }
+};
+
+// ...but RefCounted subclasses carry their own.
+template <class T>
+struct RefCountPolicy<T, true>
+{
+	static volatile long* attach(T* c)
+	{
+		internal::atomic_increment(&c->refs_);
+		return &c->refs_;
+	}
+
+	static void detach(volatile long*) { }
+};
+#endif // !defined(DOXYGEN_IGNORE)
+
+
 /// \brief Functor to call delete on the pointer you pass to it
 ///
 /// The default "destroyer" for RefCountedPointer.  You won't use this
@@ -67,6 +187,13 @@ struct RefCountedPointerDestroyer
 /// once, then pass around the reference counted pointer, knowing that
 /// the last user will "turn out the lights".
 ///
+/// Copies of a RefCountedPointer may be used and destroyed in
+/// different threads at the same time: the reference count is updated
+/// atomically.  This lets you pass a Row or String to another thread
+/// without making a deep copy.  It doesn't make the managed object
+/// itself thread-safe, nor any single RefCountedPointer object, so two
+/// threads mustn't assign to the same pointer at once.
+///
 /// \b Implementation \b detail: You may notice that this class manages
 /// two pointers, one to the data we're managing, and one to the
 /// reference count.  You might wonder why we don't wrap these up into a
@@ -74,7 +201,9 @@ struct RefCountedPointerDestroyer
 /// the memory management.  It would indeed do that, but then every
 /// access to the data we manage would be a triple indirection instead
 /// of just double.  It's a tradeoff, and we've chosen to take a minor
-/// complexity hit to avoid the performance hit.
+/// complexity hit to avoid the performance hit.  If \c T derives from
+/// RefCounted, the second pointer points into the object itself, so
+/// there is no separate counter to allocate.
 
 template <class T, class Destroyer = RefCountedPointerDestroyer<T> >
 class RefCountedPointer
@@ -103,7 +232,7 @@ public:
 	{
 		std::auto_ptr<T> exception_guard(counted_);
 		if (counted_) {
-			refs_ = new size_t(1);
+			refs_ = RefCountPolicy<T>::attach(counted_);
 		}
 		exception_guard.release();	// previous new didn't throw
 	}
@@ -114,7 +243,7 @@ public:
 	refs_(other.counted_ ? other.refs_ : 0)
 	{
 		if (counted_) {
-			++(*refs_);
+			internal::atomic_increment(refs_);
 		}
 	}
 
@@ -124,9 +253,9 @@ public:
 	/// drops to 0.
 	~RefCountedPointer()
 	{
-		if (refs_ && (--(*refs_) == 0)) {
+		if (refs_ && internal::atomic_decrement(refs_) == 0) {
 			Destroyer()(counted_);
-			delete refs_;
+			RefCountPolicy<T>::detach(refs_);
 		}
 	}
 
@@ -238,6 +367,15 @@ public:
 		return counted_;
 	}
 
+	/// \brief Return true if this is the only pointer to the
+	/// managed object
+	///
+	/// Returns false if we aren't managing an object.
+	bool unique() const
+	{
+		return refs_ && *refs_ == 1;
+	}
+
 	/// \brief Exchange our managed memory with another pointer.
 	///
 	/// \internal This exists primarily to implement assign() in an
@@ -257,7 +395,7 @@ private:
 	/// We can't keep this as a plain integer because this object
 	/// allows itself to be copied.  All copies need to share this
 	/// reference count, not just the pointer to the counted object.
-	size_t* refs_;
+	volatile long* refs_;
 };
 
 
@@ -32,23 +32,53 @@
 
 namespace mysqlpp {
 
+// Heap bytes used by a String holding its own copy of a field value
+static inline size_t
+cell_bytes(size_t length)
+{
+	return sizeof(SQLBuffer) +
+			(length > SQLBuffer::inline_capacity ? length + 1 : 0);
+}
+
+
+// Heap bytes used by a Row's field list, plus the field data if each
+// field has its own buffer rather than being a view
+static size_t
+row_bytes(const Row& row, bool own_cells)
+{
+	size_t bytes = row.size() * sizeof(String);
+	if (own_cells) {
+		for (Row::const_iterator it = row.begin(); it != row.end(); ++it) {
+			bytes += cell_bytes(it->length());
+		}
+	}
+	return bytes;
+}
+
+
+// Frees the C API result set adopted by a view mode StoreQueryResult's
+// arena, once no String refers to its data any more
+static void
+release_result(char* block, CellArena::size_type)
+{
+	RefCountedPointerDestroyer<MYSQL_RES>()(
+			reinterpret_cast<MYSQL_RES*>(block));
+}
+
 
 ResultBase::ResultBase(MYSQL_RES* res, DBDriver* dbd, bool te) :
 OptionalExceptions(te),
 driver_(res ? dbd : 0),
-fields_(Fields::size_type(res ? dbd->num_fields(res) : 0)),
 current_field_(0)
 {
 	if (res) {
-		Fields::size_type i = 0;
-		const MYSQL_FIELD* pf;
-		while ((i < fields_.size()) && (pf = dbd->fetch_field(res))) {
-			fields_[i++] = pf;
-		}
-		dbd->field_seek(res, 0);		// semantics break otherwise!
-
-		names_ = new FieldNames(this);
-		types_ = new FieldTypes(this);
+		// Results with the same columns as one we've seen recently on
+		// this connection share its field info, rather than building
+		// their own copy of it.
+		schema_ = dbd->schema_cache().get(dbd->fetch_fields(res),
+				size_t(dbd->num_fields(res)));
+		names_ = schema_->names();
+		types_ = schema_->types();
 	}
 }
 
@@ -61,14 +91,14 @@ ResultBase::copy(const ResultBase& other)
 
 		if (other.driver_) {
 			driver_ = other.driver_;
-			fields_ = other.fields_;
+			schema_ = other.schema_;
 			names_ = other.names_;
 			types_ = other.types_;
 			current_field_ = other.current_field_;
 		}
 		else {
 			driver_ = 0;
-			fields_.clear();
+			schema_ = 0;
 			names_ = 0;
 			types_ = 0;
 			current_field_ = 0;
@@ -79,6 +109,38 @@ ResultBase::copy(const ResultBase& other)
 }
 
 
+void
+ResultBase::swap(ResultBase& other)
+{
+	bool te = throw_exceptions();
+	set_exceptions(other.throw_exceptions());
+	other.set_exceptions(te);
+
+	std::swap(driver_, other.driver_);
+	schema_.swap(other.schema_);
+	names_.swap(other.names_);
+	types_.swap(other.types_);
+	std::swap(current_field_, other.current_field_);
+}
+
+
+size_t
+ResultBase::metadata_bytes() const
+{
+	// This counts the whole schema even if it's shared with other
+	// results, since it may not stay shared.
+	return schema_ ? schema_->bytes_used() : 0;
+}
+
+
+const Fields&
+ResultBase::no_fields()
+{
+	static const Fields empty;
+	return empty;
+}
+
+
 int
 ResultBase::field_num(const std::string& i) const
 {
@@ -97,17 +159,74 @@ ResultBase::field_num(const std::string& i) const
 
 
 StoreQueryResult::StoreQueryResult(MYSQL_RES* res, DBDriver* dbd,
-		bool te) :
+		bool te, storage_mode sm, size_type budget) :
 ResultBase(res, dbd, te),
-list_type(list_type::size_type(res && dbd ? dbd->num_rows(res) : 0)),
-copacetic_(res && dbd)
+list_type(list_type::size_type(res && dbd && !budget ?
+		dbd->num_rows(res) : 0)),
+copacetic_(res && dbd),
+bytes_(0)
 {
 	if (copacetic_) {
-		iterator it = begin();
-		while (MYSQL_ROW row = dbd->fetch_row(res)) {
-			if (const unsigned long* lengths = dbd->fetch_lengths(res)) {
-				*it = Row(row, this, lengths, throw_exceptions());
-				++it;
+		bytes_ = metadata_bytes() + capacity() * sizeof(Row);
+		if (budget) {
+			read_rows(res, dbd, sm, budget);
+			return;
+		}
+
+		list_type::iterator it = list_type::begin();
+		if (sm == sm_view) {
+			// Point each field at the C API's copy of its data.  The
+			// arena holds no data of its own; it just keeps the result
+			// set alive for as long as any String refers to it.
+			RefCountedArena arena(new CellArena);
+			arena->adopt(reinterpret_cast<char*>(res), 0, release_result);
+			while (MYSQL_ROW row = dbd->fetch_row(res)) {
+				if (const unsigned long* lengths = dbd->fetch_lengths(res)) {
+					it->set_exceptions(throw_exceptions());
+					it->view(row, this, lengths, arena);
+					bytes_ += row_bytes(*it, false);
+					++it;
+				}
+			}
+			bytes_ += sizeof(CellArena);
+			return;
+		}
+		else if (sm == sm_arena) {
+			// The C API already knows the length of every field, so
+			// make a quick pass over the result set to find out how big
+			// the arena has to be.  Then we can allocate it as a single
+			// block, and copy each row into it.
+			CellArena::size_type bytes = 0;
+			const size_t nf = num_fields();
+			while (MYSQL_ROW row = dbd->fetch_row(res)) {
+				if (const unsigned long* lengths = dbd->fetch_lengths(res)) {
+					for (size_t i = 0; i < nf; ++i) {
+						if (row[i]) {
+							bytes += lengths[i] + 1;
+						}
+					}
+				}
+			}
+			dbd->data_seek(res, 0);
+
+			RefCountedArena arena(new CellArena(bytes));
+			while (MYSQL_ROW row = dbd->fetch_row(res)) {
+				if (const unsigned long* lengths = dbd->fetch_lengths(res)) {
+					Row(row, this, lengths, arena,
+							throw_exceptions()).swap(*it);
+					bytes_ += row_bytes(*it, false);
+					++it;
+				}
+			}
+			bytes_ += sizeof(CellArena) + arena->bytes_reserved();
+		}
+		else {
+			while (MYSQL_ROW row = dbd->fetch_row(res)) {
+				if (const unsigned long* lengths = dbd->fetch_lengths(res)) {
+					Row(row, this, lengths, throw_exceptions()).swap(*it);
+					bytes_ += row_bytes(*it, true);
+					++it;
+				}
 			}
 		}
 
@@ -123,12 +242,69 @@ StoreQueryResult::copy(const StoreQueryResult& other)
 		ResultBase::copy(other);
 		assign(other.begin(), other.end());
 		copacetic_ = other.copacetic_;
+		bytes_ = other.bytes_ + (capacity() - other.capacity()) * sizeof(Row);
 	}
 
 	return *this;
 }
 
 
+void
+StoreQueryResult::read_rows(MYSQL_RES* res, DBDriver* dbd,
+		storage_mode sm, size_type budget)
+{
+	// Unlike the ctor, we can't find out the arena size we need up
+	// front, so we let it grow a slab at a time.
+	RefCountedArena arena;
+	CellArena::size_type reserved = 0;
+	if (sm != sm_cells) {
+		arena = new CellArena;
+		bytes_ += sizeof(CellArena);
+	}
+
+	while (bytes_ <= budget) {
+		MYSQL_ROW row = dbd->fetch_row(res);
+		if (!row) {
+			break;
+		}
+		const unsigned long* lengths = dbd->fetch_lengths(res);
+		if (!lengths) {
+			continue;
+		}
+
+		size_type old_capacity = capacity();
+		push_back(Row());
+		Row& r = list_type::back();
+		if (arena) {
+			Row(row, this, lengths, arena, throw_exceptions()).swap(r);
+			bytes_ += row_bytes(r, false) +
+					arena->bytes_reserved() - reserved;
+			reserved = arena->bytes_reserved();
+		}
+		else {
+			Row(row, this, lengths, throw_exceptions()).swap(r);
+			bytes_ += row_bytes(r, true);
+		}
+		bytes_ += (capacity() - old_capacity) * sizeof(Row);
+	}
+
+	// Freeing a "use" result set makes the C API read and throw away
+	// any rows we didn't get to, so this also readies the connection
+	// for the next query.
+	dbd->free_result(res);
+
+	if (bytes_ > budget) {
+		list_type empty;
+		list_type::swap(empty);
+		bytes_ = metadata_bytes();
+		copacetic_ = false;
+		if (throw_exceptions()) {
+			throw ResultTooLarge(budget);
+		}
+	}
+}
+
+
 UseQueryResult::UseQueryResult(MYSQL_RES* res, DBDriver* dbd, bool te) :
 ResultBase(res, dbd, te)
 {
@@ -199,6 +375,33 @@ UseQueryResult::fetch_row() const
 }
 
 
+const RowView&
+UseQueryResult::fetch_row_view() const
+{
+	if (!result_) {
+		if (throw_exceptions()) {
+			throw UseQueryError("Results not fetched");
+		}
+		else {
+			view_.assign(0, 0, 0, false);
+			return view_;
+		}
+	}
+
+	MYSQL_ROW row = driver_->fetch_row(result_.raw());
+	const unsigned long* lengths = row ? fetch_lengths() : 0;
+	if (row && !lengths && throw_exceptions()) {
+		throw UseQueryError("Failed to get field lengths");
+	}
+
+	// A null row or lengths list leaves the view falsy, which tells
+	// the caller's loop to stop.  See fetch_row() for why running off
+	// the end of the result set isn't an error.
+	view_.assign(row, this, lengths, throw_exceptions());
+	return view_;
+}
+
+
 MYSQL_ROW
 UseQueryResult::fetch_raw_row() const
 {
@@ -38,6 +38,10 @@
 #include "noexceptions.h"
 #include "refcounted.h"
 #include "row.h"
+#include "row_view.h"
+#include "schema_cache.h"
+
+#include <iterator>
 
 namespace mysqlpp {
 
@@ -115,17 +119,18 @@ public:
 
 	/// \brief Returns the next field in this result set
 	const Field& fetch_field() const
-			{ return fields_.at(current_field_++); }
+			{ return fields().at(current_field_++); }
 
 	/// \brief Returns the given field in this result set
 	const Field& fetch_field(Fields::size_type i) const
-			{ return fields_.at(i); }
+			{ return fields().at(i); }
 
 	/// \brief Get the underlying Field structure given its index.
-	const Field& field(unsigned int i) const { return fields_.at(i); }
+	const Field& field(unsigned int i) const { return fields().at(i); }
 
 	/// \brief Get the underlying Fields structure.
-	const Fields& fields() const { return fields_; }
+	const Fields& fields() const
+			{ return schema_ ? schema_->fields() : no_fields(); }
 
 	/// \brief Get the name of the field at the given index.
 	const std::string& field_name(int i) const
@@ -150,11 +155,18 @@ public:
 			{ return types_; }
 
 	/// \brief Returns the number of fields in this result set
-	size_t num_fields() const { return fields_.size(); }
+	size_t num_fields() const { return fields().size(); }
+
+	/// \brief Get the description of this result set's columns
+	///
+	/// Result sets with the same columns from the same connection share
+	/// one of these.  \sa SchemaCache
+	const RefCountedPointer<ResultSchema>& schema() const
+			{ return schema_; }
 
 	/// \brief Return the name of the table the result set comes from
 	const char* table() const
-			{ return fields_.empty() ? "" : fields_[0].table(); }
+			{ return fields().empty() ? "" : fields()[0].table(); }
 
 protected:
 	/// \brief Create empty object
@@ -177,8 +189,20 @@ protected:
 	/// \brief Copy another ResultBase object's contents into this one.
 	ResultBase& copy(const ResultBase& other);
 
+	/// \brief Exchange contents with another ResultBase object
+	///
+	/// Unlike copy(), this takes constant time, and can't throw.
+	void swap(ResultBase& other);
+
+	/// \brief Return the number of heap bytes used by the field
+	/// information
+	size_t metadata_bytes() const;
+
 	DBDriver* driver_;	///< Access to DB driver; fully initted if nonzero
-	Fields fields_;		///< list of fields in result
+
+	/// \brief description of the fields in the result, shared with
+	/// other results having the same fields
+	RefCountedPointer<ResultSchema> schema_;
 
 	/// \brief list of field names in result
 	RefCountedPointer<FieldNames> names_;
@@ -194,6 +218,29 @@ protected:
 	/// UseQueryResult::result_: this field provides functionality we
 	/// used to get through result_, so it's relevant here, too.
 	mutable Fields::size_type current_field_;
+
+private:
+	/// \brief Return an empty field list, for results with no schema_
+	static const Fields& no_fields();
+};
+
+
+/// \brief Functor to call mysql_free_result() on the pointer you pass
+/// to it.
+///
+/// This overrides RefCountedPointer's default destroyer, which uses
+/// operator delete; it annoys the C API when you nuke its data
+/// structures this way. :)
+template <>
+struct RefCountedPointerDestroyer<MYSQL_RES>
+{
+	/// \brief Functor implementation
+	void operator()(MYSQL_RES* doomed) const
+	{
+		if (doomed) {
+			mysql_free_result(doomed);
+		}
+	}
 };
 
 
@@ -205,6 +252,24 @@ protected:
 /// MySQL++ also supports UseQueryResult which is less friendly, but has
 /// better memory performance.  See the user manual for more details on
 /// the distinction and the usage patterns required.
+///
+/// By default, each field of each row gets its own heap-allocated copy
+/// of the data.  For large result sets, it's much cheaper to store the
+/// result in arena mode instead: all of the data is copied into a
+/// single CellArena, and the Row objects hold String views onto it.
+/// The interface is the same either way.  See Query::store_mode().
+///
+/// Cheaper still is view mode, which doesn't copy the data at all.
+/// The object holds onto the C API's result set instead of freeing
+/// it, and each field is a String view onto the C API's copy of its
+/// data, so peak memory use is about half that of the other modes.
+/// The result set is freed when the last String referring to it goes
+/// away, so rows copied or swapped out of the object stay valid.  The
+/// rows are all set up by the time the ctor returns, so this is an
+/// ordinary std::vector<Row> in every other way.
+///
+/// bytes_used() tells you how much memory the object is using, and
+/// Query::store_budget() lets you put a ceiling on it.
 
 class MYSQLPP_EXPORT StoreQueryResult :
 		public ResultBase,
@@ -220,29 +285,80 @@ private:
 public:
 	typedef std::vector<Row> list_type;	///< type of vector base class
 
+	typedef list_type::size_type size_type;	///< type of row counts
+
+	/// \brief Ways a StoreQueryResult can hold its row data
+	enum storage_mode {
+		sm_cells,	///< separate buffer for each field; the default
+		sm_arena,	///< all fields' data copied into one CellArena
+		sm_view		///< fields are views onto the C API's copy of the data
+	};
+
 	/// \brief Default constructor
 	StoreQueryResult() :
 	ResultBase(),
-	copacetic_(false)
+	copacetic_(false),
+	bytes_(0)
 	{
 	}
 	
 	/// \brief Fully initialize object
-	StoreQueryResult(MYSQL_RES* result, DBDriver* dbd, bool te = true);
+	///
+	/// \param result C API result set to copy the rows from; we free
+	/// it when we're done with it, which is right away unless \c sm is
+	/// sm_view
+	/// \param dbd database driver the result set came from
+	/// \param te if true, throw exceptions on errors
+	/// \param sm how to store the row data
+	/// \param budget if nonzero, \c result must come from
+	/// DBDriver::use_result(), and we read it a row at a time, giving
+	/// up as soon as bytes_used() goes over this many bytes.  In that
+	/// case, the object is left empty and tests as false, after
+	/// throwing ResultTooLarge if exceptions are enabled.  View mode
+	/// needs the whole result set up front, so it acts like arena
+	/// mode here.
+	StoreQueryResult(MYSQL_RES* result, DBDriver* dbd, bool te = true,
+			storage_mode sm = sm_cells, size_type budget = 0);
 
 	/// \brief Initialize object as a copy of another StoreQueryResult
 	/// object
 	StoreQueryResult(const StoreQueryResult& other) :
 	ResultBase(),
 	std::vector<Row>(),
-	copacetic_(false)
+	copacetic_(false),
+	bytes_(0)
 	{
 		copy(other);
 	}
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move constructor
+	///
+	/// Takes over the other object's rows without copying them,
+	/// leaving \c other empty.
+	StoreQueryResult(StoreQueryResult&& other) :
+	ResultBase(),
+	std::vector<Row>(),
+	copacetic_(false),
+	bytes_(0)
+	{
+		swap(other);
+	}
+#endif
+
 	/// \brief Destroy result set
 	~StoreQueryResult() { }
 
+	/// \brief Return the number of heap bytes the result set uses
+	///
+	/// This counts the row list, the Row and String objects, the
+	/// copies of the field data, and the field information.  It
+	/// counts the bytes we asked the heap for, without the heap's own
+	/// overhead, and it counts data shared with copies of this object
+	/// in full.  In view mode, the data itself stays with the C API,
+	/// so it isn't counted.
+	size_type bytes_used() const { return bytes_; }
+
 	/// \brief Returns the number of rows in this result set
 	list_type::size_type num_rows() const { return size(); }
 
@@ -251,6 +367,31 @@ public:
 	StoreQueryResult& operator =(const StoreQueryResult& rhs)
 			{ return this != &rhs ? copy(rhs) : *this; }
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move another StoreQueryResult object's data into this
+	/// object
+	StoreQueryResult& operator =(StoreQueryResult&& rhs)
+	{
+		swap(rhs);
+		return *this;
+	}
+#endif
+
+	/// \brief Exchange contents with another StoreQueryResult
+	///
+	/// This swaps the row lists themselves, not the rows, so it takes
+	/// constant time no matter how big the result sets are.
+	void swap(StoreQueryResult& other)
+	{
+		ResultBase::swap(other);
+		list_type::swap(other);
+		std::swap(copacetic_, other.copacetic_);
+		std::swap(bytes_, other.bytes_);
+	}
+
+	/// \brief Exchange rows with a plain vector of Row objects
+	using list_type::swap;
+
 	/// \brief Test whether the query that created this result succeeded
 	///
 	/// If you test this object in bool context and it's false, it's a
@@ -267,26 +408,13 @@ private:
 	/// one.
 	StoreQueryResult& copy(const StoreQueryResult& other);
 
-	bool copacetic_;	///< true if initialized from a good result set
-};
-
+	/// \brief Read a "use" result set's rows one at a time, stopping
+	/// if we go over budget
+	void read_rows(MYSQL_RES* res, DBDriver* dbd, storage_mode sm,
+			size_type budget);
 
-/// \brief Functor to call mysql_free_result() on the pointer you pass
-/// to it.
-///
-/// This overrides RefCountedPointer's default destroyer, which uses
-/// operator delete; it annoys the C API when you nuke its data
-/// structures this way. :)
-template <>
-struct RefCountedPointerDestroyer<MYSQL_RES>
-{
-	/// \brief Functor implementation
-	void operator()(MYSQL_RES* doomed) const
-	{
-		if (doomed) {
-			mysql_free_result(doomed);
-		}
-	}
+	bool copacetic_;	///< true if initialized from a good result set
+	size_type bytes_;	///< value returned by bytes_used()
 };
 
 
@@ -294,10 +422,92 @@ struct RefCountedPointerDestroyer<MYSQL_RES>
 ///
 /// See the user manual for the reason you might want to use this even
 /// though its interface is less friendly than StoreQueryResult's.
+///
+/// If you don't need to keep the rows, the fastest way to go through
+/// the result set is with fetch_row_view(), or with the equivalent
+/// iterator interface:
+///
+/// \code
+///   for (mysqlpp::UseQueryResult::iterator it = res.begin();
+///           it != res.end(); ++it) {
+///       std::cout << (*it)[0] << std::endl;
+///   }
+/// \endcode
+///
+/// This also lets you use a UseQueryResult in a C++11 range-based
+/// \c for loop.
 
 class MYSQLPP_EXPORT UseQueryResult : public ResultBase
 {
 public:
+	/// \brief Single-pass input iterator over the rows remaining in
+	/// the result set
+	///
+	/// Dereferencing it gives the RowView for the current row, and
+	/// incrementing it fetches the next row, invalidating that view.
+	/// Like any input iterator, copies of one iterator aren't
+	/// independent: they all share the result set's read position.
+	class iterator
+	{
+	public:
+		typedef std::input_iterator_tag iterator_category;	///< iterator kind
+		typedef RowView value_type;			///< type we point to
+		typedef std::ptrdiff_t difference_type;	///< distance type
+		typedef const RowView* pointer;		///< pointer type
+		typedef const RowView& reference;	///< reference type
+
+		/// \brief Create the past-the-end iterator
+		iterator() :
+		res_(0)
+		{
+		}
+
+		/// \brief Get the current row
+		reference operator *() const { return res_->view_; }
+
+		/// \brief Get the current row
+		pointer operator ->() const { return &res_->view_; }
+
+		/// \brief Fetch the next row
+		iterator& operator ++()
+		{
+			if (!res_->fetch_row_view()) {
+				res_ = 0;
+			}
+			return *this;
+		}
+
+		/// \brief Fetch the next row
+		///
+		/// Since fetching the next row invalidates the current one,
+		/// this returns void, not a copy of the old iterator.
+		void operator ++(int) { ++*this; }
+
+		/// \brief Returns true if both iterators are past the end, or
+		/// both refer to the same result set
+		bool operator ==(const iterator& rhs) const
+				{ return res_ == rhs.res_; }
+
+		/// \brief Inverse of operator ==()
+		bool operator !=(const iterator& rhs) const
+				{ return res_ != rhs.res_; }
+
+	private:
+		friend class UseQueryResult;
+
+		/// \brief Create an iterator pointing at \c res's current row,
+		/// or past the end if it has none
+		explicit iterator(const UseQueryResult* res) :
+		res_(res && res->view_ ? res : 0)
+		{
+		}
+
+		const UseQueryResult* res_;	///< null if past the end
+	};
+
+	/// \brief Same as iterator; rows are always read-only
+	typedef iterator const_iterator;
+
 	/// \brief Default constructor
 	UseQueryResult() :
 	ResultBase()
@@ -313,21 +523,68 @@ public:
 	{
 		copy(other);
 	}
+
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move constructor
+	///
+	/// Unlike a copy, this brings along the current row view, since
+	/// the moved-to object takes over the read position, too.
+	UseQueryResult(UseQueryResult&& other) :
+	ResultBase()
+	{
+		swap(other);
+	}
+#endif
 	
 	/// \brief Destroy object
 	~UseQueryResult() { }
 
+	/// \brief Fetch the next row, and return an iterator pointing at it
+	///
+	/// Note that this is not like a container's begin(): it fetches a
+	/// row, and there's no going back.  Calling it again continues on
+	/// from wherever the previous pass left off.
+	iterator begin() const
+	{
+		fetch_row_view();
+		return iterator(this);
+	}
+
+	/// \brief Return the past-the-end iterator
+	iterator end() const { return iterator(); }
+
 	/// \brief Copy another UseQueryResult object's data into this object
 	UseQueryResult& operator =(const UseQueryResult& rhs)
 			{ return this != &rhs ? copy(rhs) : *this; }
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move another UseQueryResult object's data into this
+	/// object
+	UseQueryResult& operator =(UseQueryResult&& rhs)
+	{
+		swap(rhs);
+		return *this;
+	}
+#endif
+
+	/// \brief Exchange contents with another UseQueryResult
+	///
+	/// The current row views go along with the result sets, since
+	/// each one belongs to its result set's read position.
+	void swap(UseQueryResult& other)
+	{
+		ResultBase::swap(other);
+		result_.swap(other.result_);
+		view_.row_.swap(other.view_.row_);
+	}
+
 	/// \brief Returns the next field in this result set
 	const Field& fetch_field() const
-			{ return fields_.at(current_field_++); }
+			{ return fields().at(current_field_++); }
 
 	/// \brief Returns the given field in this result set
 	const Field& fetch_field(Fields::size_type i) const
-			{ return fields_.at(i); }
+			{ return fields().at(i); }
 
 	/// \brief Returns the lengths of the fields in the current row of
 	/// the result set.
@@ -342,9 +599,34 @@ public:
 	/// lot of error checking before returning the Row object containing
 	/// the row data.
 	///
-	/// \sa fetch_raw_row()
+	/// \sa fetch_raw_row(), fetch_row_view()
 	Row fetch_row() const;
 
+	/// \brief Returns a view of the next row in a "use" query's
+	/// result set
+	///
+	/// This does the same error checking as fetch_row(), but instead of
+	/// copying the row data, it returns a view straight onto the C API
+	/// row buffer.  The view remains valid only until the next call to
+	/// any of the fetch functions on this object.  See RowView for
+	/// details.
+	///
+	/// When there are no more rows, the returned view tests as false in
+	/// bool context.
+	const RowView& fetch_row_view() const;
+
+	/// \brief Returns a modifiable view of the next row in a "use"
+	/// query's result set
+	///
+	/// Same as the const version, but the view's row() can be passed
+	/// to code taking a <tt>Row&</tt>, such as the functors
+	/// Query::for_each() calls.
+	RowView& fetch_row_view()
+	{
+		static_cast<const UseQueryResult*>(this)->fetch_row_view();
+		return view_;
+	}
+
 	/// \brief Wraps mysql_fetch_row() in MySQL C API.
 	///
 	/// \internal You almost certainly want to call fetch_row() instead.
@@ -399,6 +681,14 @@ private:
 	/// this has always been mutable and the resulting behavior hasn't 
 	/// confused anyone yet.
 	mutable RefCountedPointer<MYSQL_RES> result_;
+
+	/// \brief The view returned by fetch_row_view()
+	///
+	/// We keep this in the object and reuse it for every row so that
+	/// fetching a view doesn't allocate memory.  It isn't copied along
+	/// with the rest of the object, because the view belongs to this
+	/// object's read position in the result set, not to the result.
+	mutable RowView view_;
 };
 
 
@@ -406,18 +696,14 @@ private:
 inline void
 swap(StoreQueryResult& x, StoreQueryResult& y)
 {
-	StoreQueryResult tmp = x;
-	x = y;
-	y = tmp;
+	x.swap(y);
 }
 
 /// \brief Swaps two UseQueryResult objects
 inline void
 swap(UseQueryResult& x, UseQueryResult& y)
 {
-	UseQueryResult tmp = x;
-	x = y;
-	y = tmp;
+	x.swap(y);
 }
 
 } // end namespace mysqlpp
@@ -35,6 +35,24 @@ Row::Row(MYSQL_ROW row, const ResultBase* res,
 		const unsigned long* lengths, bool throw_exceptions) :
 OptionalExceptions(throw_exceptions),
 initialized_(false)
+{
+	init(row, res, lengths, 0);
+}
+
+
+Row::Row(MYSQL_ROW row, const ResultBase* res,
+		const unsigned long* lengths, const RefCountedArena& arena,
+		bool throw_exceptions) :
+OptionalExceptions(throw_exceptions),
+initialized_(false)
+{
+	init(row, res, lengths, &arena);
+}
+
+
+void
+Row::init(MYSQL_ROW row, const ResultBase* res,
+		const unsigned long* lengths, const RefCountedArena* arena)
 {
 	if (row) {
 		if (res) {
@@ -42,26 +60,86 @@ initialized_(false)
 			data_.reserve(size);
 			for (size_type i = 0; i < size; ++i) {
 				bool is_null = row[i] == 0;
-				data_.push_back(value_type(
-						is_null ? "NULL" : row[i],
-						is_null ? 4 : lengths[i],
-						res->field_type(int(i)),
-						is_null));
+				if (arena) {
+					// SQL nulls point at a string literal, so they don't
+					// take up any space in the arena.
+					data_.push_back(value_type(
+							is_null ? "NULL" :
+									(*arena)->copy(row[i], lengths[i]),
+							is_null ? 4 : lengths[i],
+							res->field_type(int(i)),
+							is_null, *arena));
+				}
+				else {
+					data_.push_back(value_type(
+							is_null ? "NULL" : row[i],
+							is_null ? 4 : lengths[i],
+							res->field_type(int(i)),
+							is_null));
+				}
 			}
 
 			field_names_ = res->field_names();
 			initialized_ = true;
 		}
-		else if (throw_exceptions) {
+		else if (throw_exceptions()) {
 			throw ObjectNotInitialized("RES is NULL");
 		}
 	}
-	else if (throw_exceptions) {
+	else if (throw_exceptions()) {
 		throw ObjectNotInitialized("ROW is NULL");
 	}
 }
 
 
+void
+Row::borrow(MYSQL_ROW row, const ResultBase* res,
+		const unsigned long* lengths)
+{
+	if (row && res && lengths) {
+		size_type size = res->num_fields();
+		if (data_.size() != size) {
+			data_.clear();
+			data_.resize(size);
+		}
+
+		for (size_type i = 0; i < size; ++i) {
+			bool is_null = row[i] == 0;
+			data_[i].borrow(is_null ? "NULL" : row[i],
+					is_null ? 4 : lengths[i],
+					res->field_type(int(i)), is_null);
+		}
+
+		if (field_names_ != res->field_names()) {
+			field_names_ = res->field_names();
+		}
+		initialized_ = true;
+	}
+	else {
+		initialized_ = false;
+	}
+}
+
+
+void
+Row::view(MYSQL_ROW row, const ResultBase* res,
+		const unsigned long* lengths, const RefCountedArena& arena)
+{
+	size_type size = res->num_fields();
+	data_.clear();
+	data_.reserve(size);
+	for (size_type i = 0; i < size; ++i) {
+		bool is_null = row[i] == 0;
+		data_.push_back(value_type(is_null ? "NULL" : row[i],
+				is_null ? 4 : lengths[i], res->field_type(int(i)),
+				is_null, arena));
+	}
+
+	field_names_ = res->field_names();
+	initialized_ = true;
+}
+
+
 Row::const_reference
 Row::at(size_type i) const
 {
@@ -201,5 +279,21 @@ Row::operator [](const char* field) const
 }
 
 
+const Row::value_type&
+Row::operator [](const ColumnRef& col) const
+{
+	size_type si = field_names_ ? col.index(field_names_) : size();
+	if (si < size()) {
+		return data_[si];
+	}
+	else if (throw_exceptions()) {
+		throw BadFieldName(col.name().c_str());
+	}
+	else {
+		static value_type empty;
+		return empty;
+	}
+}
+
 } // end namespace mysqlpp
 
@@ -30,11 +30,13 @@
 
 #include "common.h"
 
+#include "field_names.h"
 #include "mystring.h"
 #include "noexceptions.h"
 #include "refcounted.h"
 #include "vallist.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -42,8 +44,9 @@ namespace mysqlpp {
 
 #if !defined(DOXYGEN_IGNORE)
 // Make Doxygen ignore this
-class FieldNames;
 class MYSQLPP_EXPORT ResultBase;
+class MYSQLPP_EXPORT MappedResult;
+class MYSQLPP_EXPORT StoreQueryResult;
 #endif
 
 /// \brief Manages rows from a result set.
@@ -128,6 +131,18 @@ public:
 	{
 	}
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move constructor
+	///
+	/// Takes over the other row's field list, leaving \c r empty.
+	Row(Row&& r) :
+	OptionalExceptions(),
+	initialized_(false)
+	{
+		swap(r);
+	}
+#endif
+
 	/// \brief Create a row object
 	///
 	/// \param row MySQL C API row data
@@ -137,6 +152,18 @@ public:
 	Row(MYSQL_ROW row, const ResultBase* res,
 			const unsigned long* lengths, bool te = true);
 
+	/// \brief Create a row object whose fields are stored in an arena
+	///
+	/// \param row MySQL C API row data
+	/// \param res result set that the row comes from
+	/// \param lengths length of each item in row
+	/// \param arena arena to copy the row data into; the fields of the
+	/// new row will be String views onto this copy
+	/// \param te if true, throw exceptions on errors
+	Row(MYSQL_ROW row, const ResultBase* res,
+			const unsigned long* lengths, const RefCountedArena& arena,
+			bool te = true);
+
 	/// \brief Destroy object
 	~Row() { }
 
@@ -304,15 +331,46 @@ public:
 		return *this;
 	}
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move assignment operator
+	Row& operator =(Row&& rhs)
+	{
+		swap(rhs);
+		return *this;
+	}
+#endif
+
+	/// \brief Exchange contents with another Row
+	///
+	/// This swaps the field lists themselves, not their contents, so
+	/// it takes constant time and can't throw.  As with copying, each
+	/// object keeps its own exception setting.
+	void swap(Row& other)
+	{
+		data_.swap(other.data_);
+		field_names_.swap(other.field_names_);
+		std::swap(initialized_, other.initialized_);
+	}
+
 	/// \brief Get the value of a field given its name.
 	///
 	/// If the field does not exist in this row, we throw a BadFieldName
 	/// exception if exceptions are enabled, or an empty row if not.
 	/// An empty row tests as false in bool context.
 	///
-	/// This operator is fairly inefficient.  operator[](int) is faster.
+	/// This has to look the name up in the result set's field name
+	/// index every time.  That's fast, but operator[](int) and
+	/// operator[](const ColumnRef&) are faster.
 	const_reference operator [](const char* field) const;
 
+	/// \brief Get the value of a field given a ColumnRef handle
+	///
+	/// This only has to look the field name up for the first row it
+	/// sees from a given result set.  After that, it's about as fast
+	/// as operator[](int).  Errors are handled the same way as for
+	/// operator[](const char*).
+	const_reference operator [](const ColumnRef& col) const;
+
 	/// \brief Get the value of a field given its index.
 	///
 	/// This function is just syntactic sugar, wrapping the at() method.
@@ -521,11 +579,59 @@ public:
 	}
 
 private:
+	/// \brief Common implementation of the ctors taking C API data
+	void init(MYSQL_ROW row, const ResultBase* res,
+			const unsigned long* lengths, const RefCountedArena* arena);
+
+	/// \brief Turn this object into a set of borrowed String views
+	/// onto the C API's row buffer
+	///
+	/// This is how RowView avoids copying the row data.  We reuse our
+	/// existing field list when the field count hasn't changed, so
+	/// after the first row, this doesn't allocate any memory at all.
+	/// Pass a null \c row to mark the object as uninitialized, as at
+	/// the end of a result set.
+	void borrow(MYSQL_ROW row, const ResultBase* res,
+			const unsigned long* lengths);
+
+	/// \brief Fill this object with String views onto data held by
+	/// an arena, without copying it
+	///
+	/// This is how MappedResult hands out rows pointing into its
+	/// memory-mapped file, and how a StoreQueryResult in view mode
+	/// points into the C API's result set.  The data must already be
+	/// null-terminated.
+	void view(MYSQL_ROW row, const ResultBase* res,
+			const unsigned long* lengths, const RefCountedArena& arena);
+
+	friend class MappedResult;
+	friend class RowView;
+	friend class StoreQueryResult;
+
 	list_type data_;
 	RefCountedPointer<FieldNames> field_names_;
 	bool initialized_;
 };
 
+/// \brief Swaps two Row objects
+inline void
+swap(Row& x, Row& y)
+{
+	x.swap(y);
+}
+
 } // end namespace mysqlpp
 
+#if !defined(DOXYGEN_IGNORE)
+// See the matching specialization in mystring.h for why this is here
+namespace std {
+	template <>
+	inline void
+	swap(mysqlpp::Row& x, mysqlpp::Row& y)
+	{
+		x.swap(y);
+	}
+}
+#endif // !defined(DOXYGEN_IGNORE)
+
 #endif // !defined(MYSQLPP_ROW_H)
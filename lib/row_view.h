@@ -0,0 +1,190 @@
+/// \file row_view.h
+/// \brief Declares the RowView class, a non-owning view of one row in
+/// a "use" query's result set.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_ROW_VIEW_H)
+#define MYSQLPP_ROW_VIEW_H
+
+#include "common.h"
+
+#include "row.h"
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Make Doxygen ignore this
+class MYSQLPP_EXPORT UseQueryResult;
+#endif
+
+/// \brief A read-only view of the current row in a "use" query's
+/// result set
+///
+/// UseQueryResult::fetch_row() returns a Row holding its own copy of
+/// every field, which costs a few heap allocations per field.  When
+/// you're just streaming through a large result set, that copying can
+/// easily dominate the run time.  UseQueryResult::fetch_row_view()
+/// instead gives you one of these, which points straight into the
+/// MySQL C API's row buffer.  Once the first row has been fetched,
+/// fetching more rows this way doesn't allocate any memory at all.
+///
+/// The catch is that the C API reuses its row buffer, so a RowView is
+/// only good until the next fetch on the same result set.  Any data
+/// you want to keep past that point must be copied out.  This is
+/// easier than it sounds: copying one of the String objects in the
+/// view gives the copy its own buffer, as does to_row() for the row as
+/// a whole.  What you must not do is keep a reference or pointer to
+/// anything inside the view.
+///
+/// \code
+///   mysqlpp::UseQueryResult res = query.use();
+///   while (const mysqlpp::RowView& view = res.fetch_row_view()) {
+///       total += int(view[1]);
+///       if (view["flagged"] == "Y") {
+///           keepers.push_back(view.to_row());
+///       }
+///   }
+/// \endcode
+
+class MYSQLPP_EXPORT RowView
+{
+private:
+	/// \brief Pointer to bool data member, for use by safe bool
+	/// conversion operator.
+	///
+	/// \see http://www.artima.com/cppsource/safebool.html
+	typedef bool RowView::*private_bool_type;
+
+public:
+	/// \brief constant iterator type
+	typedef Row::const_iterator const_iterator;
+
+	/// \brief constant reference type
+	typedef Row::const_reference const_reference;
+
+	/// \brief iterator type; same as const_iterator
+	typedef const_iterator iterator;
+
+	/// \brief type of returned sizes
+	typedef Row::size_type size_type;
+
+	/// \brief Create an empty view, one that tests as false in bool
+	/// context
+	RowView() :
+	valid_(false)
+	{
+	}
+
+	/// \brief Get a const reference to the field given its index
+	///
+	/// \throw mysqlpp::BadIndex if the view is empty or there are
+	/// less than \c i fields in the row.
+	const_reference at(size_type i) const { return row_.at(i); }
+
+	/// \brief Return a const iterator pointing to first field in the
+	/// row
+	const_iterator begin() const { return row_.begin(); }
+
+	/// \brief Returns true if the view has no fields
+	bool empty() const { return row_.empty(); }
+
+	/// \brief Return a const iterator pointing to one past the last
+	/// field in the row
+	const_iterator end() const { return row_.end(); }
+
+	/// \brief Returns a field's index given its name
+	size_type field_num(const char* name) const
+			{ return row_.field_num(name); }
+
+	/// \brief Get the value of a field given its name
+	///
+	/// \sa Row::operator[](const char*)
+	const_reference operator [](const char* field) const
+			{ return row_[field]; }
+
+	/// \brief Get the value of a field given a ColumnRef handle
+	///
+	/// \sa Row::operator[](const ColumnRef&)
+	const_reference operator [](const ColumnRef& col) const
+			{ return row_[col]; }
+
+	/// \brief Get the value of a field given its index
+	///
+	/// \sa Row::operator[](int)
+	const_reference operator [](int i) const { return row_[i]; }
+
+	/// \brief Returns true if the view refers to a row of data
+	///
+	/// Like Row, this lets you tell when you've run off the end of the
+	/// result set.
+	operator private_bool_type() const
+	{
+		return row_ ? &RowView::valid_ : 0;
+	}
+
+	/// \brief Get the view as a Row, without copying it
+	///
+	/// This is for passing the current row to code that takes a
+	/// <tt>const Row&</tt>, such as an SSQLS's constructor.  The same
+	/// lifetime rules apply as for the view itself: the Row is only
+	/// valid until the next fetch, but any copy you make of it owns
+	/// its own data.
+	const Row& row() const { return row_; }
+
+	/// \brief Get the view as a modifiable Row, without copying it
+	///
+	/// For passing the current row to code written for <tt>Row&</tt>,
+	/// such as the functors Query::for_each() calls.  Anything done to
+	/// the Row is lost at the next fetch.
+	Row& row() { return row_; }
+
+	/// \brief Get the number of fields in the row
+	size_type size() const { return row_.size(); }
+
+	/// \brief Return an owning copy of the row
+	///
+	/// Use this when you want to keep a row past the next fetch.
+	Row to_row() const { return row_; }
+
+private:
+	/// \brief Point the view at a new row of C API data
+	///
+	/// Pass a null \c row to mark the end of the result set.
+	void assign(MYSQL_ROW row, const ResultBase* res,
+			const unsigned long* lengths, bool te)
+	{
+		row_.set_exceptions(te);
+		row_.borrow(row, res, lengths);
+	}
+
+	Row row_;		///< set of borrowed Strings
+	bool valid_;	///< only used by safe bool operator
+
+	friend class UseQueryResult;
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_ROW_VIEW_H)
@@ -0,0 +1,215 @@
+/***********************************************************************
+ schema_cache.cpp - Implements the ResultSchema and SchemaCache classes.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "schema_cache.h"
+
+#include <string.h>
+
+namespace mysqlpp {
+
+// Mix a C string into a 32-bit FNV-1a hash, including its terminator
+// so that "ab","c" and "a","bc" hash differently.
+static unsigned int
+hash_string(unsigned int h, const char* s)
+{
+	if (s) {
+		while (*s) {
+			h ^= static_cast<unsigned char>(*s++);
+			h *= 16777619U;
+		}
+	}
+	h *= 16777619U;
+	return h;
+}
+
+
+// Mix an integer into a 32-bit FNV-1a hash
+static unsigned int
+hash_number(unsigned int h, unsigned long n)
+{
+	for (size_t i = 0; i < sizeof(n); ++i) {
+		h ^= static_cast<unsigned char>(n >> (i * 8));
+		h *= 16777619U;
+	}
+	return h;
+}
+
+
+// Compare a C API string to one a Field copied, treating a null
+// pointer as the empty string like std::string would
+static bool
+same_string(const char* s, const char* field)
+{
+	return strcmp(s ? s : "", field) == 0;
+}
+
+
+ResultSchema::ResultSchema(const MYSQL_FIELD* fields, size_t count)
+{
+	init(fields, count);
+	names_ = new FieldNames(fields_);
+	types_ = new FieldTypes(fields_);
+}
+
+
+ResultSchema::ResultSchema(const ResultSchema& shape,
+		const MYSQL_FIELD* fields) :
+RefCounted(),
+names_(shape.names_),
+types_(shape.types_)
+{
+	init(fields, shape.fields_.size());
+}
+
+
+size_t
+ResultSchema::bytes_used() const
+{
+	size_t bytes = sizeof(*this) + fields_.capacity() * sizeof(Field) +
+			keys_.capacity() * sizeof(column_key);
+	for (Fields::const_iterator it = fields_.begin();
+			it != fields_.end(); ++it) {
+		bytes += strlen(it->name()) + strlen(it->table()) +
+				strlen(it->db()) + 3;
+	}
+	if (names_) {
+		bytes += names_->bytes_used();
+	}
+	if (types_) {
+		bytes += sizeof(FieldTypes) +
+				types_->capacity() * sizeof(mysql_type_info);
+	}
+	return bytes;
+}
+
+
+unsigned int
+ResultSchema::hash(const MYSQL_FIELD* fields, size_t count)
+{
+	unsigned int h = 2166136261U;
+	for (size_t i = 0; i < count; ++i) {
+		const MYSQL_FIELD& f = fields[i];
+		h = hash_string(h, f.name);
+		h = hash_string(h, f.table);
+#if MYSQL_VERSION_ID > 40000	// only in 4.0 +
+		h = hash_string(h, f.db);
+#endif
+		h = hash_number(h, f.type);
+		h = hash_number(h, f.flags);
+		h = hash_number(h, f.length);
+	}
+	return h;
+}
+
+
+void
+ResultSchema::init(const MYSQL_FIELD* fields, size_t count)
+{
+	fields_.reserve(count);
+	keys_.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		fields_.push_back(Field(fields + i));
+		column_key key = { fields[i].type, fields[i].flags };
+		keys_.push_back(key);
+	}
+}
+
+
+bool
+ResultSchema::matches(const MYSQL_FIELD* fields, size_t count) const
+{
+	if (count != fields_.size()) {
+		return false;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		const MYSQL_FIELD& f = fields[i];
+		const Field& mine = fields_[i];
+		if ((f.length != mine.length()) ||
+				(f.type != keys_[i].type) ||
+				(f.flags != keys_[i].flags) ||
+				!same_string(f.name, mine.name()) ||
+				!same_string(f.table, mine.table())
+#if MYSQL_VERSION_ID > 40000	// only in 4.0 +
+				|| !same_string(f.db, mine.db())
+#endif
+				) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool
+ResultSchema::same_max_lengths(const MYSQL_FIELD* fields) const
+{
+	for (size_t i = 0; i < fields_.size(); ++i) {
+		if (fields[i].max_length != fields_[i].max_length()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+RefCountedPointer<ResultSchema>
+SchemaCache::get(const MYSQL_FIELD* fields, size_t count)
+{
+	if (capacity_ == 0) {
+		++misses_;
+		return RefCountedPointer<ResultSchema>(
+				new ResultSchema(fields, count));
+	}
+
+	const unsigned int h = ResultSchema::hash(fields, count);
+	std::pair<map_type::iterator, map_type::iterator> range =
+			schemas_.equal_range(h);
+	for (map_type::iterator it = range.first; it != range.second; ++it) {
+		if (it->second->matches(fields, count)) {
+			++hits_;
+			if (it->second->same_max_lengths(fields)) {
+				return it->second;
+			}
+			else {
+				// Same columns, but a result set from "store" has
+				// max_length values that depend on the data.  Give
+				// this one its own Field list, sharing the rest.
+				return RefCountedPointer<ResultSchema>(
+						new ResultSchema(*it->second, fields));
+			}
+		}
+	}
+
+	++misses_;
+	RefCountedPointer<ResultSchema> schema(new ResultSchema(fields, count));
+	if (schemas_.size() >= capacity_) {
+		clear();
+	}
+	schemas_.insert(map_type::value_type(h, schema));
+	return schema;
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,207 @@
+/// \file schema_cache.h
+/// \brief Declares the ResultSchema and SchemaCache classes, which let
+/// result sets with the same columns share one description of them.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_SCHEMA_CACHE_H)
+#define MYSQLPP_SCHEMA_CACHE_H
+
+#include "common.h"
+
+#include "field.h"
+#include "field_names.h"
+#include "field_types.h"
+#include "refcounted.h"
+
+#include <map>
+#include <vector>
+
+namespace mysqlpp {
+
+/// \brief Immutable description of the columns in a result set
+///
+/// This holds everything ResultBase knows about a result set's columns:
+/// the Field list, the FieldNames list with its name index, and the
+/// FieldTypes list.  Building all that takes a fair number of small
+/// heap allocations, so results with the same columns share one of
+/// these via SchemaCache rather than each building its own.
+///
+/// Nothing changes one of these once it's built, so it's safe to share
+/// between results, and between threads.
+
+class MYSQLPP_EXPORT ResultSchema : public RefCounted
+{
+public:
+	/// \brief Build a description of the given C API fields
+	///
+	/// \param fields array of field descriptions, as from
+	/// \c mysql_fetch_fields()
+	/// \param count number of elements in \c fields
+	ResultSchema(const MYSQL_FIELD* fields, size_t count);
+
+	/// \brief Build a description of fields with the same shape as
+	/// another description, sharing its name and type lists
+	///
+	/// SchemaCache uses this when all that differs between two result
+	/// sets is Field::max_length(), which depends on the data.
+	ResultSchema(const ResultSchema& shape, const MYSQL_FIELD* fields);
+
+	/// \brief Return the number of bytes this object uses on the heap
+	size_t bytes_used() const;
+
+	/// \brief Get the list of field descriptions
+	const Fields& fields() const { return fields_; }
+
+	/// \brief Return a hash of the given fields' descriptions
+	///
+	/// Fields that would compare equal with matches() hash to the same
+	/// value.
+	static unsigned int hash(const MYSQL_FIELD* fields, size_t count);
+
+	/// \brief Returns true if this object describes the given fields,
+	/// ignoring their \c max_length values
+	bool matches(const MYSQL_FIELD* fields, size_t count) const;
+
+	/// \brief Returns true if the given fields' \c max_length values
+	/// are the same as ours
+	bool same_max_lengths(const MYSQL_FIELD* fields) const;
+
+	/// \brief Get the list of field names
+	const RefCountedPointer<FieldNames>& names() const { return names_; }
+
+	/// \brief Get the list of field types
+	const RefCountedPointer<FieldTypes>& types() const { return types_; }
+
+private:
+	// Can't copy or assign; there's never a need, since you can just
+	// share the original.
+	ResultSchema(const ResultSchema&);
+	ResultSchema& operator =(const ResultSchema&);
+
+	/// \brief Fill fields_ and keys_ from the C API's field list
+	void init(const MYSQL_FIELD* fields, size_t count);
+
+	/// \brief The parts of a MYSQL_FIELD that matches() compares but
+	/// that Field doesn't let us get at in their original form
+	struct column_key {
+		enum_field_types type;	///< C API type code
+		unsigned int flags;		///< C API field flags
+	};
+
+	Fields fields_;		///< description of each field
+	RefCountedPointer<FieldNames> names_;	///< names, with index
+	RefCountedPointer<FieldTypes> types_;	///< SQL type of each field
+	std::vector<column_key> keys_;	///< raw type and flags per field
+};
+
+
+/// \brief Remembers the column descriptions of recent result sets, so
+/// later result sets with the same columns can share them
+///
+/// Each DBDriver, and so each Connection, has one of these.  ResultBase
+/// looks up each new result set's columns here, and only builds a new
+/// ResultSchema if it hasn't seen those columns before.  A program that
+/// runs the same few queries over and over builds their metadata once
+/// instead of on every query.  A nice side effect is that a ColumnRef
+/// that has looked up its index in one result set's names doesn't have
+/// to look it up again for the next.
+///
+/// Entries match only if every column's name, table, database, type,
+/// flags and length are the same, so a schema change on the server
+/// simply causes a miss.  When the cache fills up, it starts over
+/// empty; it's meant to hold a program's handful of hot queries, not
+/// every query it ever runs.
+///
+/// You can get at a connection's cache through Connection::driver().
+/// Setting its capacity to 0 turns it off.
+
+class MYSQLPP_EXPORT SchemaCache
+{
+public:
+	/// \brief Type of entry counts
+	typedef size_t size_type;
+
+	/// \brief Create an empty cache
+	///
+	/// \param capacity number of distinct column lists to remember
+	explicit SchemaCache(size_type capacity = 128) :
+	capacity_(capacity),
+	hits_(0),
+	misses_(0)
+	{
+	}
+
+	/// \brief Get the number of distinct column lists we remember
+	size_type capacity() const { return capacity_; }
+
+	/// \brief Set the number of distinct column lists to remember
+	///
+	/// If the new capacity is less than the current size(), this
+	/// empties the cache.
+	void capacity(size_type n)
+	{
+		capacity_ = n;
+		if (schemas_.size() > capacity_) {
+			clear();
+		}
+	}
+
+	/// \brief Forget all remembered column lists
+	///
+	/// Result sets already using them keep them.
+	void clear() { schemas_.clear(); }
+
+	/// \brief Find or build a description of the given fields
+	///
+	/// \param fields array of field descriptions, as from
+	/// \c mysql_fetch_fields()
+	/// \param count number of elements in \c fields
+	RefCountedPointer<ResultSchema> get(const MYSQL_FIELD* fields,
+			size_t count);
+
+	/// \brief Return the number of times get() found a match
+	ulonglong hits() const { return hits_; }
+
+	/// \brief Return the number of times get() had to build a new
+	/// description
+	ulonglong misses() const { return misses_; }
+
+	/// \brief Return the number of column lists we remember
+	size_type size() const { return schemas_.size(); }
+
+private:
+	/// \brief Remembered descriptions, keyed by ResultSchema::hash()
+	typedef std::multimap<unsigned int, RefCountedPointer<ResultSchema> >
+			map_type;
+
+	map_type schemas_;		///< remembered descriptions
+	size_type capacity_;	///< max entries before we start over
+	ulonglong hits_;		///< number of get() calls that found a match
+	ulonglong misses_;		///< number of get() calls that didn't
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_SCHEMA_CACHE_H)
@@ -70,22 +70,25 @@ SQLBuffer::quote_q() const
 void
 SQLBuffer::replace_buffer(const char* pd, size_type length)
 {
-	delete[] data_;
-	data_ = 0;
-	length_ = 0;
-
+	// Fill the new buffer before releasing the old one, in case pd
+	// points into it.
+	char* pnew = 0;
 	if (pd) {
-		// The casts for the data member are because the C type system
-		// can't distinguish initialization from modification when it
-		// happens in 2 steps like this.
-		// 
+		// Short values go in the object itself.  memmove() because pd
+		// may be pointing into inline_ already.
+		//
 		// We cast away const for pd in case we're on a system that uses
 		// the old definition of memcpy() with non-const 2nd parameter.
-		data_ = new char[length + 1];
-		length_ = length;
-		memcpy(const_cast<char*>(data_), const_cast<char*>(pd), length_);
-		const_cast<char*>(data_)[length_] = '\0';
+		pnew = length <= inline_capacity ? inline_ : new char[length + 1];
+		memmove(pnew, const_cast<char*>(pd), length);
+		pnew[length] = '\0';
+	}
+
+	if (data_ != pnew) {
+		free_buffer();
 	}
+	data_ = pnew;
+	length_ = pnew ? length : 0;
 }
 
 } // end namespace mysqlpp
@@ -37,17 +37,26 @@ namespace mysqlpp {
 
 /// \brief Holds SQL data in string form plus type information for use
 /// in converting the string to compatible C++ data types.
+///
+/// Most SQL values are short: integers, dates, flags, and the like.
+/// Values up to \c inline_capacity bytes long are stored inside the
+/// object itself, so creating a buffer for one costs no allocation
+/// beyond that of the SQLBuffer object.  Only longer values get a
+/// separate heap block.
 
-class SQLBuffer
+class SQLBuffer : public RefCounted
 {
 public:
 	/// \brief Type of length values
 	typedef size_t size_type;
 
+	/// \brief Longest value we store without a separate heap block
+	enum { inline_capacity = 22 };
+
 	/// \brief Initialize object as a copy of a raw data buffer
 	///
-	/// Copies the string into a new buffer one byte longer than
-	/// the length value given, using that to hold a C string null
+	/// Copies the string into a buffer one byte longer than the
+	/// length value given, using that to hold a C string null
 	/// terminator, just for safety.  The length value we keep does
 	/// not include this extra byte, allowing this same mechanism
 	/// to work for both C strings and binary data.
@@ -64,7 +73,7 @@ public:
 	}
 
 	/// \brief Destructor
-	~SQLBuffer() { delete[] data_; }
+	~SQLBuffer() { free_buffer(); }
 
 	/// \brief Replace contents of buffer with copy of given C string
 	SQLBuffer& assign(const char* data, size_type length,
@@ -122,10 +131,19 @@ private:
 	/// \brief Implementation detail of assign() and init()
 	void replace_buffer(const char* pd, size_type length);
 
+	/// \brief Release data_ if it's a heap block
+	void free_buffer()
+	{
+		if (data_ != inline_) {
+			delete[] data_;
+		}
+	}
+
 	const char* data_;		///< pointer to the raw data buffer
 	size_type length_;		///< bytes in buffer, without trailing null
 	mysql_type_info type_;	///< SQL type of data in the buffer
 	bool is_null_;			///< if true, string represents a SQL null
+	char inline_[inline_capacity + 1];	///< storage for short values
 };
 
 
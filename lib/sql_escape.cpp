@@ -0,0 +1,243 @@
+/***********************************************************************
+ sql_escape.cpp - Implements the string escaping engine DBDriver uses
+	for character sets where it gives the same result as the C API.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#define MYSQLPP_NOT_HEADER
+#include "common.h"
+
+#include "sql_escape.h"
+
+#include <string.h>
+
+// SSE2 is part of every x86-64 CPU, so 64-bit builds always get the
+// vector scanner.  Others fall back to checking 8 bytes at a time in an
+// ordinary register.
+#if defined(__SSE2__) || defined(_M_X64) || \
+		(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define MYSQLPP_ESCAPE_SSE2
+#	include <emmintrin.h>
+#endif
+
+namespace mysqlpp {
+namespace internal {
+
+// Returns the character to put after the backslash when escaping c,
+// or 0 if c doesn't need escaping.  This is the same table
+// mysql_real_escape_string() uses.
+static inline char
+escape_char(char c)
+{
+	switch (c) {
+		case '\0':		return '0';
+		case '\n':		return 'n';
+		case '\r':		return 'r';
+		case '\032':	return 'Z';
+		case '\\':		return '\\';
+		case '\'':		return '\'';
+		case '"':		return '"';
+		default:		return 0;
+	}
+}
+
+
+// Byte-at-a-time scan, for the tail end of the text and for finding
+// which byte in a word caused a hit
+static inline const char*
+find_escapable_slow(const char* p, const char* end)
+{
+	while (p != end && !escape_char(*p)) {
+		++p;
+	}
+	return p;
+}
+
+
+#if defined(MYSQLPP_ESCAPE_SSE2)
+// Returns a mask with one bit set for each of the 16 bytes at p that
+// needs escaping, lowest bit first
+static inline int
+escapable_mask(const char* p)
+{
+	const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	__m128i hits = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+	hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+	hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+	hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8('\032')));
+	hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+	hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+	hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+	return _mm_movemask_epi8(hits);
+}
+
+
+// Returns the index of the lowest set bit in a nonzero mask
+static inline int
+lowest_bit(int mask)
+{
+#	if defined(__GNUC__)
+	return __builtin_ctz(static_cast<unsigned int>(mask));
+#	else
+	int i = 0;
+	while (!(mask & 1)) {
+		mask >>= 1;
+		++i;
+	}
+	return i;
+#	endif
+}
+#elif !defined(MYSQLPP_NO_LONG_LONGS)
+// Returns nonzero if any byte of chunk equals c.  XORing with c zeroes
+// the matching bytes, and the subtraction then borrows into their high
+// bits.  Bytes above a true match can also show up, but we only want
+// to know whether there is one.
+static inline ulonglong
+has_byte(ulonglong chunk, char c)
+{
+	const ulonglong ones = 0x0101010101010101ULL;
+	const ulonglong x = chunk ^ (ones * static_cast<unsigned char>(c));
+	return (x - ones) & ~x & (ones << 7);
+}
+
+
+// Returns nonzero if any of the 8 bytes at p needs escaping
+static inline ulonglong
+has_escapable(const char* p)
+{
+	ulonglong chunk;
+	memcpy(&chunk, p, sizeof(chunk));
+	return has_byte(chunk, '\0') | has_byte(chunk, '\n') |
+			has_byte(chunk, '\r') | has_byte(chunk, '\032') |
+			has_byte(chunk, '\\') | has_byte(chunk, '\'') |
+			has_byte(chunk, '"');
+}
+#endif
+
+
+const char*
+find_escapable(const char* p, const char* end)
+{
+#if defined(MYSQLPP_ESCAPE_SSE2)
+	// Two vectors per loop iteration, so the loop overhead and the
+	// branch on the result are paid once per 32 bytes
+	while (end - p >= 32) {
+		const int lo = escapable_mask(p);
+		const int hi = escapable_mask(p + 16);
+		if (lo | hi) {
+			return p + (lo ? lowest_bit(lo) : 16 + lowest_bit(hi));
+		}
+		p += 32;
+	}
+	if (end - p >= 16) {
+		const int mask = escapable_mask(p);
+		if (mask) {
+			return p + lowest_bit(mask);
+		}
+		p += 16;
+	}
+#elif !defined(MYSQLPP_NO_LONG_LONGS)
+	while (end - p >= 8) {
+		if (has_escapable(p)) {
+			return find_escapable_slow(p, p + 8);
+		}
+		p += 8;
+	}
+#endif
+
+	return find_escapable_slow(p, end);
+}
+
+
+size_t
+escape_sql(char* to, const char* from, size_t length)
+{
+	char* out = to;
+	const char* const end = from + length;
+	for (;;) {
+		// Copy the run of text up to the next byte needing escaping,
+		// which for most strings is all of it
+		const char* hit = find_escapable(from, end);
+		memcpy(out, from, hit - from);
+		out += hit - from;
+		if (hit == end) {
+			break;
+		}
+
+		*out++ = '\\';
+		*out++ = escape_char(*hit);
+		from = hit + 1;
+	}
+
+	*out = '\0';
+	return out - to;
+}
+
+
+size_t
+escape_tsv(char* to, const char* from, size_t length)
+{
+	char* out = to;
+	const char* const end = from + length;
+	for (; from != end; ++from) {
+		char c;
+		switch (*from) {
+			case '\0':	c = '0'; break;
+			case '\t':	c = 't'; break;
+			case '\n':	c = 'n'; break;
+			case '\r':	c = 'r'; break;
+			case '\\':	c = '\\'; break;
+			default:	*out++ = *from; continue;
+		}
+		*out++ = '\\';
+		*out++ = c;
+	}
+
+	return out - to;
+}
+
+
+bool
+escape_sql_safe(const char* charset)
+{
+	// Names as mysql_character_set_name() gives them.  Character sets
+	// not listed here aren't necessarily unsafe; we just haven't
+	// checked, so they go through the C API.
+	static const char* const safe[] = {
+		"ascii", "binary", "cp1250", "cp1251", "cp1256", "cp1257",
+		"latin1", "latin2", "latin5", "latin7", "utf8", "utf8mb3",
+		"utf8mb4"
+	};
+
+	if (charset) {
+		for (size_t i = 0; i < sizeof(safe) / sizeof(safe[0]); ++i) {
+			if (strcmp(charset, safe[i]) == 0) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+} // end namespace mysqlpp::internal
+} // end namespace mysqlpp
@@ -0,0 +1,98 @@
+/// \file sql_escape.h
+/// \brief Declares the string escaping engine DBDriver uses when it
+/// can do without the C API's.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_SQL_ESCAPE_H)
+#define MYSQLPP_SQL_ESCAPE_H
+
+#include "common.h"
+
+#include <stddef.h>
+
+namespace mysqlpp {
+	namespace internal {
+		/// \brief Find the first byte in a block of text that needs
+		/// escaping inside an SQL string
+		///
+		/// Those bytes are NUL, newline, carriage return, Ctrl-Z,
+		/// backslash and both quote characters.  Where the CPU allows,
+		/// this checks 32 bytes per loop iteration, so text with
+		/// nothing to escape costs little more than a memchr().
+		///
+		/// \param from start of the text
+		/// \param end one past the end of the text
+		///
+		/// \retval pointer to the first byte that needs escaping, or
+		/// \c end if there are none
+		MYSQLPP_EXPORT const char* find_escapable(const char* from,
+				const char* end);
+
+		/// \brief Backslash-escape a block of text for use inside an
+		/// SQL string
+		///
+		/// This gives the same result as \c mysql_real_escape_string()
+		/// does for the character sets escape_sql_safe() accepts, but
+		/// copies runs of text that need no escaping in one go.
+		///
+		/// \param to buffer to hold the escaped text; must have room
+		/// for at least (length * 2 + 1) bytes
+		/// \param from text to escape
+		/// \param length number of bytes in \c from
+		///
+		/// \retval number of bytes placed in \c to, not counting the
+		/// null terminator it also writes
+		MYSQLPP_EXPORT size_t escape_sql(char* to, const char* from,
+				size_t length);
+
+		/// \brief Escape a block of text as a field in the tab-separated
+		/// format LOAD DATA reads by default
+		///
+		/// Backslash, tab, newline, carriage return and NUL get a
+		/// backslash escape; everything else is copied as is.
+		///
+		/// \param to buffer to hold the escaped text; must have room
+		/// for at least (length * 2) bytes
+		/// \param from text to escape
+		/// \param length number of bytes in \c from
+		///
+		/// \retval number of bytes placed in \c to; unlike
+		/// escape_sql(), this doesn't null-terminate the result
+		MYSQLPP_EXPORT size_t escape_tsv(char* to, const char* from,
+				size_t length);
+
+		/// \brief Returns true if escape_sql() gives the same result
+		/// as the C API for text in the named character set
+		///
+		/// That's so for single-byte character sets and for UTF-8,
+		/// where no byte of a multibyte character can be mistaken for
+		/// one escape_sql() cares about.  In others, such as GBK and
+		/// Shift-JIS, a backslash byte can be the second half of a
+		/// character, so only the C API knows what to do.
+		MYSQLPP_EXPORT bool escape_sql_safe(const char* charset);
+	} // end namespace mysqlpp::internal
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_SQL_ESCAPE_H)
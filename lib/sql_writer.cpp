@@ -0,0 +1,314 @@
+/***********************************************************************
+ sql_writer.cpp - Implements the SQLWriter class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "sql_writer.h"
+
+#include "datetime.h"
+#include "dbdriver.h"
+#include "sql_escape.h"
+
+#include <limits>
+
+#include <limits.h>
+#include <locale.h>
+#include <stdio.h>
+
+using namespace std;
+
+namespace mysqlpp {
+
+SQLWriter::SQLWriter(const SQLWriter& other) :
+std::streambuf()
+{
+	append(other.data(), other.length());
+}
+
+
+SQLWriter&
+SQLWriter::operator =(const SQLWriter& rhs)
+{
+	if (this != &rhs) {
+		clear();
+		append(rhs.data(), rhs.length());
+	}
+
+	return *this;
+}
+
+
+void
+SQLWriter::advance(size_t n)
+{
+	// pbump() only takes an int
+	while (n > INT_MAX) {
+		pbump(INT_MAX);
+		n -= INT_MAX;
+	}
+	pbump(static_cast<int>(n));
+}
+
+
+SQLWriter&
+SQLWriter::append_date(const Date& d)
+{
+	make_room(Date::max_length);
+	advance(d.format(pptr()));
+	return *this;
+}
+
+
+SQLWriter&
+SQLWriter::append_datetime(const DateTime& dt)
+{
+	make_room(DateTime::max_length);
+	advance(dt.format(pptr()));
+	return *this;
+}
+
+
+SQLWriter&
+SQLWriter::append_double(double value)
+{
+	typedef numeric_limits<double> nld;
+	if (value != value ||
+			(nld::has_infinity && (value == nld::infinity() ||
+			value == -nld::infinity()))) {
+		// Same as SQLTypeAdapter(double): SQL can't express these, so
+		// write a 0 to at least keep the statement valid.
+		return append('0');
+	}
+
+	// %.17g is what an ostream with precision(17) does, but it uses
+	// the C locale's decimal point, which SQL may not understand.
+	char buf[32];
+	int len = snprintf(buf, sizeof(buf), "%.17g", value);
+	const char point = *localeconv()->decimal_point;
+	if (point != '.') {
+		char* p = static_cast<char*>(memchr(buf, point, len));
+		if (p) {
+			*p = '.';
+		}
+	}
+
+	return append(buf, len);
+}
+
+
+SQLWriter&
+SQLWriter::append_escaped(const char* text, size_t length,
+		DBDriver* driver)
+{
+	// Escaping can at most double the text, plus the C API wants room
+	// for a null terminator.
+	make_room(length * 2 + 1);
+	advance(driver ?
+			driver->escape_string(pptr(), text, length) :
+			DBDriver::escape_string_no_conn(pptr(), text, length));
+	return *this;
+}
+
+
+SQLWriter&
+SQLWriter::append_int(longlong value)
+{
+	if (value < 0) {
+		append('-');
+		// Negate in unsigned arithmetic so LLONG_MIN works
+		return append_uint(0 - static_cast<ulonglong>(value));
+	}
+	else {
+		return append_uint(static_cast<ulonglong>(value));
+	}
+}
+
+
+SQLWriter&
+SQLWriter::append_quoted(const char* text, size_t length,
+		DBDriver* driver)
+{
+	make_room(length * 2 + 3);
+	append('\'');
+	append_escaped(text, length, driver);
+	return append('\'');
+}
+
+
+SQLWriter&
+SQLWriter::append_time(const Time& t)
+{
+	make_room(Time::max_length);
+	advance(t.format(pptr()));
+	return *this;
+}
+
+
+SQLWriter&
+SQLWriter::append_tsv(const char* text, size_t length)
+{
+	make_room(length * 2);
+	advance(internal::escape_tsv(pptr(), text, length));
+	return *this;
+}
+
+
+SQLWriter&
+SQLWriter::append_uint(ulonglong value)
+{
+	// Build the digits backward from the end of a scratch buffer
+	char buf[24];
+	char* p = buf + sizeof(buf);
+	do {
+		*--p = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+	while (value);
+
+	return append(p, buf + sizeof(buf) - p);
+}
+
+
+SQLWriter::int_type
+SQLWriter::overflow(int_type c)
+{
+	if (traits_type::eq_int_type(c, traits_type::eof())) {
+		return traits_type::not_eof(c);
+	}
+
+	append(traits_type::to_char_type(c));
+	return c;
+}
+
+
+void
+SQLWriter::reserve(size_t n)
+{
+	if (n <= buffer_.size()) {
+		return;
+	}
+
+	// Grow geometrically, so a statement built up a piece at a time
+	// doesn't get copied over and over
+	size_t len = length();
+	size_t size = buffer_.size() * 2;
+	buffer_.resize(size < n ? (n < 256 ? 256 : n) : size);
+	setp(begin(), end());
+	advance(len);
+}
+
+
+SQLWriter::pos_type
+SQLWriter::seekoff(off_type off, std::ios_base::seekdir way,
+		std::ios_base::openmode which)
+{
+	if (way == std::ios_base::beg) {
+		return seekpos(pos_type(off), which);
+	}
+	else if (way == std::ios_base::cur || way == std::ios_base::end) {
+		// Our output position is always the end of the text
+		return seekpos(pos_type(off_type(length()) + off), which);
+	}
+	else {
+		return pos_type(off_type(-1));
+	}
+}
+
+
+SQLWriter::pos_type
+SQLWriter::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	off_type off = off_type(pos);
+	if (!(which & std::ios_base::out) || off < 0 ||
+			static_cast<size_t>(off) > length()) {
+		return pos_type(off_type(-1));
+	}
+
+	truncate(static_cast<size_t>(off));
+	return pos;
+}
+
+
+void
+SQLWriter::swap(SQLWriter& other)
+{
+	size_t len = length(), other_len = other.length();
+	buffer_.swap(other.buffer_);
+	setp(begin(), end());
+	advance(other_len);
+	other.setp(other.begin(), other.end());
+	other.advance(len);
+}
+
+
+void
+SQLWriter::truncate(size_t n)
+{
+	setp(begin(), end());
+	advance(n);
+}
+
+
+std::streamsize
+SQLWriter::xsputn(const char* text, std::streamsize length)
+{
+	append(text, static_cast<size_t>(length));
+	return length;
+}
+
+
+namespace internal {
+
+// Index of the stream word slots mark_sql_sink() uses.  Allocated on
+// first use, so Query objects created during static initialization
+// don't see it unset.
+static int
+sink_index()
+{
+	static const int index = std::ios_base::xalloc();
+	return index;
+}
+
+
+void
+mark_sql_sink(std::ios_base& ios, sql_sink_type type)
+{
+	const int i = sink_index();
+	ios.pword(i) = &ios;
+	ios.iword(i) = type;
+}
+
+
+sql_sink_type
+sql_sink(std::ios_base& ios)
+{
+	// copyfmt() copies the words, but the copy's pword won't point to
+	// the copy itself
+	const int i = sink_index();
+	return ios.pword(i) == &ios ?
+			static_cast<sql_sink_type>(ios.iword(i)) : no_sql_sink;
+}
+
+} // end namespace mysqlpp::internal
+
+} // end namespace mysqlpp
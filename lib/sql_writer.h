@@ -0,0 +1,255 @@
+/// \file sql_writer.h
+/// \brief Declares the SQLWriter class, the buffer Query and SQLStream
+/// build SQL statements in.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_SQL_WRITER_H)
+#define MYSQLPP_SQL_WRITER_H
+
+#include "common.h"
+
+#include <ios>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <string.h>
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Make Doxygen ignore this
+class MYSQLPP_EXPORT Date;
+class MYSQLPP_EXPORT DateTime;
+class MYSQLPP_EXPORT DBDriver;
+class MYSQLPP_EXPORT Time;
+#endif
+
+/// \brief A growable buffer for building SQL statements
+///
+/// The append*() methods add text, numbers, dates and times, and
+/// quoted and escaped strings straight to the buffer.  Unlike inserting
+/// them into an ostream, this doesn't construct a sentry or consult the
+/// stream's locale for each value, so it's much cheaper.  The result
+/// is always in the format SQL wants, whatever the program's locale.
+///
+/// This is also a \c std::streambuf, which is how Query and SQLStream
+/// keep their stream interfaces: everything inserted into them lands
+/// here.  You can mix the two styles freely:
+///
+/// \code
+/// mysqlpp::Query query = conn.query("select * from stock where num > ");
+/// query.writer().append_int(limit).append(" and item = ").
+///         append_quoted(item.data(), item.length(), conn.driver());
+/// query << " order by item";
+/// mysqlpp::StoreQueryResult res = query.store();
+/// \endcode
+///
+/// clear() empties the buffer without giving its memory back, so a
+/// Query that gets reused builds each statement in the space left over
+/// from the previous one.
+
+class MYSQLPP_EXPORT SQLWriter : public std::streambuf
+{
+public:
+	/// \brief Create an empty buffer
+	SQLWriter() { }
+
+	/// \brief Create a buffer holding a copy of another's text
+	SQLWriter(const SQLWriter& other);
+
+	/// \brief Replace this buffer's text with a copy of another's
+	SQLWriter& operator =(const SQLWriter& rhs);
+
+	/// \brief Append a block of text
+	SQLWriter& append(const char* text, size_t length)
+	{
+		if (length) {
+			make_room(length);
+			memcpy(pptr(), text, length);
+			advance(length);
+		}
+		return *this;
+	}
+
+	/// \brief Append a null-terminated C string
+	SQLWriter& append(const char* text)
+			{ return append(text, strlen(text)); }
+
+	/// \brief Append a C++ string
+	SQLWriter& append(const std::string& text)
+			{ return append(text.data(), text.length()); }
+
+	/// \brief Append a single character
+	SQLWriter& append(char c)
+	{
+		make_room(1);
+		*pptr() = c;
+		pbump(1);
+		return *this;
+	}
+
+	/// \brief Append a date, in the same format as Date's stream
+	/// inserter
+	SQLWriter& append_date(const Date& d);
+
+	/// \brief Append a date and time, in the same format as
+	/// DateTime's stream inserter
+	SQLWriter& append_datetime(const DateTime& dt);
+
+	/// \brief Append a floating-point number
+	///
+	/// This gives the same text as SQLTypeAdapter: enough digits to
+	/// get the same value back, and 0 for infinities and NaN, which
+	/// SQL has no way to express.
+	SQLWriter& append_double(double value);
+
+	/// \brief Append a block of text, escaping it for use inside an
+	/// SQL string
+	///
+	/// \param text text to escape
+	/// \param length number of bytes in \c text
+	/// \param driver driver to do the escaping, so it can take the
+	/// connection's character set into account; if 0, uses
+	/// DBDriver::escape_string_no_conn()
+	SQLWriter& append_escaped(const char* text, size_t length,
+			DBDriver* driver = 0);
+
+	/// \brief Append a signed integer
+	SQLWriter& append_int(longlong value);
+
+	/// \brief Append a block of text as an SQL string: escaped, and in
+	/// single quotes
+	///
+	/// \sa append_escaped()
+	SQLWriter& append_quoted(const char* text, size_t length,
+			DBDriver* driver = 0);
+
+	/// \brief Append a block of text as a field in the tab-separated
+	/// format LOAD DATA reads
+	///
+	/// \sa BulkLoader
+	SQLWriter& append_tsv(const char* text, size_t length);
+
+	/// \brief Append a time, in the same format as Time's stream
+	/// inserter
+	SQLWriter& append_time(const Time& t);
+
+	/// \brief Append an unsigned integer
+	SQLWriter& append_uint(ulonglong value);
+
+	/// \brief Return the number of bytes the buffer can hold before it
+	/// has to grow
+	size_t capacity() const { return buffer_.size(); }
+
+	/// \brief Empty the buffer, keeping its memory for reuse
+	void clear() { setp(begin(), end()); }
+
+	/// \brief Get a pointer to the text in the buffer
+	///
+	/// This isn't null-terminated; use length().  Appending to the
+	/// buffer may move the text.
+	const char* data() const { return pbase() ? pbase() : ""; }
+
+	/// \brief Returns true if there is no text in the buffer
+	bool empty() const { return pptr() == pbase(); }
+
+	/// \brief Return the number of bytes of text in the buffer
+	size_t length() const { return pptr() - pbase(); }
+
+	/// \brief Make room for at least \c n bytes of text in all
+	void reserve(size_t n);
+
+	/// \brief Return a copy of the text in the buffer
+	std::string str() const { return std::string(data(), length()); }
+
+	/// \brief Exchange contents with another buffer
+	void swap(SQLWriter& other);
+
+protected:
+	/// \brief Grow the buffer for text coming from the stream interface
+	int_type overflow(int_type c);
+
+	/// \brief Handle a seekp() or tellp() call through the stream
+	/// interface
+	///
+	/// Only the output position is supported.  Seeking backward
+	/// discards the text after the new position.
+	pos_type seekoff(off_type off, std::ios_base::seekdir way,
+			std::ios_base::openmode which = std::ios_base::out);
+
+	/// \brief Handle a seekp() call through the stream interface
+	///
+	/// \sa seekoff()
+	pos_type seekpos(pos_type pos,
+			std::ios_base::openmode which = std::ios_base::out);
+
+	/// \brief Append a block of text from the stream interface
+	std::streamsize xsputn(const char* text, std::streamsize length);
+
+private:
+	/// \brief Move the end of the text forward \c n bytes
+	void advance(size_t n);
+
+	/// \brief Get pointers to the start and end of our storage
+	char* begin() { return buffer_.empty() ? 0 : &buffer_[0]; }
+	char* end() { return begin() + buffer_.size(); }
+
+	/// \brief Make sure there's room to append \c n more bytes
+	void make_room(size_t n)
+	{
+		if (static_cast<size_t>(epptr() - pptr()) < n) {
+			reserve(length() + n);
+		}
+	}
+
+	/// \brief Truncate the text to the given length
+	void truncate(size_t n);
+
+	std::vector<char> buffer_;	///< storage; the put area spans all of it
+};
+
+
+#if !defined(DOXYGEN_IGNORE)
+// Doxygen will not generate documentation for this section.
+namespace internal {
+	// The kinds of stream that build SQL in a SQLWriter
+	enum sql_sink_type { no_sql_sink, query_sink, sqlstream_sink };
+
+	// Query and SQLStream mark themselves with this when they're
+	// created, so the manipulators can find their SQLWriter without
+	// using RTTI on each value inserted.  The mark doesn't carry over
+	// to other streams through copyfmt().
+	MYSQLPP_EXPORT void mark_sql_sink(std::ios_base& ios,
+			sql_sink_type type);
+
+	// Returns how the given stream was marked, if at all
+	MYSQLPP_EXPORT sql_sink_type sql_sink(std::ios_base& ios);
+} // end namespace mysqlpp::internal
+#endif // !defined(DOXYGEN_IGNORE)
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_SQL_WRITER_H)
@@ -33,19 +33,41 @@
 namespace mysqlpp {
 
 SQLStream::SQLStream(Connection* c, const char* pstr) :
-std::ostringstream(),
+#if defined(MYSQLPP_HAVE_STD__NOINIT)
+// prevents a double-init memory leak in native VC++ RTL (not STLport!)
+std::ostream(std::_Noinit),
+#else
+std::ostream(0),
+#endif
 conn_(c)
 {
+	init(&writer_);
+	internal::mark_sql_sink(*this, internal::sqlstream_sink);
 	if (pstr != 0) {
-		str(pstr);
+		writer_.append(pstr);
 	}
 }
 
 
 SQLStream::SQLStream(const SQLStream& s) :
-std::ostringstream(s.str()),
-conn_(s.conn_)
+#if defined(MYSQLPP_HAVE_STD__NOINIT)
+// ditto above
+std::ostream(std::_Noinit),
+#else
+std::ostream(0),
+#endif
+conn_(s.conn_),
+writer_(s.writer_)
 {
+	init(&writer_);
+	internal::mark_sql_sink(*this, internal::sqlstream_sink);
+}
+
+
+DBDriver*
+SQLStream::escape_driver() const
+{
+	return conn_ && *conn_ ? conn_->driver() : 0;
 }
 
 
@@ -85,11 +107,19 @@ SQLStream&
 SQLStream::operator=(const SQLStream& rhs)
 {
 	conn_ = rhs.conn_;
-	str(rhs.str());
+	writer_ = rhs.writer_;
 
 	return *this;
 }
 
 
+void
+SQLStream::str(const std::string& s)
+{
+	writer_.clear();
+	writer_.append(s);
+}
+
+
 } // end namespace mysqlpp
 
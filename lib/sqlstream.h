@@ -29,7 +29,9 @@
 
 #include "common.h"
 
-#include <sstream>
+#include "sql_writer.h"
+
+#include <ostream>
 
 namespace mysqlpp {
 
@@ -40,10 +42,13 @@ class MYSQLPP_EXPORT Connection;
 
 /// \brief A class for building SQL-formatted strings.
 ///
+/// This works like a \c std::ostringstream, but builds its text in a
+/// SQLWriter, which you can also append to directly via writer().
+///
 /// See the user manual for more details about these options.
 
 class MYSQLPP_EXPORT SQLStream :
-public std::ostringstream
+public std::ostream
 {
 public:
 	/// \brief Create a new stream object attached to a connection.
@@ -57,6 +62,12 @@ public:
 	/// This is a traditional copy ctor.
 	SQLStream(const SQLStream& s);
 
+	/// \brief Get the driver escape_string() uses
+	///
+	/// Returns 0 if there's no connection to ask, in which case
+	/// escaping falls back on DBDriver::escape_string_no_conn().
+	DBDriver* escape_driver() const;
+
 	/// \brief Return a SQL-escaped version of a character buffer
 	///
 	/// \param ps pointer to C++ string to hold escaped version; if
@@ -101,8 +112,23 @@ public:
 	/// \brief Assigns contents of another SQLStream to this one
 	SQLStream& operator=(const SQLStream& rhs);
 
+	/// \brief Return a copy of the text built so far
+	std::string str() const { return writer_.str(); }
+
+	/// \brief Replace the text built so far
+	void str(const std::string& s);
+
+	/// \brief Get the buffer the text is built in
+	///
+	/// See SQLWriter for why you might want to use it directly.
+	SQLWriter& writer() { return writer_; }
+
 	/// \brief Connection to send queries through
 	Connection* conn_;
+
+private:
+	/// \brief Buffer for the text built so far
+	SQLWriter writer_;
 };
 
 
@@ -306,6 +306,7 @@ foreach my $i (1..$max_data_members) {
 	my $parm_simple2c_b = "";
 	my $parm_simple_b = "";
 	my $popul = "";
+	my $raw_popul = "";
 	my $value_list = "";
 	my $value_list_cus = "";
 
@@ -327,6 +328,9 @@ foreach my $i (1..$max_data_members) {
 		$popul .= "    s->I$j = row[N$j].conv(T$j());";
 		$popul .= "\n" unless $j == $i;
 
+		$raw_popul .= "    row.get(".($j-1).", s->I$j);";
+		$raw_popul .= "\n" unless $j == $i;
+
 		$names .= "    N$j ";
 		$names .= ",\n" unless $j == $i;
 		$enums .= "    NAME##_##I$j";
@@ -495,7 +499,11 @@ $enums
 $defs 
 	NAME() : table_override_(0) { }
 	NAME(const mysqlpp::Row& row);
+	NAME(const mysqlpp::RawRow& row);
 	void set(const mysqlpp::Row &row);
+	void set(const mysqlpp::RawRow& row);
+	static mysqlpp::RawRow::ColumnMap raw_columns(const mysqlpp::ResultBase& res)
+			{ return mysqlpp::RawRow::ColumnMap(res, names, $i); }
 	sql_compare_define_##CMP(NAME, $parmC)
 	sql_construct_define_##CONTR(NAME, $parmC)
 	static const char* names[];
@@ -861,6 +869,21 @@ $popul
 		populate_##NAME<mysqlpp::sql_dummy>(this, row);
 	}
 
+	template <mysqlpp::sql_dummy_type dummy>
+	void populate_##NAME(NAME *s, const mysqlpp::RawRow &row)
+	{
+$raw_popul
+	}
+
+	inline NAME::NAME(const mysqlpp::RawRow& row) :
+	table_override_(0)
+			{ populate_##NAME<mysqlpp::sql_dummy>(this, row); }
+	inline void NAME::set(const mysqlpp::RawRow& row)
+	{
+		table_override_ = 0;
+		populate_##NAME<mysqlpp::sql_dummy>(this, row);
+	}
+
 	sql_COMPARE__##CMP(NAME, $parmc )
 
 ---
@@ -38,6 +38,17 @@ using namespace std;
 
 namespace mysqlpp {
 
+// Formats a Date, DateTime or Time straight into a new SQLBuffer,
+// skipping the ostringstream that stream2string() would use.
+template <class T>
+static SQLBuffer*
+date_time_buffer(const T& value)
+{
+	char buf[T::max_length];
+	return new SQLBuffer(buf, value.format(buf), typeid(value), false);
+}
+
+
 SQLTypeAdapter::SQLTypeAdapter() :
 is_processed_(false)
 {
@@ -50,7 +61,7 @@ is_processed_(false)
 }
 
 SQLTypeAdapter::SQLTypeAdapter(const String& other, bool processed) :
-buffer_(other.buffer_),
+buffer_(other.shared_buffer()),
 is_processed_(processed)
 {
 }
@@ -337,45 +348,45 @@ is_processed_(false)
 #endif
 
 SQLTypeAdapter::SQLTypeAdapter(const Date& d) :
-buffer_(new SQLBuffer(stream2string(d), typeid(d), false)),
+buffer_(date_time_buffer(d)),
 is_processed_(false)
 {
 }
 
 #if !defined(DOXYGEN_IGNORE)
 SQLTypeAdapter::SQLTypeAdapter(const Null<Date>& d) :
-buffer_(new SQLBuffer(d.is_null ? null_str : stream2string(d),
-		d.is_null ? typeid(void) : typeid(d.data), d.is_null)),
+buffer_(d.is_null ? new SQLBuffer(null_str, typeid(void), true) :
+		date_time_buffer(d.data)),
 is_processed_(false)
 {
 }
 #endif
 
 SQLTypeAdapter::SQLTypeAdapter(const DateTime& dt) :
-buffer_(new SQLBuffer(stream2string(dt), typeid(dt), false)),
+buffer_(date_time_buffer(dt)),
 is_processed_(false)
 {
 }
 
 #if !defined(DOXYGEN_IGNORE)
 SQLTypeAdapter::SQLTypeAdapter(const Null<DateTime>& dt) :
-buffer_(new SQLBuffer(dt.is_null ? null_str : stream2string(dt),
-		dt.is_null ? typeid(void) : typeid(dt.data), dt.is_null)),
+buffer_(dt.is_null ? new SQLBuffer(null_str, typeid(void), true) :
+		date_time_buffer(dt.data)),
 is_processed_(false)
 {
 }
 #endif
 
 SQLTypeAdapter::SQLTypeAdapter(const Time& t) :
-buffer_(new SQLBuffer(stream2string(t), typeid(t), false)),
+buffer_(date_time_buffer(t)),
 is_processed_(false)
 {
 }
 
 #if !defined(DOXYGEN_IGNORE)
 SQLTypeAdapter::SQLTypeAdapter(const Null<Time>& t) :
-buffer_(new SQLBuffer(t.is_null ? null_str : stream2string(t),
-		t.is_null ? typeid(void) : typeid(t.data), t.is_null)),
+buffer_(t.is_null ? new SQLBuffer(null_str, typeid(void), true) :
+		date_time_buffer(t.data)),
 is_processed_(false)
 {
 }
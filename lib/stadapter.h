@@ -35,6 +35,7 @@
 #include "sql_buffer.h"
 #include "tiny_int.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
@@ -87,6 +88,18 @@ public:
 	/// deep copy, use one of the ctors that takes a string.
 	SQLTypeAdapter(const SQLTypeAdapter& other);
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move ctor
+	///
+	/// Takes over the other object's buffer, leaving \c other empty.
+	/// As with the copy ctor, the new object is not marked processed.
+	SQLTypeAdapter(SQLTypeAdapter&& other) :
+	is_processed_(false)
+	{
+		buffer_.swap(other.buffer_);
+	}
+#endif
+
 	/// \brief Create a copy of a MySQL++ string
 	///
 	/// This does reference-counted buffer sharing with the other 
@@ -170,6 +183,28 @@ public:
 	/// \see assign(const SQLTypeAdapter&) for details
 	SQLTypeAdapter& operator =(const SQLTypeAdapter& rhs);
 
+#if defined(MYSQLPP_HAVE_RVALUE_REFS)
+	/// \brief Move assignment operator
+	///
+	/// Like operator =(const SQLTypeAdapter&), this resets the
+	/// "processed" flag.
+	SQLTypeAdapter& operator =(SQLTypeAdapter&& rhs)
+	{
+		buffer_.swap(rhs.buffer_);
+		is_processed_ = false;
+		return *this;
+	}
+#endif
+
+	/// \brief Exchange contents with another SQLTypeAdapter
+	///
+	/// This just swaps pointers, so it's cheap and can't throw.
+	void swap(SQLTypeAdapter& other)
+	{
+		buffer_.swap(other.buffer_);
+		std::swap(is_processed_, other.is_processed_);
+	}
+
 	/// \brief Replace contents of object with a SQL null
 	///
 	/// \see assign(const null_type&) for details
@@ -333,6 +368,13 @@ private:
 	bool is_processed_;
 };
 
+/// \brief Swaps two SQLTypeAdapter objects
+inline void
+swap(SQLTypeAdapter& x, SQLTypeAdapter& y)
+{
+	x.swap(y);
+}
+
 } // end namespace mysqlpp
 
 #endif // !defined(MYSQLPP_SQL_TYPE_ADAPTER_H)
@@ -0,0 +1,202 @@
+/***********************************************************************
+ statement_batch.cpp - Implements the StatementBatch class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#define MYSQLPP_NOT_HEADER
+#include "common.h"
+
+#include "statement_batch.h"
+
+#include "connection.h"
+#include "dbdriver.h"
+#include "exceptions.h"
+#include "query.h"
+
+#include <ctype.h>
+
+using namespace std;
+
+namespace mysqlpp {
+
+// What we assume max_allowed_packet is if the server won't say.  This
+// is the smallest default any MySQL version has used.
+static const size_t fallback_max_packet = 1024 * 1024;
+
+
+StatementBatch::StatementBatch(Connection& conn, size_t max_packet) :
+OptionalExceptions(conn.throw_exceptions()),
+conn_(conn),
+max_packet_(max_packet),
+round_trips_(0)
+{
+}
+
+
+void
+StatementBatch::add(const char* sql, size_t length)
+{
+	while (length && (sql[length - 1] == ';' ||
+			isspace(static_cast<unsigned char>(sql[length - 1])))) {
+		--length;
+	}
+
+	if (!ends_.empty()) {
+		text_.append(';');
+	}
+	text_.append(sql, length);
+	ends_.push_back(text_.length());
+}
+
+
+void
+StatementBatch::add(Query& query)
+{
+	add(query.str());
+}
+
+
+void
+StatementBatch::clear()
+{
+	text_.clear();
+	ends_.clear();
+}
+
+
+const std::vector<StatementOutcome>&
+StatementBatch::execute()
+{
+	outcomes_.clear();
+	outcomes_.resize(ends_.size());
+	round_trips_ = 0;
+
+	// Fill each packet with as many whole statements as fit alongside
+	// the 1-byte command code.  A statement too big to share a packet
+	// goes alone, and the server decides whether it's too big to run.
+	const size_t limit = ends_.empty() ? 0 : max_packet();
+	bool ok = true;
+	for (size_t first = 0, last; ok && first < ends_.size(); first = last) {
+		last = first + 1;
+		while (last < ends_.size() &&
+				1 + ends_[last] - begin(first) <= limit) {
+			++last;
+		}
+		ok = send(first, last);
+	}
+	clear();
+
+	if (!ok && throw_exceptions()) {
+		for (size_t i = 0; i < outcomes_.size(); ++i) {
+			if (outcomes_[i].status == StatementOutcome::failed) {
+				throw BadQuery(outcomes_[i].error, outcomes_[i].errnum);
+			}
+		}
+	}
+
+	return outcomes_;
+}
+
+
+size_t
+StatementBatch::max_packet()
+{
+	if (max_packet_ == 0) {
+		Query query(conn_.query());
+		query.disable_exceptions();
+		StoreQueryResult res = query.store("SELECT @@max_allowed_packet", 27);
+		if (res && res.num_rows() == 1) {
+			max_packet_ = static_cast<size_t>(res[0][0].conv(0UL));
+		}
+		if (max_packet_ == 0) {
+			max_packet_ = fallback_max_packet;
+		}
+	}
+
+	return max_packet_;
+}
+
+
+bool
+StatementBatch::send(size_t first, size_t last)
+{
+	DBDriver* driver = conn_.driver();
+	const size_t start = begin(first);
+	++round_trips_;
+
+	// The first statement's outcome comes back from the query call
+	// itself, and each later one's from moving on to its result.
+	// Either way, the server runs nothing after an error.
+	size_t i = first;
+	bool ok = driver->execute(text_.data() + start,
+			ends_[last - 1] - start);
+	while (ok) {
+		StatementOutcome& outcome = outcomes_[i];
+		if (MYSQL_RES* res = driver->store_result()) {
+			outcome.rows = StoreQueryResult(res, driver, false);
+		}
+		else if (conn_.errnum()) {
+			ok = false;
+			break;
+		}
+		outcome.status = StatementOutcome::succeeded;
+		outcome.result = SimpleResult(true, driver->insert_id(),
+				driver->affected_rows(), driver->query_info());
+
+		if (++i == last) {
+			break;
+		}
+		ok = driver->next_result() == DBDriver::nr_more_results;
+	}
+
+	if (ok) {
+		// Results beyond one per statement mean one of them was really
+		// more than one, or a CALL; we have nowhere to put those, but
+		// they have to be read before the connection can be used again.
+		while (driver->more_results() &&
+				driver->next_result() == DBDriver::nr_more_results) {
+			if (MYSQL_RES* res = driver->store_result()) {
+				driver->free_result(res);
+			}
+		}
+	}
+	else {
+		StatementOutcome& outcome = outcomes_[i];
+		outcome.status = StatementOutcome::failed;
+		outcome.errnum = conn_.errnum();
+		outcome.error = outcome.errnum ? conn_.error() :
+				"Server returned fewer results than there were statements";
+	}
+
+	return ok;
+}
+
+
+std::string
+StatementBatch::statement(size_t i) const
+{
+	const size_t start = begin(i);
+	return string(text_.data() + start, ends_.at(i) - start);
+}
+
+} // end namespace mysqlpp
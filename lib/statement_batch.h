@@ -0,0 +1,196 @@
+/// \file statement_batch.h
+/// \brief Declares the StatementBatch class, which sends many SQL
+/// statements to the server in as few round trips as it can.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_STATEMENT_BATCH_H)
+#define MYSQLPP_STATEMENT_BATCH_H
+
+#include "common.h"
+
+#include "noexceptions.h"
+#include "result.h"
+#include "sql_writer.h"
+
+#include <string>
+#include <vector>
+
+namespace mysqlpp {
+
+#if !defined(DOXYGEN_IGNORE)
+// Make Doxygen ignore this
+class MYSQLPP_EXPORT Connection;
+class MYSQLPP_EXPORT Query;
+#endif
+
+/// \brief What became of one statement in a StatementBatch
+struct StatementOutcome
+{
+	/// \brief Whether the statement ran
+	enum Status {
+		succeeded,		///< statement ran without error
+		failed,			///< statement ran, and the server reported an error
+		not_run			///< an earlier statement failed, so this one never ran
+	};
+
+	Status status;				///< whether the statement ran
+	SimpleResult result;		///< insert ID, affected rows and info, on success
+	StoreQueryResult rows;		///< result set, for statements that return one
+	int errnum;					///< the error number, on failure
+	std::string error;			///< the error message, on failure
+
+	/// \brief Create an outcome for a statement that hasn't run
+	StatementOutcome() :
+	status(not_run),
+	errnum(0)
+	{
+	}
+};
+
+
+/// \brief Sends a list of SQL statements in as few round trips as
+/// possible, keeping track of what happened to each
+///
+/// Each statement sent on its own costs at least one round trip to
+/// the server, and on a slow link that's where most of the time goes.
+/// This class sends the statements you add() as multi-statement
+/// queries instead, separated by semicolons, as many to a packet as
+/// \c max_allowed_packet allows.  execute() then walks the results,
+/// giving back one StatementOutcome per statement.
+///
+/// \code
+/// mysqlpp::StatementBatch batch(conn);
+/// batch.add("UPDATE stock SET num = num - 1 WHERE item = 'Hotdog Buns'");
+/// batch.add(query);		// e.g. a filled-in template query
+/// batch.add("SELECT num FROM stock WHERE item = 'Hotdog Buns'");
+/// const std::vector<mysqlpp::StatementOutcome>& out = batch.execute();
+/// std::cout << out[2].rows[0]["num"] << std::endl;
+/// \endcode
+///
+/// The server stops at the first statement that fails, so its outcome
+/// says \c failed, those before it say \c succeeded, and those after
+/// it, whether in the same packet or a later one, say \c not_run.
+///
+/// The connection must have MultiStatementsOption set.  Each statement
+/// must produce exactly one result, so CALLs to stored procedures that
+/// return result sets don't belong in a batch.  Statements after the
+/// first in a packet run as part of the same server command, so a
+/// batch is no substitute for a transaction: wrap it in one if it must
+/// succeed or fail as a whole.
+///
+/// Result sets are always stored in full, in StoreQueryResult's
+/// default storage mode.
+
+class MYSQLPP_EXPORT StatementBatch : public OptionalExceptions
+{
+public:
+	/// \brief Create an empty batch
+	///
+	/// \param conn connection to send statements through
+	/// \param max_packet largest packet to send, in bytes; 0 means ask
+	/// the server for its \c max_allowed_packet the first time it's
+	/// needed
+	StatementBatch(Connection& conn, size_t max_packet = 0);
+
+	/// \brief Add a statement to the batch
+	///
+	/// Any semicolon and whitespace at the end of the statement is
+	/// dropped; the batch puts its own semicolons between statements.
+	void add(const char* sql, size_t length);
+
+	/// \brief Add a statement to the batch
+	void add(const std::string& sql) { add(sql.data(), sql.length()); }
+
+	/// \brief Add the statement a Query holds to the batch
+	///
+	/// This is the SQL Query::str() gives: for a template query, that's
+	/// the template filled in with its default parameters.  The Query
+	/// is left as it is, so you can change its parameters and add it
+	/// again.
+	void add(Query& query);
+
+	/// \brief Drop all the statements added so far
+	void clear();
+
+	/// \brief Returns true if no statements are waiting to be sent
+	bool empty() const { return ends_.empty(); }
+
+	/// \brief Send all the statements added so far, and collect their
+	/// outcomes
+	///
+	/// The batch is empty afterward, ready for more statements.  The
+	/// outcomes are also kept until the next execute(), available from
+	/// outcomes().
+	///
+	/// If a statement fails and exceptions are enabled, this throws
+	/// BadQuery once all the outcomes are collected.
+	///
+	/// \return one outcome per statement, in the order they were added
+	const std::vector<StatementOutcome>& execute();
+
+	/// \brief Get the largest packet this object sends
+	///
+	/// If this wasn't set, it's asked of the server.
+	size_t max_packet();
+
+	/// \brief Set the largest packet this object sends
+	void max_packet(size_t bytes) { max_packet_ = bytes; }
+
+	/// \brief Get the outcomes of the statements sent by the last
+	/// execute()
+	const std::vector<StatementOutcome>& outcomes() const
+			{ return outcomes_; }
+
+	/// \brief Get the number of server round trips the last execute()
+	/// made
+	size_t round_trips() const { return round_trips_; }
+
+	/// \brief Returns the number of statements waiting to be sent
+	size_t size() const { return ends_.size(); }
+
+	/// \brief Get the text of one of the statements waiting to be sent
+	std::string statement(size_t i) const;
+
+private:
+	/// \brief Send statements [first, last) as one multi-statement
+	/// query and collect their outcomes
+	///
+	/// \retval false if one of them failed
+	bool send(size_t first, size_t last);
+
+	/// \brief Returns the offset in text_ where statement i starts
+	size_t begin(size_t i) const { return i ? ends_[i - 1] + 1 : 0; }
+
+	Connection& conn_;			///< connection to send statements through
+	SQLWriter text_;			///< statements, separated by semicolons
+	std::vector<size_t> ends_;	///< offset in text_ of each statement's end
+	std::vector<StatementOutcome> outcomes_;	///< from the last execute()
+	size_t max_packet_;			///< largest packet to send
+	size_t round_trips_;		///< packets sent by the last execute()
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_STATEMENT_BATCH_H)
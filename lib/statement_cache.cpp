@@ -0,0 +1,182 @@
+/***********************************************************************
+ statement_cache.cpp - Implements the StatementCache class.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include "statement_cache.h"
+
+#include <ctype.h>
+#include <string.h>
+
+using namespace std;
+
+namespace mysqlpp {
+
+void
+StatementCache::capacity(size_type n)
+{
+	capacity_ = n;
+	shrink(capacity_);
+}
+
+
+void
+StatementCache::clear()
+{
+	index_.clear();
+	statements_.clear();
+}
+
+
+void
+StatementCache::erase(const std::string& key)
+{
+	map_type::iterator it = index_.find(key);
+	if (it != index_.end()) {
+		statements_.erase(it->second);
+		index_.erase(it);
+	}
+}
+
+
+RefCountedPointer<MYSQL_STMT>
+StatementCache::find(const std::string& key)
+{
+	// A statement that some PreparedQuery still holds has that object's
+	// parameters and result buffers bound to it, and maybe a result set
+	// pending, so it can't be handed to another one.
+	map_type::iterator it = index_.find(key);
+	if (it == index_.end() || !it->second->second.unique()) {
+		++misses_;
+		return RefCountedPointer<MYSQL_STMT>();
+	}
+
+	++hits_;
+	statements_.splice(statements_.begin(), statements_, it->second);
+	return statements_.front().second;
+}
+
+
+void
+StatementCache::insert(const std::string& key,
+		const RefCountedPointer<MYSQL_STMT>& stmt)
+{
+	if (capacity_ == 0) {
+		return;
+	}
+
+	erase(key);
+	shrink(capacity_ - 1);
+	statements_.push_front(list_type::value_type(key, stmt));
+	index_[key] = statements_.begin();
+}
+
+
+// If a comment starts at sql[i], returns the text that ends it.
+// Otherwise, returns 0.  As in MySQL, "--" only starts a comment if
+// whitespace or a control character follows it.
+static const char*
+comment_end(const string& sql, string::size_type i)
+{
+	const char c = sql[i];
+	const char next = i + 1 < sql.length() ? sql[i + 1] : 0;
+	if (c == '#') {
+		return "\n";
+	}
+	else if (c == '/' && next == '*') {
+		return "*/";
+	}
+	else if (c == '-' && next == '-') {
+		const unsigned char after = i + 2 < sql.length() ? sql[i + 2] : ' ';
+		if (isspace(after) || iscntrl(after)) {
+			return "\n";
+		}
+	}
+
+	return 0;
+}
+
+
+string
+StatementCache::normalize(const std::string& sql)
+{
+	string key;
+	key.reserve(sql.length());
+
+	char quote = 0;			// quote char we're inside of, if any
+	bool space = false;		// true if we skipped whitespace
+	for (string::size_type i = 0; i < sql.length(); ++i) {
+		const char c = sql[i];
+		if (quote) {
+			key += c;
+			if (c == '\\' && quote != '`' && i + 1 < sql.length()) {
+				key += sql[++i];
+			}
+			else if (c == quote) {
+				quote = 0;
+			}
+		}
+		else if (isspace(static_cast<unsigned char>(c))) {
+			space = true;
+		}
+		else {
+			if (space && !key.empty()) {
+				key += ' ';
+			}
+			space = false;
+
+			if (const char* end = comment_end(sql, i)) {
+				// Copy comments as is.  Quote characters in them don't
+				// start literals, and the newline ending a "--" or "#"
+				// comment has to stay a newline.
+				string::size_type stop = sql.find(end,
+						i + (c == '#' ? 1 : 2));
+				stop = stop == string::npos ? sql.length() :
+						stop + strlen(end);
+				key.append(sql, i, stop - i);
+				i = stop - 1;
+			}
+			else {
+				key += c;
+				if (c == '\'' || c == '"' || c == '`') {
+					quote = c;
+				}
+			}
+		}
+	}
+
+	return key;
+}
+
+
+void
+StatementCache::shrink(size_type n)
+{
+	while (index_.size() > n) {
+		index_.erase(statements_.back().first);
+		statements_.pop_back();
+		++evictions_;
+	}
+}
+
+} // end namespace mysqlpp
@@ -0,0 +1,183 @@
+/// \file statement_cache.h
+/// \brief Declares the StatementCache class, which lets a connection
+/// reuse server-side prepared statements.
+
+/***********************************************************************
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#if !defined(MYSQLPP_STATEMENT_CACHE_H)
+#define MYSQLPP_STATEMENT_CACHE_H
+
+#include "common.h"
+
+#include "refcounted.h"
+
+#include <list>
+#include <map>
+#include <string>
+
+namespace mysqlpp {
+
+/// \brief Functor to call mysql_stmt_close() on the pointer you pass
+/// to it.
+///
+/// This overrides RefCountedPointer's default destroyer, which uses
+/// operator delete, for the C API's prepared statement handles.
+template <>
+struct RefCountedPointerDestroyer<MYSQL_STMT>
+{
+	/// \brief Functor implementation
+	void operator()(MYSQL_STMT* doomed) const
+	{
+		if (doomed) {
+			mysql_stmt_close(doomed);
+		}
+	}
+};
+
+
+/// \brief Remembers a connection's recently prepared statements, so
+/// preparing the same SQL again doesn't cost a round trip to the server
+///
+/// Each DBDriver, and so each Connection, has one of these.
+/// Connection::prepare() looks the SQL up here first, and only asks
+/// the server to prepare it on a miss.  Programs that build their SQL
+/// on the fly and prepare it each time they run it get most of the
+/// benefit of holding on to PreparedQuery objects without having to.
+///
+/// Statements are keyed by their SQL after normalize(), so differences
+/// in whitespace don't cause misses.  When the cache is full, the
+/// statement used least recently is dropped.  Setting the capacity to 0
+/// turns the cache off.
+///
+/// Only one PreparedQuery uses a statement at a time.  Preparing SQL
+/// whose statement another PreparedQuery still holds gets a new one
+/// from the server; whichever is left when the other goes away is what
+/// the cache hands out next.
+///
+/// Disconnecting empties the cache, since the server forgets its
+/// prepared statements when the connection closes.  PreparedQuery
+/// prepares its statement again if it finds that the server has
+/// forgotten it, as happens when the C API reconnects on its own.
+///
+/// Like the rest of Connection, this does no locking.  ConnectionPool
+/// only hands a connection to one thread at a time, and release() does
+/// not touch the cache, so the cache only ever evicts statements on
+/// behalf of the thread that holds the connection.
+
+class MYSQLPP_EXPORT StatementCache
+{
+public:
+	/// \brief Type of entry counts
+	typedef size_t size_type;
+
+	/// \brief Create an empty cache
+	///
+	/// \param capacity number of statements to remember
+	explicit StatementCache(size_type capacity = 64) :
+	capacity_(capacity),
+	hits_(0),
+	misses_(0),
+	evictions_(0)
+	{
+	}
+
+	/// \brief Get the number of statements we remember
+	size_type capacity() const { return capacity_; }
+
+	/// \brief Set the number of statements to remember
+	///
+	/// If the new capacity is less than the current size(), this
+	/// drops the least recently used statements to fit.
+	void capacity(size_type n);
+
+	/// \brief Forget all remembered statements
+	///
+	/// PreparedQuery objects already using them keep them.
+	void clear();
+
+	/// \brief Forget the statement stored under the given key
+	void erase(const std::string& key);
+
+	/// \brief Return the number of statements dropped to make room
+	/// for others
+	ulonglong evictions() const { return evictions_; }
+
+	/// \brief Look up a prepared statement
+	///
+	/// \param key the statement's SQL, as returned by normalize()
+	///
+	/// \retval the statement, or a null pointer if we don't have it
+	///
+	/// A statement is only handed out while no one else holds it, since
+	/// its parameters and result buffers are bound to the PreparedQuery
+	/// using it.  If it's in use, this counts as a miss, and the caller
+	/// prepares its own copy.
+	RefCountedPointer<MYSQL_STMT> find(const std::string& key);
+
+	/// \brief Return the number of times find() found a statement
+	ulonglong hits() const { return hits_; }
+
+	/// \brief Remember a newly prepared statement
+	///
+	/// \param key the statement's SQL, as returned by normalize()
+	/// \param stmt the prepared statement
+	void insert(const std::string& key,
+			const RefCountedPointer<MYSQL_STMT>& stmt);
+
+	/// \brief Return the number of times find() came up empty
+	ulonglong misses() const { return misses_; }
+
+	/// \brief Return the cache key for the given SQL
+	///
+	/// This trims leading and trailing whitespace, and reduces each
+	/// run of whitespace outside quoted strings, quoted identifiers and
+	/// comments to a single space.
+	static std::string normalize(const std::string& sql);
+
+	/// \brief Return the number of statements we remember
+	size_type size() const { return index_.size(); }
+
+private:
+	/// \brief Statements with their keys, most recently used first
+	typedef std::list<std::pair<std::string,
+			RefCountedPointer<MYSQL_STMT> > > list_type;
+
+	/// \brief Index into list_type by key
+	typedef std::map<std::string, list_type::iterator> map_type;
+
+	/// \brief Drop least recently used statements until we have no
+	/// more than \c n
+	void shrink(size_type n);
+
+	list_type statements_;	///< remembered statements, MRU first
+	map_type index_;		///< key to position in statements_
+	size_type capacity_;	///< max statements to remember
+	ulonglong hits_;		///< number of find() calls that found one
+	ulonglong misses_;		///< number of find() calls that didn't
+	ulonglong evictions_;	///< number of statements dropped for room
+};
+
+} // end namespace mysqlpp
+
+#endif // !defined(MYSQLPP_STATEMENT_CACHE_H)
@@ -0,0 +1,138 @@
+/***********************************************************************
+ test/bench_conv.cpp - Times String::conv() against the iostreams-based
+	conversion it replaced.  This isn't run by dtest, since its output
+	varies from run to run; run it by hand when changing the number
+	parsing code.  Pass a count to change the number of passes made
+	over the sample data.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <stdlib.h>
+#include <time.h>
+
+
+// The way String::conv() used to work: push the text through a
+// stringstream in the "C" locale, then check for leftovers.
+template <typename T>
+static T
+stream_conv(const mysqlpp::String& s)
+{
+	std::stringstream buf;
+	buf.write(s.data(), static_cast<std::streamsize>(s.length()));
+	buf.imbue(std::locale::classic());
+	T num = T();
+	char c;
+	if (!(buf >> num) || (buf >> c)) {
+		throw mysqlpp::BadConversion(typeid(T).name(), s.data(), 0,
+				s.length());
+	}
+	return num;
+}
+
+
+// Converts every sample string to T both ways, and prints the time
+// each takes.  Returns false if the two ever disagree.
+template <typename T>
+static bool
+bench(const char* label, const std::vector<mysqlpp::String>& samples,
+		int passes)
+{
+	T stream_sum = 0, conv_sum = 0;
+
+	clock_t start = clock();
+	for (int i = 0; i < passes; ++i) {
+		for (size_t j = 0; j < samples.size(); ++j) {
+			stream_sum += stream_conv<T>(samples[j]);
+		}
+	}
+	clock_t middle = clock();
+	for (int i = 0; i < passes; ++i) {
+		for (size_t j = 0; j < samples.size(); ++j) {
+			conv_sum += samples[j].conv(T());
+		}
+	}
+	clock_t end = clock();
+
+	double stream_secs = double(middle - start) / CLOCKS_PER_SEC;
+	double conv_secs = double(end - middle) / CLOCKS_PER_SEC;
+	std::cout << std::setw(10) << std::left << label <<
+			std::fixed << std::setprecision(3) <<
+			"  stringstream " << stream_secs << "s" <<
+			"  conv " << conv_secs << "s";
+	if (conv_secs > 0) {
+		std::cout << std::setprecision(1) << "  (" <<
+				stream_secs / conv_secs << "x)";
+	}
+	std::cout << std::endl;
+
+	if (stream_sum != conv_sum) {
+		std::cerr << "Results differ for " << label << '!' << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+int
+main(int argc, char* argv[])
+{
+	const int passes = argc > 1 ? atoi(argv[1]) : 20;
+	const int count = 10000;
+
+	// Build some data that looks like what MySQL sends: short and long
+	// integers, and decimals with a few digits after the point.
+	std::vector<mysqlpp::String> ints, bigints, doubles;
+	srand(42);
+	for (int i = 0; i < count; ++i) {
+		std::ostringstream outs;
+		outs << (rand() % 100000);
+		ints.push_back(mysqlpp::String(outs.str()));
+
+		outs.str("");
+		outs << (mysqlpp::longlong(rand()) * rand() * rand());
+		bigints.push_back(mysqlpp::String(outs.str()));
+
+		outs.str("");
+		outs << (rand() % 100000) << '.' << std::setw(2) <<
+				std::setfill('0') << (rand() % 100);
+		doubles.push_back(mysqlpp::String(outs.str()));
+	}
+
+	try {
+		bool ok = bench<long>("INT", ints, passes) &&
+				bench<mysqlpp::longlong>("BIGINT", bigints, passes) &&
+				bench<double>("DECIMAL", doubles, passes);
+		return ok ? 0 : 1;
+	}
+	catch (const mysqlpp::BadConversion& e) {
+		std::cerr << "Conversion failed: " << e.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,156 @@
+/***********************************************************************
+ test/bench_escape.cpp - Times MySQL++'s string escaping against the
+	C API path it replaced.  This isn't run by dtest, since its output
+	varies from run to run; run it by hand when changing the escaping
+	code.  Pass a count to change the number of passes made over the
+	sample data.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+#include <dbdriver.h>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <time.h>
+
+
+// The way DBDriver::escape_string_no_conn(std::string*, ...) used to
+// work: escape into a scratch array, then copy that into the string.
+static size_t
+c_api_escape(std::string* ps, const char* original, size_t length)
+{
+	char* escaped = new char[length * 2 + 1];
+	length = mysql_escape_string(escaped, original,
+			static_cast<unsigned long>(length));
+	ps->assign(escaped, length);
+	delete[] escaped;
+	return length;
+}
+
+
+// Escapes every sample string both ways, and prints the time each
+// takes.  Returns false if the two ever disagree.
+static bool
+bench(const char* label, const std::vector<std::string>& samples,
+		int passes)
+{
+	std::string out;
+	size_t c_api_total = 0, ours_total = 0;
+
+	clock_t start = clock();
+	for (int i = 0; i < passes; ++i) {
+		for (size_t j = 0; j < samples.size(); ++j) {
+			c_api_total += c_api_escape(&out, samples[j].data(),
+					samples[j].length());
+		}
+	}
+	clock_t middle = clock();
+	for (int i = 0; i < passes; ++i) {
+		for (size_t j = 0; j < samples.size(); ++j) {
+			ours_total += mysqlpp::DBDriver::escape_string_no_conn(&out,
+					samples[j].data(), samples[j].length());
+		}
+	}
+	clock_t end = clock();
+
+	double c_api_secs = double(middle - start) / CLOCKS_PER_SEC;
+	double ours_secs = double(end - middle) / CLOCKS_PER_SEC;
+	std::cout << std::setw(10) << std::left << label <<
+			std::fixed << std::setprecision(3) <<
+			"  C API " << c_api_secs << "s" <<
+			"  MySQL++ " << ours_secs << "s";
+	if (ours_secs > 0) {
+		std::cout << std::setprecision(1) << "  (" <<
+				c_api_secs / ours_secs << "x)";
+	}
+	std::cout << std::endl;
+
+	// Spot-check the output, not just its length
+	for (size_t j = 0; j < samples.size(); ++j) {
+		std::string expected;
+		c_api_escape(&expected, samples[j].data(), samples[j].length());
+		mysqlpp::DBDriver::escape_string_no_conn(&out, samples[j].data(),
+				samples[j].length());
+		if (out != expected) {
+			c_api_total = ~ours_total;
+			break;
+		}
+	}
+
+	if (c_api_total != ours_total) {
+		std::cerr << "Results differ for " << label << '!' << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+// Returns a string of the given length made of random words, with a
+// special character every so often if \c specials is nonzero
+static std::string
+make_text(size_t length, int specials)
+{
+	static const char letters[] = "abcdefghijklmnopqrstuvwxyz";
+	static const char escapable[] = "'\"\\\n";
+	std::string text;
+	while (text.length() < length) {
+		if (specials && rand() % specials == 0) {
+			text += escapable[rand() % (sizeof(escapable) - 1)];
+		}
+		else if (rand() % 6 == 0) {
+			text += ' ';
+		}
+		else {
+			text += letters[rand() % (sizeof(letters) - 1)];
+		}
+	}
+	return text;
+}
+
+
+int
+main(int argc, char* argv[])
+{
+	const int passes = argc > 1 ? atoi(argv[1]) : 20;
+	const int count = 10000;
+
+	// Short names and long descriptions without anything to escape,
+	// as most column values are, plus some prose with quotes in it
+	std::vector<std::string> names, texts, quoted;
+	srand(42);
+	for (int i = 0; i < count; ++i) {
+		names.push_back(make_text(5 + rand() % 20, 0));
+		texts.push_back(make_text(200 + rand() % 300, 0));
+		quoted.push_back(make_text(200 + rand() % 300, 40));
+	}
+
+	bool ok = bench("SHORT", names, passes) &&
+			bench("LONG", texts, passes) &&
+			bench("QUOTED", quoted, passes);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/***********************************************************************
+ test/bulk_insert.cpp - Tests that BulkInsert packs rows into INSERT
+	statements right up to the packet size limit, and no further.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+#define MYSQLPP_ALLOW_SSQLS_V1	// suppress deprecation warning
+#include <ssqls.h>
+
+#include <iostream>
+#include <string>
+
+sql_create_2(item, 1, 2,
+	mysqlpp::sql_int, id,
+	mysqlpp::sql_varchar, name)
+
+// What BulkInsert puts ahead of the first row in each statement
+static const std::string header("INSERT INTO `item` (`id`,`name`) VALUES ");
+
+
+// There's no server here, so sending a statement always fails.  That
+// lets us see exactly when BulkInsert decides a statement is full: it
+// has to send what it has before it can take the next row.
+static bool
+test_packing()
+{
+	mysqlpp::Connection conn(false);
+
+	// Room for two 7-byte rows, the comma between them, and the
+	// command byte ahead of the SQL in the packet
+	const size_t exact = header.length() + 7 + 1 + 7 + 1;
+	mysqlpp::BulkInsert loader(conn, exact);
+	if (!loader.add(item(1, "a")) || !loader.add(item(2, "b")) ||
+			loader.pending() != 2) {
+		std::cerr << "Two rows didn't fit in a " << exact <<
+				" byte statement!" << std::endl;
+		return false;
+	}
+	else if (loader.add(item(3, "c")) || loader.pending() != 0 ||
+			loader.stats().rows != 0) {
+		std::cerr << "Third row didn't start a new statement!" <<
+				std::endl;
+		return false;
+	}
+
+	mysqlpp::BulkInsert tight(conn, exact - 1);
+	if (!tight.add(item(1, "a")) || tight.add(item(2, "b"))) {
+		std::cerr << "Two rows fit in a " << (exact - 1) <<
+				" byte statement!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that a row too big for any statement is refused the way the
+// object's exception setting says
+static bool
+test_too_big()
+{
+	mysqlpp::Connection conn(false);
+	mysqlpp::BulkInsert loader(conn, header.length() + 7);
+	if (loader.add(item(1, "a")) || loader.pending() != 0) {
+		std::cerr << "Row too big for a statement was accepted!" <<
+				std::endl;
+		return false;
+	}
+
+	loader.enable_exceptions();
+	try {
+		loader.add(item(1, "a"));
+		std::cerr << "Row too big for a statement didn't throw!" <<
+				std::endl;
+		return false;
+	}
+	catch (const mysqlpp::BadInsertPolicy&) {
+		return true;
+	}
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_packing() == false;
+		failures += test_too_big() == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_bulk_insert: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_bulk_insert: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
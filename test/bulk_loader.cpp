@@ -0,0 +1,156 @@
+/***********************************************************************
+ test/bulk_loader.cpp - Tests the text BulkLoader generates for LOAD
+	DATA LOCAL INFILE, and that it fails cleanly without a server.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+#define MYSQLPP_ALLOW_SSQLS_V1	// suppress deprecation warning
+#include <ssqls.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+sql_create_2(item, 1, 2,
+	mysqlpp::sql_int, id,
+	mysqlpp::sql_varchar_null, name)
+
+
+// Check one line of LOAD DATA input against what it should be
+static bool
+check(const std::string& what, const std::string& got,
+		const std::string& expected)
+{
+	if (got == expected) {
+		return true;
+	}
+	else {
+		std::cerr << what << " gave '" << got << "', not '" <<
+				expected << "'!" << std::endl;
+		return false;
+	}
+}
+
+
+// Check the text generated for each kind of row BulkLoader takes, both
+// through SQLStream, which BulkLoader uses, and through a plain stream
+static bool
+test_rows()
+{
+	const item special(1, std::string("a\tb\nc\\d\re\0f", 11));
+	const std::string special_tsv("1\ta\\tb\\nc\\\\d\\re\\0f");
+
+	std::ostringstream plain;
+	mysqlpp::tsv_row(plain, special);
+	mysqlpp::SQLStream sqls(0);
+	mysqlpp::tsv_row(sqls, special);
+	if (!check("tsv_row() on ostringstream", plain.str(), special_tsv) ||
+			!check("tsv_row() on SQLStream", sqls.str(), special_tsv)) {
+		return false;
+	}
+
+	const item nameless(2, mysqlpp::null);
+	std::ostringstream nulls;
+	mysqlpp::tsv_row(nulls, nameless);
+	if (!check("tsv_row() with null", nulls.str(), "2\t\\N")) {
+		return false;
+	}
+
+	std::vector<std::string> values;
+	values.push_back("x y");
+	values.push_back("tab\there");
+	std::ostringstream vec;
+	mysqlpp::tsv_row(vec, values);
+	if (!check("tsv_row() on vector", vec.str(), "x y\ttab\\there")) {
+		return false;
+	}
+
+	std::ostringstream cols, vcols;
+	mysqlpp::tsv_columns(cols, special);
+	mysqlpp::tsv_columns(vcols, values);
+	return check("tsv_columns() on SSQLS", cols.str(), "`id`,`name`") &&
+			check("tsv_columns() on vector", vcols.str(), "");
+}
+
+
+// There's no server here, so loading always fails.  Check that rows
+// wait for flush() and that the failure is reported the way the
+// object's exception setting says.
+static bool
+test_no_server()
+{
+	mysqlpp::Connection conn(false);
+	mysqlpp::BulkLoader loader(conn, "item");
+	if (!loader.add(item(1, std::string("a"))) || !loader.add(item(2, std::string("b"))) ||
+			loader.pending() != 2) {
+		std::cerr << "Rows weren't held for flush()!" << std::endl;
+		return false;
+	}
+	else if (loader.columns() != "`id`,`name`") {
+		std::cerr << "BulkLoader took column list '" <<
+				loader.columns() << "' from the first row!" << std::endl;
+		return false;
+	}
+	else if (loader.flush() || loader.pending() != 0 ||
+			loader.stats().rows != 0) {
+		std::cerr << "Load without a server didn't fail cleanly!" <<
+				std::endl;
+		return false;
+	}
+
+	std::vector<item> items(3, item(3, std::string("c")));
+	loader.enable_exceptions();
+	try {
+		loader.insert(items.begin(), items.end());
+		std::cerr << "Load without a server didn't throw!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::Exception&) {
+		return loader.pending() == 0;
+	}
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_rows() == false;
+		failures += test_no_server() == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_bulk_loader: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_bulk_loader: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
@@ -0,0 +1,184 @@
+/***********************************************************************
+ test/cell_arena.cpp - Tests CellArena, and String objects that are
+	views onto data held in an arena.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+
+#include <string.h>
+
+
+// Check that copies land in the arena intact and null-terminated, and
+// that a correctly-sized arena never needs a second slab.
+static bool
+test_copy()
+{
+	const char* cells[] = { "42", "", "hello, world", "3.14" };
+	const size_t ncells = sizeof(cells) / sizeof(cells[0]);
+
+	mysqlpp::CellArena::size_type bytes = 0;
+	for (size_t i = 0; i < ncells; ++i) {
+		bytes += strlen(cells[i]) + 1;
+	}
+
+	mysqlpp::CellArena arena(bytes);
+	for (size_t i = 0; i < ncells; ++i) {
+		const char* p = arena.copy(cells[i], strlen(cells[i]));
+		if (strcmp(p, cells[i]) != 0) {
+			std::cerr << "Arena copy of \"" << cells[i] <<
+					"\" came back as \"" << p << "\"!" << std::endl;
+			return false;
+		}
+	}
+
+	if (arena.bytes_used() != bytes) {
+		std::cerr << "Arena used " << arena.bytes_used() <<
+				" bytes, expected " << bytes << '!' << std::endl;
+		return false;
+	}
+	else if (arena.slabs() != 1) {
+		std::cerr << "Presized arena allocated " << arena.slabs() <<
+				" slabs!" << std::endl;
+		return false;
+	}
+	else {
+		return true;
+	}
+}
+
+
+// Check that an undersized arena grows without disturbing earlier data
+static bool
+test_growth()
+{
+	mysqlpp::CellArena arena(4);
+	const char* first = arena.copy("abc", 3);
+	std::string big(100000, 'x');
+	const char* second = arena.copy(big.data(), big.length());
+
+	if (strcmp(first, "abc") != 0) {
+		std::cerr << "Arena growth clobbered earlier data!" << std::endl;
+		return false;
+	}
+	else if (big.compare(second) != 0) {
+		std::cerr << "Oversized arena copy failed!" << std::endl;
+		return false;
+	}
+	else if (arena.slabs() != 2) {
+		std::cerr << "Arena has " << arena.slabs() << " slabs after "
+				"growth, expected 2!" << std::endl;
+		return false;
+	}
+	else {
+		return true;
+	}
+}
+
+
+// Check that String views behave like regular Strings, and keep the
+// arena alive after the last RefCountedArena outside them goes away.
+static bool
+test_views()
+{
+	mysqlpp::String num, dbl, null, str;
+	{
+		mysqlpp::RefCountedArena arena(new mysqlpp::CellArena);
+		num = mysqlpp::String(arena->copy("42", 2), 2,
+				mysqlpp::mysql_type_info::string_type, false, arena);
+		dbl = mysqlpp::String(arena->copy("2.5", 3), 3,
+				typeid(double), false, arena);
+		null = mysqlpp::String("NULL", 4,
+				mysqlpp::mysql_type_info::string_type, true, arena);
+		str = mysqlpp::String(arena->copy("it's", 4), 4,
+				mysqlpp::mysql_type_info::string_type, false, arena);
+	}
+
+	if (int(num) != 42) {
+		std::cerr << "Arena view \"" << num << "\" converted to " <<
+				int(num) << '!' << std::endl;
+		return false;
+	}
+	else if (double(dbl) != 2.5) {
+		std::cerr << "Arena view \"" << dbl << "\" converted to " <<
+				double(dbl) << '!' << std::endl;
+		return false;
+	}
+	else if (!null.is_null() || num.is_null() || null != mysqlpp::null) {
+		std::cerr << "Arena view SQL null flag is wrong!" << std::endl;
+		return false;
+	}
+	else if (str != "it's" || str.length() != 4 ||
+			str.conv(std::string()) != "it's") {
+		std::cerr << "Arena view \"" << str << "\" compares wrong!" <<
+				std::endl;
+		return false;
+	}
+	else if (dbl.quote_q() || !str.quote_q()) {
+		std::cerr << "Arena view lost its type info!" << std::endl;
+		return false;
+	}
+
+	// An SQLTypeAdapter made from a view must get its own copy
+	mysqlpp::SQLTypeAdapter sta(str);
+	if (sta.data() == str.data() || strcmp(sta.data(), "it's") != 0) {
+		std::cerr << "SQLTypeAdapter didn't copy arena view data!" <<
+				std::endl;
+		return false;
+	}
+
+	// Reassigning a view must make it a normal String
+	str = "fred";
+	if (str != "fred" || str.length() != 4) {
+		std::cerr << "Reassigned arena view is \"" << str << "\"!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	try {
+		int failures = 0;
+		failures += test_copy() == false;
+		failures += test_growth() == false;
+		failures += test_views() == false;
+		return failures;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_cell_arena: " << e.what() << std::endl;
+		return 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_cell_arena: " << e.what() << std::endl;
+		return 1;
+	}
+}
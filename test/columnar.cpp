@@ -0,0 +1,149 @@
+/***********************************************************************
+ test/columnar.cpp - Tests that ColumnarResult puts each kind of column
+	into the right typed array, and that store_columnar() handles
+	template queries and errors the way store() does.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+
+#include <string.h>
+
+
+// Check that a query that fails gives a result testing as false, or
+// throws if exceptions are on, like store().  This needs no server,
+// since a query on a connection that isn't up always fails.
+static bool
+test_failure()
+{
+	mysqlpp::Connection conn(false);
+	mysqlpp::Query query = conn.query("SELECT 1");
+	mysqlpp::ColumnarResult res = query.store_columnar();
+	if (res || res.num_rows() != 0 || res.num_columns() != 0) {
+		std::cerr << "Failed query gave a ColumnarResult!" << std::endl;
+		return false;
+	}
+
+	query.enable_exceptions();
+	try {
+		query.store_columnar("SELECT 1");
+		std::cerr << "Failed store_columnar() didn't throw!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::BadQuery&) {
+		return true;
+	}
+}
+
+
+// The checks below need a server, though not the sample database: each
+// query is a SELECT of literal values.  Without one, they're skipped.
+static bool
+test_columns(mysqlpp::Connection& conn)
+{
+	mysqlpp::Query query = conn.query(
+			"SELECT 1 AS id, 'apple' AS name, 1.5 AS price "
+			"UNION ALL SELECT 2, NULL, 2.25 "
+			"UNION ALL SELECT -3, 'cherry', NULL");
+	mysqlpp::ColumnarResult res = query.store_columnar();
+	if (!res || res.num_rows() != 3 || res.num_columns() != 3) {
+		std::cerr << "Columnar result has " << res.num_rows() <<
+				" rows and " << res.num_columns() << " columns!" <<
+				std::endl;
+		return false;
+	}
+
+	const mysqlpp::ColumnarResult::Column& id = res["id"];
+	if (id.kind() != mysqlpp::ColumnarResult::ck_int || !id.ints() ||
+			id.doubles() || id.ints()[0] != 1 || id.ints()[2] != -3 ||
+			id.null_count() != 0 || id.null_bitmap()) {
+		std::cerr << "Integer column is wrong!" << std::endl;
+		return false;
+	}
+
+	const mysqlpp::ColumnarResult::Column& name = res[1];
+	if (name.kind() != mysqlpp::ColumnarResult::ck_string ||
+			strcmp(name.c_str(0), "apple") != 0 ||
+			name.length(2) != 6 || name.null_count() != 1 ||
+			!name.is_null(1) || name.is_null(0) ||
+			name.null_bitmap()[0] != 2) {
+		std::cerr << "String column is wrong!" << std::endl;
+		return false;
+	}
+
+	const mysqlpp::ColumnarResult::Column& price = res.column("price");
+	if (price.kind() != mysqlpp::ColumnarResult::ck_double ||
+			price.doubles()[1] != 2.25 || !price.is_null(2) ||
+			price.value(0) != "1.5" || !price.value(2).is_null()) {
+		std::cerr << "Floating-point column is wrong!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that template query parameters are filled in as for store()
+static bool
+test_template(mysqlpp::Connection& conn)
+{
+	mysqlpp::Query query = conn.query("SELECT %0 AS id");
+	query.parse();
+	mysqlpp::ColumnarResult res = query.store_columnar(7);
+	if (res.num_rows() != 1 || res[0].ints()[0] != 7) {
+		std::cerr << "Template query gave the wrong result!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_failure() == false;
+
+		mysqlpp::Connection conn(false);
+		if (conn.connect()) {
+			failures += test_columns(conn) == false;
+			failures += test_template(conn) == false;
+		}
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_columnar: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_columnar: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
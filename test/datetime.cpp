@@ -30,6 +30,7 @@
 #include <string>
 
 #include <stdio.h>
+#include <time.h>
 
 using namespace mysqlpp;
 using namespace std;
@@ -199,6 +200,95 @@ test(int year, int month, int day, int hour, int minute, int second)
 }
 
 
+// Check the parts of the parser that the stringization tests above
+// don't reach: short fields, long TIMEs and fractional seconds.
+static unsigned int
+test_parsing()
+{
+	unsigned int failures = 0;
+	failures += test_date(Date("2008-1-5"), 2008, 1, 5);
+	failures += test_date(Date("20080105"), 2008, 1, 5);
+	failures += test_time(Time("123:04:05"), 123, 4, 5);
+	failures += test_time(Time("230405"), 23, 4, 5);
+
+	DateTime dt("2026-10-17 12:34:56.5");
+	failures += test_date(Date(dt), 2026, 10, 17);
+	if (dt.hour() != 12 || dt.minute() != 34 || dt.second() != 56 ||
+			dt.microsecond() != 500000) {
+		cerr << "DateTime '" << dt << "' should be 12:34:56.5!" << endl;
+		++failures;
+	}
+	failures += test_stringization(dt, "2026-10-17 12:34:56.500000",
+			"DateTime");
+	failures += test_stringization(Time("01:02:03.000042"),
+			"01:02:03.000042", "Time");
+	failures += test_stringization(Time("01:02:03.1234567"),
+			"01:02:03.123456", "Time");
+	return failures;
+}
+
+
+// Check that comparisons order values correctly, down to fractions
+// of a second
+static unsigned int
+test_comparison()
+{
+	unsigned int failures = 0;
+	if (!(Date(2008, 12, 31) < Date(2009, 1, 1)) ||
+			!(Date(2009, 2, 1) > Date(2009, 1, 31)) ||
+			Date(2009, 1, 1) != Date(2009, 1, 1)) {
+		cerr << "Date comparison is broken!" << endl;
+		++failures;
+	}
+	if (!(Time(9, 59, 59) < Time(10, 0, 0)) ||
+			!(Time(100, 0, 0) > Time(99, 59, 59)) ||
+			!(Time(1, 2, 3, 4) > Time(1, 2, 3))) {
+		cerr << "Time comparison is broken!" << endl;
+		++failures;
+	}
+	DateTime a(2009, 1, 1, 0, 0, 0, 1), b(2009, 1, 1, 0, 0, 0, 2);
+	if (!(a < b) || a == b || a.packed() >= b.packed() ||
+			!(DateTime(2008, 12, 31, 23, 59, 59) < a) ||
+			DateTime(2008, 12, 31, 23, 59, 59).packed() >= a.packed()) {
+		cerr << "DateTime comparison is broken!" << endl;
+		++failures;
+	}
+	return failures;
+}
+
+
+// Check our time_t conversions against the C library's, across a few
+// decades, at an odd interval so we hit all times of day.
+static unsigned int
+test_time_t()
+{
+	unsigned int failures = 0;
+	for (time_t t = -500000000; t < 2000000000; t += 987654) {
+		DateTime dt(t);
+		struct tm tm = *localtime(&t);
+		if (dt.year() != tm.tm_year + 1900 ||
+				dt.month() != tm.tm_mon + 1 ||
+				dt.day() != tm.tm_mday ||
+				dt.hour() != tm.tm_hour ||
+				dt.minute() != tm.tm_min ||
+				dt.second() != tm.tm_sec) {
+			cerr << "DateTime(" << t << ") gave " << dt <<
+					" instead of C library's value!" << endl;
+			return failures + 1;
+		}
+
+		tm.tm_isdst = -1;
+		time_t expected = mktime(&tm);
+		if (time_t(dt) != expected) {
+			cerr << "DateTime " << dt << " converts to time_t " <<
+					time_t(dt) << ", not " << expected << '!' << endl;
+			return failures + 1;
+		}
+	}
+	return failures;
+}
+
+
 int
 main()
 {
@@ -213,6 +303,9 @@ main()
 	dt.year(2007);
 	failures += test_stringization(dt, "2007-00-00 00:00:00", "DateTime");
 #endif
+	failures += test_parsing();
+	failures += test_comparison();
+	failures += test_time_t();
 	return failures;
 }
 
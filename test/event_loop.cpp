@@ -0,0 +1,111 @@
+/***********************************************************************
+ test/event_loop.cpp - Tests that EventLoop refuses queries it can't
+	run, and reports that the way its exception setting says.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+#include <string>
+
+
+// A fresh AsyncResult has nothing to report
+static bool
+test_async_result()
+{
+	mysqlpp::AsyncResult result;
+	if (result.ready() || result.succeeded() || result.errnum() != 0 ||
+			!result.error().empty()) {
+		std::cerr << "New AsyncResult isn't empty!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// There's no server here, so every connection is down.  Check that
+// queries on them are refused the way the exception setting says, and
+// that an empty loop returns straight away rather than waiting.
+static bool
+test_refused()
+{
+	mysqlpp::Connection conn(false);
+	mysqlpp::EventLoop loop;
+	mysqlpp::AsyncResult result;
+	loop.disable_exceptions();
+
+	if (loop.execute(conn, "DO 1", result) ||
+			loop.store(conn, "SELECT 1", result) ||
+			loop.use(conn, "SELECT 1", result)) {
+		std::cerr << "Loop started a query with no connection!" <<
+				std::endl;
+		return false;
+	}
+	else if (!*loop.error()) {
+		std::cerr << "Loop didn't say why the query wasn't started!" <<
+				std::endl;
+		return false;
+	}
+	else if (loop.pending() != 0 || loop.busy(conn) ||
+			loop.run_once(0) != 0 || result.ready()) {
+		std::cerr << "Refused query left something in the loop!" <<
+				std::endl;
+		return false;
+	}
+	loop.run();
+
+	loop.enable_exceptions();
+	try {
+		loop.store(conn, "SELECT 1", result);
+		std::cerr << "Refused query didn't throw!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::BadQuery&) {
+		return loop.pending() == 0;
+	}
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_async_result() == false;
+		failures += test_refused() == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_event_loop: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_event_loop: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
@@ -0,0 +1,185 @@
+/***********************************************************************
+ test/field_names.cpp - Tests the FieldNames hash index and the ColumnRef
+	name lookup cache.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+#include <sstream>
+
+#include <ctype.h>
+#include <string.h>
+
+
+// Build a field name list from a list of names, as a result set would
+static mysqlpp::FieldNames*
+make_names(const char* const* names, int count)
+{
+	mysqlpp::Fields fields;
+	for (int i = 0; i < count; ++i) {
+		MYSQL_FIELD f;
+		memset(&f, 0, sizeof(f));
+		f.name = const_cast<char*>(names[i]);
+		f.table = const_cast<char*>("stock");
+		f.db = const_cast<char*>("mysql_cpp_data");
+		f.type = MYSQL_TYPE_LONG;
+		fields.push_back(mysqlpp::Field(&f));
+	}
+	return new mysqlpp::FieldNames(fields);
+}
+
+
+// Check that every name is found at its index, ignoring case, whether
+// passed as a C string or a std::string.  Use enough names that the
+// hash table has to grow and some of them collide.
+static bool
+test_hits()
+{
+	const int count = 40;
+	std::vector<std::string> names;
+	std::vector<const char*> cnames;
+	for (int i = 0; i < count; ++i) {
+		std::ostringstream os;
+		os << "Col" << i;
+		names.push_back(os.str());
+	}
+	for (int i = 0; i < count; ++i) {
+		cnames.push_back(names[i].c_str());
+	}
+
+	mysqlpp::RefCountedPointer<mysqlpp::FieldNames> fn(
+			make_names(&cnames[0], count));
+	for (int i = 0; i < count; ++i) {
+		std::string upper(names[i]), lower(names[i]);
+		for (size_t j = 0; j < upper.length(); ++j) {
+			upper[j] = toupper(upper[j]);
+			lower[j] = tolower(lower[j]);
+		}
+		if ((*fn)[cnames[i]] != unsigned(i) ||
+				(*fn)[upper] != unsigned(i) ||
+				(*fn)[lower.c_str()] != unsigned(i)) {
+			std::cerr << "Lookup of " << names[i] << " failed!" <<
+					std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Check that names not in the list give size(), including ones that
+// differ from a real name only in length, and that duplicate names
+// give the first one's index.
+static bool
+test_misses()
+{
+	const char* names[] = { "id", "name", "ID", "price" };
+	mysqlpp::RefCountedPointer<mysqlpp::FieldNames> fn(
+			make_names(names, 4));
+	const char* misses[] = { "", "i", "idd", "nam", "names", "pr1ce" };
+	for (size_t i = 0; i < sizeof(misses) / sizeof(misses[0]); ++i) {
+		if ((*fn)[misses[i]] != 4) {
+			std::cerr << "Lookup of '" << misses[i] << "' found " <<
+					(*fn)[misses[i]] << ", expected a miss!" << std::endl;
+			return false;
+		}
+	}
+
+	if ((*fn)["Id"] != 0) {
+		std::cerr << "Duplicate field name found the wrong index!" <<
+				std::endl;
+		return false;
+	}
+
+	// Changes through the std::vector interface bypass the index, so
+	// lookups have to fall back to searching the list.
+	fn->push_back("qty");
+	(*fn)[size_t(1)] = "title";
+	if ((*fn)["QTY"] != 4 || (*fn)["title"] != 1 || (*fn)["name"] != 5) {
+		std::cerr << "Lookup in changed field name list failed!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that a ColumnRef looks its name up again only when it sees a
+// different field name list.
+static bool
+test_column_ref()
+{
+	const char* names1[] = { "id", "price" };
+	const char* names2[] = { "PRICE", "qty", "id" };
+	mysqlpp::RefCountedPointer<mysqlpp::FieldNames> fn1(
+			make_names(names1, 2));
+	mysqlpp::RefCountedPointer<mysqlpp::FieldNames> fn2(
+			make_names(names2, 3));
+
+	mysqlpp::ColumnRef price("price"), missing(std::string("cost"));
+	if (price.index(fn1) != 1 || price.index(fn2) != 0 ||
+			price.index(fn1) != 1 || price.name() != "price") {
+		std::cerr << "ColumnRef gave the wrong index!" << std::endl;
+		return false;
+	}
+	else if (missing.index(fn1) != 2 || missing.index(fn2) != 3) {
+		std::cerr << "ColumnRef to missing field didn't give size()!" <<
+				std::endl;
+		return false;
+	}
+	else if (price.index(mysqlpp::RefCountedPointer<
+			mysqlpp::FieldNames>()) != 0) {
+		std::cerr << "ColumnRef with no field names didn't give 0!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	try {
+		int failures = 0;
+		failures += test_hits() == false;
+		failures += test_misses() == false;
+		failures += test_column_ref() == false;
+		return failures;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_field_names: " << e.what() << std::endl;
+		return 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_field_names: " << e.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,173 @@
+/***********************************************************************
+ test/mapped_result.cpp - Tests that MappedResult gives back the rows
+	it spilled to its temporary file, and that its rows outlive it.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+#include <dbdriver.h>
+
+#include <iostream>
+#include <vector>
+
+#include <string.h>
+
+
+// Three rows, with a NULL and a value too long for a String's inline
+// buffer.  Being a SELECT of literals, this needs a server but not the
+// sample database.
+static const char* rows =
+		"SELECT 1 AS id, 'apple' AS name "
+		"UNION ALL SELECT 2, NULL "
+		"UNION ALL SELECT 3, REPEAT('x', 100)";
+
+
+// Check that the rows come back as they went in, by index and through
+// an iterator, and that rows and Strings keep the file mapped after
+// the MappedResult is gone.
+static bool
+test_rows(mysqlpp::Connection& conn)
+{
+	std::vector<mysqlpp::Row> kept;
+	mysqlpp::String name;
+	{
+		mysqlpp::Query query = conn.query(rows);
+		mysqlpp::MappedResult res = query.store_mapped();
+		if (!res || res.num_rows() != 3 || res.empty()) {
+			std::cerr << "Mapped result has " << res.num_rows() <<
+					" rows!" << std::endl;
+			return false;
+		}
+
+		// Each field is an 8-byte length, then the data and a null
+		// terminator unless it's NULL.  After the rows, padded to
+		// 8 bytes, comes an 8-byte offset for each row.
+		if (res.file_size() != 192) {
+			std::cerr << "Mapped result's file is " << res.file_size() <<
+					" bytes, expected 192!" << std::endl;
+			return false;
+		}
+
+		int ids = 0;
+		for (mysqlpp::MappedResult::const_iterator it = res.begin();
+				it != res.end(); ++it) {
+			ids += int((*it)["id"]);
+			kept.push_back(*it);
+		}
+		if (ids != 6 || res.end() - res.begin() != 3) {
+			std::cerr << "Iterating over mapped result gave id total " <<
+					ids << '!' << std::endl;
+			return false;
+		}
+
+		name = res[0]["name"];
+	}
+
+	if (name != "apple" || !kept[1]["name"].is_null() ||
+			kept[2]["name"].length() != 100 || kept[2][1][99] != 'x' ||
+			int(kept[2]["id"]) != 3) {
+		std::cerr << "Rows from mapped result went bad!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check bounds checking, template queries, and errors
+static bool
+test_errors(mysqlpp::Connection& conn)
+{
+	mysqlpp::Query query = conn.query(rows);
+	mysqlpp::MappedResult res = query.store_mapped();
+	try {
+		res.at(3);
+		std::cerr << "Out of range at() didn't throw!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::BadIndex&) {
+	}
+
+	mysqlpp::Query tquery = conn.query("SELECT %0 AS id");
+	tquery.parse();
+	res = tquery.store_mapped(7);
+	if (res.num_rows() != 1 || int(res[0][0]) != 7) {
+		std::cerr << "Template query gave wrong mapped result!" <<
+				std::endl;
+		return false;
+	}
+
+	// A bad directory for the temporary file is an error, but the
+	// connection must still be usable afterward.
+	mysqlpp::DBDriver* dbd = conn.driver();
+	if (dbd->execute(rows, strlen(rows))) {
+		try {
+			mysqlpp::MappedResult bad(dbd->use_result(), dbd, true,
+					"/nonexistent/directory");
+			std::cerr << "Mapping result into missing directory didn't "
+					"throw!" << std::endl;
+			return false;
+		}
+		catch (const mysqlpp::UseQueryError&) {
+		}
+	}
+	if (conn.query("SELECT 1").store().num_rows() != 1) {
+		std::cerr << "Query after failed mapping failed!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		mysqlpp::MappedResult empty;
+		if (empty || !empty.empty() || empty.begin() != empty.end()) {
+			std::cerr << "Default MappedResult isn't empty!" << std::endl;
+			++failures;
+		}
+
+		mysqlpp::Connection conn(false);
+		if (conn.connect()) {
+			conn.enable_exceptions();
+			failures += test_rows(conn) == false;
+			failures += test_errors(conn) == false;
+		}
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_mapped_result: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_mapped_result: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
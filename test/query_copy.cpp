@@ -64,6 +64,31 @@ test_plain(const char* testname, Query& q1, Query q2)
 }
 
 
+static bool
+test_swap()
+{
+	Query q1(0, false, "template %0 swap test");
+	q1.parse();
+	Query q2(0, false, "plain swap test");
+
+	q1.swap(q2);
+	q1 << ", appended";
+	if (q1.str() != "plain swap test, appended") {
+		std::cerr << "TEST swap failed: q1('" << q1.str() <<
+				"') lost its text!" << std::endl;
+		return false;
+	}
+	else if (q2.str("query") != "template query swap test") {
+		std::cerr << "TEST swap failed: q2('" << q2.str("query") <<
+				"') lost its template!" << std::endl;
+		return false;
+	}
+	else {
+		return true;
+	}
+}
+
+
 int
 main()
 {
@@ -87,7 +112,8 @@ main()
 				test_plain("2a", orig2, copy3) &&
 				test_plain("2b", orig2, copy4) &&
 				test_parm("3a", orig3, copy5, "query") &&
-				test_parm("3b", orig3, copy6, "query")) {
+				test_parm("3b", orig3, copy6, "query") &&
+				test_swap()) {
 			return 0;
 		}
 	}
@@ -0,0 +1,146 @@
+/***********************************************************************
+ test/query_template.cpp - Tests QueryTemplate, the parsed form of a
+	template query that Query objects can share.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+
+
+// Check the parsed form of a template that uses most of the syntax
+static bool
+test_parse()
+{
+	const mysqlpp::QueryTemplate t(
+			"select %1:col from %0 where pct = 50%% and x %2Q:x: 5%");
+	const mysqlpp::QueryTemplate::Elements& e = t.elements();
+	if (e.size() != 4 ||
+			e[0].before != "select " || e[0].num != 1 ||
+			e[1].before != " from " || e[1].num != 0 ||
+			e[2].before != " where pct = 50% and x " ||
+			e[2].num != 2 || e[2].option != 'Q' ||
+			e[3].before != " 5%" || e[3].num != -1) {
+		std::cerr << "Template parsed wrong!" << std::endl;
+		return false;
+	}
+	else if (t.parameters() != 3 || t.literal_length() != 39) {
+		std::cerr << "Template needs " << t.parameters() <<
+				" parameters and has " << t.literal_length() <<
+				" literal bytes, expected 3 and 39!" << std::endl;
+		return false;
+	}
+	else if (t.index("col") != 1 || t.index("x") != 2 ||
+			t.index("nope") != -1 || t.name(1) != "col" ||
+			!t.name(0).empty() || !t.name(9).empty()) {
+		std::cerr << "Template parameter names are wrong!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that a shared template fills in the same as one Query parses
+// for itself, and that each Query gets its own parameter values
+static bool
+test_share()
+{
+	const char* text = "select %1:col from %0";
+	mysqlpp::QueryTemplate t(text);
+	mysqlpp::Query parsed(0, false, text);	// don't pass 0 for conn
+	parsed.parse();						// in real code
+	mysqlpp::Query q1(0, false), q2(0, false);
+	q1.query_template(t);
+	q2.query_template(parsed.query_template());
+
+	q1.template_defaults["col"] = "id";
+	std::string s1 = q1.str("stock");
+	std::string s2 = q2.str("stock", "item");
+	std::string s3 = parsed.str("stock", "item");
+	if (s1 != "select id from stock" || s2 != s3 ||
+			s2 != "select item from stock") {
+		std::cerr << "Shared template filled in wrong: '" << s1 <<
+				"', '" << s2 << "', '" << s3 << "'!" << std::endl;
+		return false;
+	}
+
+	q1.reset();
+	q1 << "plain";
+	if (q1.str() != "plain" || q2.str("a", "b") != "select b from a") {
+		std::cerr << "Reset of one query disturbed the other!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check quoting, escaping and NULL handling when filling in a template,
+// and that default values come out the same each time they're used
+static bool
+test_render()
+{
+	mysqlpp::Connection conn(false);
+	mysqlpp::Query q = conn.query(mysqlpp::QueryTemplate(
+			"values (%0q, %1Q, %2q, %3, %4q:def)"));
+	q.template_defaults["def"] = "a'b";
+
+	const char* expected = "values ('it\\'s', 'x\"y', NULL, 5, 'a\\'b')";
+	for (int i = 0; i < 2; ++i) {
+		std::string s = q.str("it's", "x\"y", mysqlpp::null, 5);
+		if (s != expected) {
+			std::cerr << "Template filled in as '" << s << "', "
+					"expected '" << expected << "'!" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_parse() == false;
+		failures += test_share() == false;
+		failures += test_render() == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_query_template: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_query_template: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
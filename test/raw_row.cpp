@@ -0,0 +1,122 @@
+/***********************************************************************
+ test/raw_row.cpp - Tests that storein() fills SSQLS objects correctly
+		straight from the C API's row data, through RawRow.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+#define MYSQLPP_ALLOW_SSQLS_V1	// suppress deprecation warning
+#include <ssqls.h>
+
+#include <iostream>
+#include <vector>
+
+sql_create_2(fruit, 1, 2,
+		mysqlpp::sql_int, id,
+		mysqlpp::sql_varchar, name)
+
+
+// Two rows with a column for each member of fruit.  Being a SELECT of
+// literals, this needs a server but not the sample database.
+static const char* fruit_rows =
+		"SELECT 1 AS id, 'apple' AS name "
+		"UNION ALL SELECT 2, 'banana'";
+
+// The same, less the "name" column
+static const char* nameless_rows = "SELECT 3 AS id";
+
+
+// Check that each member gets its column's value
+static bool
+test_decode(mysqlpp::Connection& conn)
+{
+	std::vector<fruit> v;
+	conn.query(fruit_rows).storein(v);
+	if (v.size() != 2 || v[0].id != 1 || v[0].name != "apple" ||
+			v[1].id != 2 || v[1].name != "banana") {
+		std::cerr << "storein() decoded " << v.size() <<
+				" rows wrong!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that a member with no matching column throws BadFieldName if
+// exceptions are enabled, and gets the default value if not
+static bool
+test_missing_column(mysqlpp::Connection& conn)
+{
+	std::vector<fruit> v;
+	try {
+		conn.query(nameless_rows).storein(v);
+		std::cerr << "Missing column didn't throw!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::BadFieldName&) {
+		if (!v.empty()) {
+			std::cerr << "Row with missing column was kept!" <<
+					std::endl;
+			return false;
+		}
+	}
+
+	mysqlpp::Query quiet = conn.query(nameless_rows);
+	quiet.disable_exceptions();
+	quiet.storein(v);
+	if (v.size() != 1 || v[0].id != 3 || !v[0].name.empty()) {
+		std::cerr << "Missing column with exceptions disabled gave " <<
+				v.size() << " rows!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		mysqlpp::Connection conn(false);
+		if (conn.connect()) {
+			conn.enable_exceptions();
+			failures += test_decode(conn) == false;
+			failures += test_missing_column(conn) == false;
+		}
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_raw_row: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_raw_row: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
@@ -0,0 +1,123 @@
+/***********************************************************************
+ test/refcounted.cpp - Tests RefCountedPointer, both with its own
+	separately allocated counter and with RefCounted subclasses that
+	carry their counter inside the object.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+
+
+static int live_objects = 0;
+
+// A class RefCountedPointer has to allocate a counter for
+struct Plain
+{
+	Plain() { ++live_objects; }
+	~Plain() { --live_objects; }
+};
+
+// A class that carries its own counter
+struct Intrusive : public mysqlpp::RefCounted
+{
+	Intrusive() { ++live_objects; }
+	Intrusive(const Intrusive&) : mysqlpp::RefCounted() { ++live_objects; }
+	~Intrusive() { --live_objects; }
+};
+
+
+// Run the same lifetime checks on either kind of pointer
+template <class T>
+static bool
+test_lifetime(const char* what)
+{
+	{
+		mysqlpp::RefCountedPointer<T> a(new T), b(a), c;
+		c = b;
+		a = 0;
+		b.assign(new T);
+		if (live_objects != 2) {
+			std::cerr << what << ": " << live_objects <<
+					" objects alive after reassignment, not 2!" <<
+					std::endl;
+			return false;
+		}
+		c.swap(b);
+		b = c;
+	}
+
+	if (live_objects != 0) {
+		std::cerr << what << ": " << live_objects <<
+				" objects leaked!" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+// Since the count lives in the object, separately created pointers to
+// the same RefCounted object share it, and copying the object doesn't
+// copy its count.
+static bool
+test_intrusive_sharing()
+{
+	{
+		Intrusive* raw = new Intrusive;
+		mysqlpp::RefCountedPointer<Intrusive> a(raw);
+		{
+			mysqlpp::RefCountedPointer<Intrusive> b(raw);
+		}
+		if (live_objects != 1) {
+			std::cerr << "Second pointer to RefCounted object "
+					"destroyed it early!" << std::endl;
+			return false;
+		}
+
+		mysqlpp::RefCountedPointer<Intrusive> copy(new Intrusive(*a));
+		copy = 0;
+		if (live_objects != 1) {
+			std::cerr << "Copy of RefCounted object shared its "
+					"count!" << std::endl;
+			return false;
+		}
+	}
+
+	if (live_objects != 0) {
+		std::cerr << "RefCounted object leaked!" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	failures += test_lifetime<Plain>("Plain") == false;
+	failures += test_lifetime<Intrusive>("Intrusive") == false;
+	failures += test_intrusive_sharing() == false;
+	return failures;
+}
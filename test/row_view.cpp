@@ -0,0 +1,170 @@
+/***********************************************************************
+ test/row_view.cpp - Tests that RowView gives the same values as Row,
+	that copies taken from it outlive it, and that functors taking a
+	Row& still work with the Query algorithms built on it.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+#include <list>
+#include <vector>
+
+
+// The checks below that need a server don't need the sample database,
+// since every query is a SELECT of literal values.  Without a server,
+// they're skipped.
+static const char* two_rows =
+		"SELECT 1 AS id, 'apple' AS name UNION ALL SELECT 2, NULL";
+
+
+// Functors written for the Row objects fetch_row() gives take a Row&,
+// and must keep compiling with algorithms that pass RowView rows.
+struct SumIds
+{
+	SumIds() : rows(0), total(0) { }
+
+	void operator()(mysqlpp::Row& row)
+	{
+		++rows;
+		total += int(row["id"]);
+	}
+
+	int rows;
+	int total;
+};
+
+struct IsNamed
+{
+	bool operator()(mysqlpp::Row& row) { return !row["name"].is_null(); }
+};
+
+
+// Check that a view gives the same values a Row would, and that
+// copying something out of it gives a copy that survives the next
+// fetch.
+static bool
+test_view(mysqlpp::Connection& conn)
+{
+	mysqlpp::Query query = conn.query(two_rows);
+	mysqlpp::UseQueryResult res = query.use();
+	if (!res) {
+		std::cerr << "Query failed: " << query.error() << std::endl;
+		return false;
+	}
+
+	const mysqlpp::RowView& first = res.fetch_row_view();
+	if (!first || first.size() != 2 || int(first[0]) != 1 ||
+			first["name"] != "apple" || first.field_num("name") != 1) {
+		std::cerr << "First view is wrong!" << std::endl;
+		return false;
+	}
+	const mysqlpp::String name = first["name"];
+	const mysqlpp::Row row = first.to_row();
+
+	const mysqlpp::RowView& second = res.fetch_row_view();
+	if (!second || int(second["id"]) != 2 || !second[1].is_null()) {
+		std::cerr << "Second view is wrong!" << std::endl;
+		return false;
+	}
+	else if (name != "apple" || row[1] != "apple" || int(row[0]) != 1) {
+		std::cerr << "Copies from the first view didn't survive the "
+				"second fetch!" << std::endl;
+		return false;
+	}
+	else if (res.fetch_row_view()) {
+		std::cerr << "View past the end tests as true!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that for_each() and store_if() pass each row to the functor,
+// and that store_if() keeps copies of the rows it stores.
+static bool
+test_algorithms(mysqlpp::Connection& conn)
+{
+	mysqlpp::Query query = conn.query(two_rows);
+	SumIds sum = query.for_each(SumIds());
+	if (sum.rows != 2 || sum.total != 3) {
+		std::cerr << "for_each() saw " << sum.rows << " rows adding up "
+				"to " << sum.total << '!' << std::endl;
+		return false;
+	}
+
+	std::vector<mysqlpp::Row> named;
+	query = conn.query(two_rows);
+	query.store_if(named, IsNamed());
+	if (named.size() != 1 || named[0]["name"] != "apple") {
+		std::cerr << "store_if() kept " << named.size() << " rows!" <<
+				std::endl;
+		return false;
+	}
+
+	std::list<mysqlpp::Row> all;
+	query.storein_sequence(all, two_rows);
+	if (all.size() != 2 || all.front()["name"] != "apple" ||
+			!all.back()["name"].is_null()) {
+		std::cerr << "storein_sequence() stored the wrong rows!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		mysqlpp::Connection conn(false);
+		if (conn.connect()) {
+			failures += test_view(conn) == false;
+			failures += test_algorithms(conn) == false;
+		}
+		else {
+			// Still instantiate the algorithms with Row& functors
+			mysqlpp::Query query = conn.query(two_rows);
+			std::vector<mysqlpp::Row> named;
+			query.for_each(SumIds());
+			query.store_if(named, IsNamed());
+		}
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_row_view: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_row_view: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
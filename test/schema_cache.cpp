@@ -0,0 +1,177 @@
+/***********************************************************************
+ test/schema_cache.cpp - Tests SchemaCache, which lets result sets with
+	the same columns share one ResultSchema.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+
+#include <string.h>
+
+
+// Fill in the parts of a C API field description that MySQL++ uses
+static void
+make_field(MYSQL_FIELD& f, const char* name, enum_field_types type,
+		unsigned int flags = 0)
+{
+	memset(&f, 0, sizeof(f));
+	f.name = const_cast<char*>(name);
+	f.table = const_cast<char*>("stock");
+	f.db = const_cast<char*>("mysql_cpp_data");
+	f.type = type;
+	f.flags = flags;
+	f.length = 11;
+}
+
+
+// Check that identical column lists share one schema, and that any
+// real difference gets a schema of its own.
+static bool
+test_sharing()
+{
+	MYSQL_FIELD fields[2];
+	make_field(fields[0], "item", MYSQL_TYPE_VAR_STRING);
+	make_field(fields[1], "num", MYSQL_TYPE_LONG, NOT_NULL_FLAG);
+
+	mysqlpp::SchemaCache cache;
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> a =
+			cache.get(fields, 2);
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> b =
+			cache.get(fields, 2);
+	if (a.raw() != b.raw() || cache.hits() != 1 || cache.misses() != 1) {
+		std::cerr << "Same column list didn't share a schema!" <<
+				std::endl;
+		return false;
+	}
+	else if ((*a->names())["NUM"] != 1 ||
+			strcmp(a->fields()[0].table(), "stock") != 0 ||
+			a->types()->at(1).base_type() != typeid(int)) {
+		std::cerr << "Schema doesn't describe its fields!" << std::endl;
+		return false;
+	}
+
+	// A different type on one column, or fewer columns, is a miss
+	fields[1].flags |= UNSIGNED_FLAG;
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> c =
+			cache.get(fields, 2);
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> d =
+			cache.get(fields, 1);
+	if (c.raw() == a.raw() || d.raw() == a.raw() ||
+			cache.misses() != 3 || cache.size() != 3) {
+		std::cerr << "Different column lists shared a schema!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that result sets differing only in max_length get their own
+// Field lists, but still share names and types.
+static bool
+test_max_length()
+{
+	MYSQL_FIELD fields[1];
+	make_field(fields[0], "item", MYSQL_TYPE_VAR_STRING);
+
+	mysqlpp::SchemaCache cache;
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> a =
+			cache.get(fields, 1);
+	fields[0].max_length = 7;
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> b =
+			cache.get(fields, 1);
+	if (a.raw() == b.raw() || b->fields()[0].max_length() != 7 ||
+			a->fields()[0].max_length() != 0) {
+		std::cerr << "Results with different max_length values shared "
+				"a Field list!" << std::endl;
+		return false;
+	}
+	else if (a->names().raw() != b->names().raw() ||
+			a->types().raw() != b->types().raw()) {
+		std::cerr << "Results with the same columns didn't share names "
+				"and types!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that the cache starts over when full, and can be turned off
+static bool
+test_capacity()
+{
+	const char* names[] = { "a", "b", "c" };
+	MYSQL_FIELD fields[3];
+	for (int i = 0; i < 3; ++i) {
+		make_field(fields[i], names[i], MYSQL_TYPE_LONG);
+	}
+
+	mysqlpp::SchemaCache cache(2);
+	for (int i = 0; i < 3; ++i) {
+		cache.get(fields + i, 1);
+	}
+	if (cache.size() != 1) {
+		std::cerr << "Full cache has " << cache.size() <<
+				" entries after another miss, expected 1!" << std::endl;
+		return false;
+	}
+
+	cache.capacity(0);
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> a =
+			cache.get(fields, 1);
+	mysqlpp::RefCountedPointer<mysqlpp::ResultSchema> b =
+			cache.get(fields, 1);
+	if (a.raw() == b.raw() || cache.size() != 0) {
+		std::cerr << "Disabled cache still shared a schema!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	try {
+		int failures = 0;
+		failures += test_sharing() == false;
+		failures += test_max_length() == false;
+		failures += test_capacity() == false;
+		return failures;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_schema_cache: " << e.what() << std::endl;
+		return 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_schema_cache: " << e.what() << std::endl;
+		return 1;
+	}
+}
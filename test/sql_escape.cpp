@@ -0,0 +1,167 @@
+/***********************************************************************
+ test/sql_escape.cpp - Tests the string escaping engine against the
+	MySQL C API's mysql_escape_string().
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+#include <dbdriver.h>
+#include <sql_escape.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Escape the text both ways, and complain if the results differ
+static bool
+check(const std::string& text)
+{
+	std::vector<char> ours(text.length() * 2 + 1), theirs(ours.size());
+	size_t ours_len = mysqlpp::internal::escape_sql(&ours[0],
+			text.data(), text.length());
+	size_t theirs_len = mysql_escape_string(&theirs[0],
+			text.data(), static_cast<unsigned long>(text.length()));
+	if (ours_len == theirs_len &&
+			std::string(&ours[0], ours_len + 1) ==
+			std::string(&theirs[0], theirs_len + 1)) {
+		return true;
+	}
+	else {
+		std::cerr << "Escaping '" << text << "' gave '" <<
+				std::string(&ours[0], ours_len) << "', expected '" <<
+				std::string(&theirs[0], theirs_len) << "'!" << std::endl;
+		return false;
+	}
+}
+
+
+// Put each special character at each position in strings long enough
+// to cover the vector loop, its 16-byte step and the byte-wise tail
+static bool
+test_positions()
+{
+	const char specials[] = { '\0', '\n', '\r', '\032', '\\', '\'', '"' };
+	for (size_t len = 0; len < 70; ++len) {
+		std::string text(len, 'x');
+		if (!check(text)) {
+			return false;
+		}
+
+		for (size_t pos = 0; pos < len; ++pos) {
+			for (size_t i = 0; i < sizeof(specials); ++i) {
+				text[pos] = specials[i];
+				if (!check(text)) {
+					return false;
+				}
+			}
+			text[pos] = 'x';
+		}
+	}
+
+	// Every byte value, including ones that are part of UTF-8
+	// multibyte characters, and runs of escapes
+	std::string all;
+	for (int c = 0; c < 256; ++c) {
+		all += static_cast<char>(c);
+	}
+	return check(all) && check(all + all) &&
+			check("caf\xc3\xa9 'n' \"y\"") && check(std::string(40, '\''));
+}
+
+
+// Check the std::string interface, which skips the copy for text with
+// nothing to escape
+static bool
+test_string()
+{
+	std::string s("nothing to see");
+	const char* before = s.data();
+	if (mysqlpp::DBDriver::escape_string_no_conn(&s) != 14 ||
+			s != "nothing to see" || s.data() != before) {
+		std::cerr << "Escaping clean text in place changed it!" <<
+				std::endl;
+		return false;
+	}
+
+	s = "it's";
+	if (mysqlpp::DBDriver::escape_string_no_conn(&s) != 5 ||
+			s != "it\\'s") {
+		std::cerr << "Escaping in place gave '" << s << "'!" << std::endl;
+		return false;
+	}
+
+	std::string out("junk");
+	if (mysqlpp::DBDriver::escape_string_no_conn(&out, "a\nb", 3) != 4 ||
+			out != "a\\nb" ||
+			mysqlpp::DBDriver::escape_string_no_conn(&out, "plain") != 5 ||
+			out != "plain") {
+		std::cerr << "Escaping into another string gave '" << out <<
+				"'!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check which character sets we escape ourselves
+static bool
+test_charsets()
+{
+	if (!mysqlpp::internal::escape_sql_safe("utf8mb4") ||
+			!mysqlpp::internal::escape_sql_safe("latin1") ||
+			mysqlpp::internal::escape_sql_safe("gbk") ||
+			mysqlpp::internal::escape_sql_safe("sjis") ||
+			mysqlpp::internal::escape_sql_safe(0)) {
+		std::cerr << "Wrong choice of character sets to escape without "
+				"the C API!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_positions() == false;
+		failures += test_string() == false;
+		failures += test_charsets() == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_sql_escape: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_sql_escape: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
@@ -0,0 +1,167 @@
+/***********************************************************************
+ test/sql_writer.cpp - Tests SQLWriter, the buffer Query and SQLStream
+	build their SQL in.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+
+// Compare the writer's text to what we expect, and complain if they
+// differ
+static bool
+check(const char* what, const mysqlpp::SQLWriter& w, const char* expected)
+{
+	if (w.str() == expected) {
+		return true;
+	}
+	else {
+		std::cerr << what << " gave '" << w.str() << "', expected '" <<
+				expected << "'!" << std::endl;
+		return false;
+	}
+}
+
+
+// Check each kind of value the writer appends directly
+static bool
+test_append()
+{
+	mysqlpp::SQLWriter w;
+	w.append_int(0).append(' ').append_int(-42).append(' ').
+			append_int(std::numeric_limits<mysqlpp::longlong>::min()).
+			append(' ').
+			append_uint(std::numeric_limits<mysqlpp::ulonglong>::max());
+	if (!check("Integers", w,
+			"0 -42 -9223372036854775808 18446744073709551615")) {
+		return false;
+	}
+
+	w.clear();
+	w.append_double(1.5).append(',').append_double(0.1).append(',').
+			append_double(std::numeric_limits<double>::infinity());
+	if (!check("Doubles", w, "1.5,0.10000000000000001,0")) {
+		return false;
+	}
+
+	w.clear();
+	w.append_date(mysqlpp::Date(2026, 10, 17)).append(' ').
+			append_time(mysqlpp::Time(9, 5, 0)).append(' ').
+			append_datetime(mysqlpp::DateTime::now());
+	if (!check("Dates", w, "2026-10-17 09:05:00 NOW()")) {
+		return false;
+	}
+
+	const std::string s("it's");
+	w.clear();
+	w.append("x = ").append_quoted(s.data(), s.length()).
+			append(", y = ").append_escaped(s.data(), s.length());
+	return check("Strings", w, "x = 'it\\'s', y = it\\'s");
+}
+
+
+// Check that the stream interface and direct appends land in the same
+// buffer, and that clearing the buffer keeps its memory
+static bool
+test_stream()
+{
+	mysqlpp::Query q(0, false, "select ");	// don't pass 0 for conn
+	q << 1 << ", ";						// in real code
+	q.writer().append_int(2);
+	q << " from t";
+	if (!check("Query stream", q.writer(), "select 1, 2 from t") ||
+			q.tellp() != std::streampos(18)) {
+		return false;
+	}
+
+	q.seekp(7);
+	q << "3";
+	if (!check("Query seekp", q.writer(), "select 3")) {
+		return false;
+	}
+
+	size_t capacity = q.writer().capacity();
+	q.reset();
+	if (!q.writer().empty() || q.writer().capacity() != capacity) {
+		std::cerr << "Query reset lost the buffer's memory!" << std::endl;
+		return false;
+	}
+
+	mysqlpp::SQLStream s(0);
+	s << "a";
+	s.writer().append('b');
+	s << mysqlpp::quote << "c";
+	return check("SQLStream", s.writer(), "ab'c'");
+}
+
+
+// Check that the manipulators write into a Query's buffer, and that a
+// plain stream copying a Query's format flags isn't mistaken for one
+static bool
+test_manip()
+{
+	mysqlpp::Query q(0, false);				// don't pass 0 for conn
+	q << "x = " << mysqlpp::quote << "it's";	// in real code
+	if (!check("Query quote", q.writer(), "x = 'it\\'s'")) {
+		return false;
+	}
+
+	std::ostringstream os;
+	os.copyfmt(q);
+	os << mysqlpp::quote << mysqlpp::SQLTypeAdapter("it's");
+	if (os.str() != "it's") {
+		std::cerr << "copyfmt() made an ostringstream act like a Query: " <<
+				os.str() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_append() == false;
+		failures += test_stream() == false;
+		failures += test_manip() == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_sql_writer: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_sql_writer: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
@@ -0,0 +1,132 @@
+/***********************************************************************
+ test/statement_batch.cpp - Tests that StatementBatch keeps statements
+	as they were added and attributes a failure to the right one.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+#include <string>
+
+
+// Check that statements come back out of the batch as they went in,
+// less any trailing semicolon
+static bool
+test_add()
+{
+	mysqlpp::Connection conn(false);
+	mysqlpp::Query query = conn.query();
+	query << "SELECT " << 2;
+
+	mysqlpp::StatementBatch batch(conn, 1024);
+	batch.add("SELECT 1; \n");
+	batch.add(query);
+	batch.add(std::string("SELECT 'a;b'"));
+	if (batch.size() != 3) {
+		std::cerr << "Batch holds " << batch.size() <<
+				" statements, not 3!" << std::endl;
+		return false;
+	}
+	else if (batch.statement(0) != "SELECT 1" ||
+			batch.statement(1) != "SELECT 2" ||
+			batch.statement(2) != "SELECT 'a;b'") {
+		std::cerr << "Batch gave back '" << batch.statement(0) <<
+				"', '" << batch.statement(1) << "', '" <<
+				batch.statement(2) << "'!" << std::endl;
+		return false;
+	}
+
+	batch.clear();
+	if (!batch.empty()) {
+		std::cerr << "Batch not empty after clear()!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// There's no server here, so the first statement always fails.  Check
+// that it's the one blamed, that the rest are marked as never run, and
+// that the failure is reported the way the exception setting says.
+static bool
+test_failure()
+{
+	mysqlpp::Connection conn(false);
+	mysqlpp::StatementBatch batch(conn, 1024);
+	batch.add("SELECT 1");
+	batch.add("SELECT 2");
+	batch.add("SELECT 3");
+
+	const std::vector<mysqlpp::StatementOutcome>& out = batch.execute();
+	if (out.size() != 3 || !batch.empty() || batch.round_trips() != 1) {
+		std::cerr << "Batch gave " << out.size() << " outcomes in " <<
+				batch.round_trips() << " round trips!" << std::endl;
+		return false;
+	}
+	else if (out[0].status != mysqlpp::StatementOutcome::failed ||
+			out[0].error.empty() ||
+			out[1].status != mysqlpp::StatementOutcome::not_run ||
+			out[2].status != mysqlpp::StatementOutcome::not_run) {
+		std::cerr << "Failure wasn't put on the first statement!" <<
+				std::endl;
+		return false;
+	}
+
+	batch.add("SELECT 4");
+	batch.enable_exceptions();
+	try {
+		batch.execute();
+		std::cerr << "Failed batch didn't throw!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::BadQuery&) {
+		return batch.outcomes().size() == 1 &&
+				batch.outcomes()[0].status ==
+				mysqlpp::StatementOutcome::failed;
+	}
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		failures += test_add() == false;
+		failures += test_failure() == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_statement_batch: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_statement_batch: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
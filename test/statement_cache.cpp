@@ -0,0 +1,204 @@
+/***********************************************************************
+ test/statement_cache.cpp - Tests StatementCache, which lets a
+	connection reuse its prepared statements.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+
+typedef mysqlpp::RefCountedPointer<MYSQL_STMT> StmtPtr;
+
+
+// Check that whitespace differences go away, except inside quotes and
+// comments
+static bool
+test_normalize()
+{
+	static const struct {
+		const char* sql;
+		const char* key;
+	} cases[] = {
+		{ "  select *\n\tfrom  stock ", "select * from stock" },
+		{ "select 'a  b', \"c\t d\"", "select 'a  b', \"c\t d\"" },
+		{ "select 'it\\'s  here'  ,  `x  y`", "select 'it\\'s  here' , `x  y`" },
+		{ "select 1 # it's\nfrom  t", "select 1 # it's\nfrom t" },
+		{ "select 1 -- it's\n, 'a  b'", "select 1 -- it's\n, 'a  b'" },
+		{ "select 1 -- it's\n, 'a b'", "select 1 -- it's\n, 'a b'" },
+		{ "select 1 /* it's  */  from t", "select 1 /* it's  */ from t" },
+		{ "select 2--1,  'x'", "select 2--1, 'x'" },
+		{ "select 1 #", "select 1 #" },
+		{ "", "" },
+	};
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+		const std::string key =
+				mysqlpp::StatementCache::normalize(cases[i].sql);
+		if (key != cases[i].key) {
+			std::cerr << "normalize(\"" << cases[i].sql << "\") gave \"" <<
+					key << "\", expected \"" << cases[i].key << "\"!" <<
+					std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Check that the least recently used statement goes first, and that
+// the counters keep up
+static bool
+test_lru(MYSQL* mysql)
+{
+	mysqlpp::StatementCache cache(2);
+	MYSQL_STMT* a = mysql_stmt_init(mysql);
+	MYSQL_STMT* c = mysql_stmt_init(mysql);
+	cache.insert("a", StmtPtr(a));
+	cache.insert("b", StmtPtr(mysql_stmt_init(mysql)));
+	if (cache.find("a").raw() != a) {
+		std::cerr << "Cache didn't find a statement!" << std::endl;
+		return false;
+	}
+
+	// "b" is now least recently used, so it's the one to go
+	cache.insert("c", StmtPtr(c));
+	if (cache.find("b") || cache.find("a").raw() != a ||
+			cache.find("c").raw() != c) {
+		std::cerr << "Cache evicted the wrong statement!" << std::endl;
+		return false;
+	}
+	else if (cache.size() != 2 || cache.hits() != 3 ||
+			cache.misses() != 1 || cache.evictions() != 1) {
+		std::cerr << "Cache counters are wrong: size " << cache.size() <<
+				", " << cache.hits() << " hits, " << cache.misses() <<
+				" misses, " << cache.evictions() << " evictions!" <<
+				std::endl;
+		return false;
+	}
+
+	cache.erase("a");
+	if (cache.find("a") || cache.size() != 1) {
+		std::cerr << "Erased statement is still cached!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that a statement isn't handed out while someone holds it, and
+// is once they let it go
+static bool
+test_in_use(MYSQL* mysql)
+{
+	mysqlpp::StatementCache cache;
+	MYSQL_STMT* raw = mysql_stmt_init(mysql);
+	cache.insert("a", StmtPtr(raw));
+	{
+		StmtPtr held(cache.find("a"));
+		if (held.raw() != raw) {
+			std::cerr << "Cache didn't find an idle statement!" <<
+					std::endl;
+			return false;
+		}
+		else if (cache.find("a")) {
+			std::cerr << "Cache handed out a statement in use!" <<
+					std::endl;
+			return false;
+		}
+	}
+
+	if (cache.find("a").raw() != raw) {
+		std::cerr << "Released statement didn't go back into the "
+				"cache!" << std::endl;
+		return false;
+	}
+	else if (cache.hits() != 2 || cache.misses() != 1) {
+		std::cerr << "Statement in use wasn't counted as a miss!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that shrinking the cache evicts, and that capacity 0 turns it
+// off
+static bool
+test_capacity(MYSQL* mysql)
+{
+	mysqlpp::StatementCache cache;
+	const char* keys[] = { "a", "b", "c" };
+	for (int i = 0; i < 3; ++i) {
+		cache.insert(keys[i], StmtPtr(mysql_stmt_init(mysql)));
+	}
+
+	cache.capacity(1);
+	if (cache.size() != 1 || !cache.find("c")) {
+		std::cerr << "Shrunken cache didn't keep the newest statement!" <<
+				std::endl;
+		return false;
+	}
+
+	cache.capacity(0);
+	cache.insert("a", StmtPtr(mysql_stmt_init(mysql)));
+	if (cache.size() != 0) {
+		std::cerr << "Disabled cache still holds statements!" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+main()
+{
+	// Statement handles need a MYSQL object, but not a connection
+	MYSQL mysql;
+	mysql_init(&mysql);
+
+	int failures = 0;
+	try {
+		failures += test_normalize() == false;
+		failures += test_lru(&mysql) == false;
+		failures += test_in_use(&mysql) == false;
+		failures += test_capacity(&mysql) == false;
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_statement_cache: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_statement_cache: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	mysql_close(&mysql);
+	return failures;
+}
@@ -0,0 +1,168 @@
+/***********************************************************************
+ test/store_budget.cpp - Tests that store() keeps to the memory budget
+	set with Query::store_budget() or Connection::store_budget().
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+
+
+// Three rows of 1000 bytes each, so any budget much under 3000 bytes
+// is too small for it.  Being a SELECT of literals, this needs a
+// server but not the sample database.
+static const char* big_rows =
+		"SELECT REPEAT('x', 1000) AS data "
+		"UNION ALL SELECT REPEAT('y', 1000) "
+		"UNION ALL SELECT REPEAT('z', 1000)";
+
+
+// Check that a result set within budget is read as usual, in each
+// storage mode that obeys a budget
+static bool
+test_within(mysqlpp::Connection& conn)
+{
+	const mysqlpp::StoreQueryResult::storage_mode modes[] = {
+		mysqlpp::StoreQueryResult::sm_cells,
+		mysqlpp::StoreQueryResult::sm_arena,
+	};
+	for (int i = 0; i < 2; ++i) {
+		mysqlpp::Query query = conn.query(big_rows);
+		query.store_mode(modes[i]);
+		query.store_budget(100000);
+		mysqlpp::StoreQueryResult res = query.store();
+		if (!res || res.num_rows() != 3 || res[2][0].length() != 1000 ||
+				res.bytes_used() < 3000 || res.bytes_used() > 100000) {
+			std::cerr << "Result within budget read wrong in mode " <<
+					i << ": " << res.num_rows() << " rows, " <<
+					res.bytes_used() << " bytes!" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Check that going over budget throws ResultTooLarge if exceptions are
+// enabled, and gives an empty result if not.  Either way, the
+// connection must be ready for another query afterward.
+static bool
+test_over(mysqlpp::Connection& conn)
+{
+	mysqlpp::Query query = conn.query(big_rows);
+	query.store_budget(2000);
+	try {
+		query.store();
+		std::cerr << "Result over budget didn't throw!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::ResultTooLarge& e) {
+		if (e.budget() != 2000) {
+			std::cerr << "ResultTooLarge gave budget " << e.budget() <<
+					", expected 2000!" << std::endl;
+			return false;
+		}
+	}
+
+	mysqlpp::Query quiet = conn.query(big_rows);
+	quiet.store_budget(2000);
+	quiet.disable_exceptions();
+	mysqlpp::StoreQueryResult res = quiet.store();
+	if (res || res.num_rows() != 0) {
+		std::cerr << "Result over budget wasn't empty with exceptions "
+				"disabled!" << std::endl;
+		return false;
+	}
+
+	mysqlpp::Query next = conn.query("SELECT 1");
+	if (next.store().num_rows() != 1) {
+		std::cerr << "Query after result over budget failed!" <<
+				std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+// Check that a Query uses its Connection's budget unless it has its own
+static bool
+test_connection_budget(mysqlpp::Connection& conn)
+{
+	conn.store_budget(2000);
+	bool ok = true;
+	try {
+		conn.query(big_rows).store();
+		std::cerr << "Connection's budget wasn't used!" << std::endl;
+		ok = false;
+	}
+	catch (const mysqlpp::ResultTooLarge&) {
+	}
+
+	mysqlpp::Query query = conn.query(big_rows);
+	query.store_budget(100000);
+	if (ok && query.store().num_rows() != 3) {
+		std::cerr << "Query's budget didn't override the "
+				"Connection's!" << std::endl;
+		ok = false;
+	}
+
+	conn.store_budget(0);
+	return ok;
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		mysqlpp::ResultTooLarge e(1234);
+		if (e.budget() != 1234 || !*e.what()) {
+			std::cerr << "ResultTooLarge lost its budget!" << std::endl;
+			++failures;
+		}
+
+		mysqlpp::Connection conn(false);
+		if (conn.connect()) {
+			conn.enable_exceptions();
+			failures += test_within(conn) == false;
+			failures += test_over(conn) == false;
+			failures += test_connection_budget(conn) == false;
+		}
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_store_budget: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_store_budget: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
@@ -0,0 +1,152 @@
+/***********************************************************************
+ test/store_modes.cpp - Tests that each StoreQueryResult storage mode
+	gives the same rows, and that rows from a view mode result stay
+	valid after the result itself is gone.
+
+ Copyright (c) 2026 by Educational Technology Resources, Inc.
+ Others may also hold copyrights on code in this file.  See the
+ CREDITS.txt file in the top directory of the distribution for details.
+
+ This file is part of MySQL++.
+
+ MySQL++ is free software; you can redistribute it and/or modify it
+ under the terms of the GNU Lesser General Public License as published
+ by the Free Software Foundation; either version 2.1 of the License, or
+ (at your option) any later version.
+
+ MySQL++ is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with MySQL++; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301
+ USA
+***********************************************************************/
+
+#include <mysql++.h>
+
+#include <iostream>
+#include <vector>
+
+
+// Three rows, with a NULL, a value too long for a String's inline
+// buffer, and an empty string.  Being a SELECT of literals, this needs
+// a server but not the sample database.
+static const char* rows =
+		"SELECT 1 AS id, 'apple' AS name "
+		"UNION ALL SELECT 2, NULL "
+		"UNION ALL SELECT 3, REPEAT('x', 100) "
+		"UNION ALL SELECT 4, ''";
+
+
+// Check a result set's rows, going through its std::vector base so any
+// mode that hid rows from it would fail.
+static bool
+check_rows(const std::vector<mysqlpp::Row>& v, const char* what)
+{
+	if (v.size() != 4 || int(v[0][0]) != 1 || v[0]["name"] != "apple" ||
+			!v[1][1].is_null() || v[2][1].length() != 100 ||
+			v[2][1][99] != 'x' || !v[3][1].empty() ||
+			v[3][1].is_null() || int(v.back()["id"]) != 4) {
+		std::cerr << "Wrong rows from " << what << '!' << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+// Check that every storage mode gives the same rows
+static bool
+test_modes(mysqlpp::Connection& conn)
+{
+	const mysqlpp::StoreQueryResult::storage_mode modes[] = {
+		mysqlpp::StoreQueryResult::sm_cells,
+		mysqlpp::StoreQueryResult::sm_arena,
+		mysqlpp::StoreQueryResult::sm_view,
+	};
+	const char* names[] = { "cells mode", "arena mode", "view mode" };
+
+	for (int i = 0; i < 3; ++i) {
+		mysqlpp::Query query = conn.query(rows);
+		query.store_mode(modes[i]);
+		mysqlpp::StoreQueryResult res = query.store();
+		if (!res || !check_rows(res, names[i])) {
+			return false;
+		}
+
+		size_t ids = 0;
+		mysqlpp::StoreQueryResult::const_iterator it;
+		for (it = res.begin(); it != res.end(); ++it) {
+			ids += int((*it)["id"]);
+		}
+		if (ids != 10) {
+			std::cerr << "Iterating over " << names[i] << " result "
+					"gave id total " << ids << '!' << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Check that view mode rows keep the C API's result set alive after
+// they've been copied or swapped out of the StoreQueryResult, and that
+// copies of the result set see the same data.
+static bool
+test_view_lifetime(mysqlpp::Connection& conn)
+{
+	std::vector<mysqlpp::Row> kept;
+	mysqlpp::Row copied;
+	mysqlpp::StoreQueryResult dup;
+	{
+		mysqlpp::Query query = conn.query(rows);
+		query.store_mode(mysqlpp::StoreQueryResult::sm_view);
+		mysqlpp::StoreQueryResult res = query.store();
+		dup = res;
+		copied = res[2];
+		res.swap(kept);
+		if (!res.empty()) {
+			std::cerr << "Swapping rows out of a result left some "
+					"behind!" << std::endl;
+			return false;
+		}
+	}
+
+	// Run another query, so the C API reuses any memory the first
+	// result set wrongly gave back.
+	mysqlpp::Query other = conn.query(rows);
+	other.store();
+
+	return check_rows(kept, "swapped-out view mode rows") &&
+			check_rows(dup, "copied view mode result") &&
+			copied["name"].length() == 100 && copied["name"][0] == 'x';
+}
+
+
+int
+main()
+{
+	int failures = 0;
+	try {
+		mysqlpp::Connection conn(false);
+		if (conn.connect()) {
+			failures += test_modes(conn) == false;
+			failures += test_view_lifetime(conn) == false;
+		}
+	}
+	catch (mysqlpp::Exception& e) {
+		std::cerr << "Unexpected MySQL++ exception caught in "
+				"test_store_modes: " << e.what() << std::endl;
+		failures = 1;
+	}
+	catch (std::exception& e) {
+		std::cerr << "Unexpected C++ exception caught in "
+				"test_store_modes: " << e.what() << std::endl;
+		failures = 1;
+	}
+
+	return failures;
+}
@@ -27,6 +27,9 @@
 #include <mysql++.h>
 
 #include <iostream>
+#include <limits>
+
+#include <string.h>
 
 
 // Does an equality comparison on the value, forcing the string to
@@ -132,6 +135,113 @@ test_int_conversion(const mysqlpp::String& s, bool throw_expected)
 }
 
 
+// Returns true if converting the string to T throws BadConversion
+template <typename T>
+static bool
+test_conv_throws(const char* str, T value)
+{
+	try {
+		T converted = mysqlpp::String(str).conv(value);
+		std::cerr << "Conversion of \"" << str << "\" to " <<
+				typeid(T).name() << " gave " << converted <<
+				" instead of throwing!" << std::endl;
+		return false;
+	}
+	catch (const mysqlpp::BadConversion&) {
+		return true;
+	}
+}
+
+
+// Checks the edge cases of the numeric conversion code: whitespace,
+// long digit strings, range limits, and odd floating-point forms.
+static bool
+test_numeric_edges()
+{
+	// Whitespace around the number is fine, as is a sign
+	if (!test_equality(mysqlpp::String("  42\t"), 42)) return false;
+	if (!test_equality(mysqlpp::String("+42"), 42)) return false;
+	if (!test_equality(mysqlpp::String("-42"), -42)) return false;
+	if (!test_equality(mysqlpp::String("   "), 0)) return false;
+	if (!test_equality(mysqlpp::String("-42.000 "), -42)) return false;
+	if (!test_equality(mysqlpp::String("0000000000000000000000042"),
+			42)) return false;
+	if (!test_equality(mysqlpp::String("-"), 0)) return false;
+	if (!test_equality(mysqlpp::String(" +"), 0)) return false;
+	if (!test_conv_throws("42 43", 0)) return false;
+	if (!test_conv_throws("- ", 0)) return false;
+	if (!test_conv_throws("4x", 0)) return false;
+	if (!test_conv_throws("12.000001", 0)) return false;
+
+	// Long digit strings, right up to the limits of the types
+	if (!test_equality(mysqlpp::String("1234567890123456789"),
+			mysqlpp::longlong(1234567890123456789LL))) return false;
+	if (!test_equality(mysqlpp::String("9223372036854775807"),
+			std::numeric_limits<mysqlpp::longlong>::max())) return false;
+	if (!test_equality(mysqlpp::String("-9223372036854775808"),
+			std::numeric_limits<mysqlpp::longlong>::min())) return false;
+	if (!test_equality(mysqlpp::String("18446744073709551615"),
+			std::numeric_limits<mysqlpp::ulonglong>::max())) return false;
+	if (!test_equality(mysqlpp::String("-1"),
+			std::numeric_limits<mysqlpp::ulonglong>::max())) return false;
+
+	// Values out of range are clamped, as iostreams did, but only if
+	// the number ends the text.
+	if (!test_equality(mysqlpp::String("9223372036854775808"),
+			std::numeric_limits<mysqlpp::longlong>::max())) return false;
+	if (!test_equality(mysqlpp::String("-9223372036854775809"),
+			std::numeric_limits<mysqlpp::longlong>::min())) return false;
+	if (!test_equality(mysqlpp::String("18446744073709551616"),
+			std::numeric_limits<mysqlpp::ulonglong>::max())) return false;
+	if (!test_equality(mysqlpp::String("-123456789012345678901234567890"),
+			std::numeric_limits<mysqlpp::ulonglong>::max())) return false;
+	if (!test_equality(mysqlpp::String("1e999"),
+			std::numeric_limits<double>::max())) return false;
+	if (!test_conv_throws("9223372036854775808 ",
+			mysqlpp::longlong(0))) return false;
+	if (!test_conv_throws("123456789012345678901234567890.0",
+			mysqlpp::ulonglong(0))) return false;
+	if (!test_equality(mysqlpp::String("4294967295"), 4294967295U))
+			return false;
+
+	// Floating-point forms, both on and off the fast path
+	if (!test_equality(mysqlpp::String("1.5e3"), 1500.0)) return false;
+	if (!test_equality(mysqlpp::String(".25"), 0.25)) return false;
+	if (!test_equality(mysqlpp::String("-2.5E-1"), -0.25)) return false;
+	if (!test_equality(mysqlpp::String("0.1"), 0.1)) return false;
+	if (!test_equality(mysqlpp::String("3.14159265358979323846264"),
+			3.14159265358979323846264)) return false;
+	if (!test_equality(mysqlpp::String("1e300"), 1e300)) return false;
+	if (!test_equality(mysqlpp::String(" 2.5 "), 2.5f)) return false;
+	if (!test_conv_throws("1.5.", 0.0)) return false;
+	if (!test_conv_throws("1.5e3x", 0.0)) return false;
+
+	return true;
+}
+
+
+// Checks that values on either side of SQLBuffer's inline storage
+// limit come through intact, including embedded nulls and the
+// trailing null terminator.
+static bool
+test_buffer_lengths()
+{
+	const char src[] = "0123456789abcdefghij\0klmnopqrstuvwxyz";
+	const size_t lens[] = { 0, 1, 21, 22, 23, 24, sizeof(src) - 1 };
+	for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) {
+		mysqlpp::String s(src, lens[i]);
+		if (s.length() != lens[i] || memcmp(s.data(), src, lens[i]) != 0 ||
+				s.data()[lens[i]] != '\0') {
+			std::cerr << "String of length " << lens[i] <<
+					" not stored correctly!" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
 // Checks that String's null comparison methods work right
 static bool
 test_null()
@@ -284,6 +394,8 @@ main(int, char* argv[])
 		failures += test_int_conversion(intable1, false) == false;
 		failures += test_int_conversion(intable2, false) == false;
 		failures += test_int_conversion(nonint, true) == false;
+		failures += test_numeric_edges() == false;
+		failures += test_buffer_lengths() == false;
 		failures += test_null() == false;
 		failures += test_string_equality(definit, empty) == false;
 		failures += test_string_equality(empty, definit) == false;